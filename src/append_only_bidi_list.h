@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the append-only bidirectional list
+/// template, a log read without locks while one writer appends to it.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_APPENDONLYLIST_H_
+#define XI_ENHLINKEDLIST_APPENDONLYLIST_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>      // size_t
+#include <mutex>
+#include <thread>
+
+#include "bidi_linked_list.h"
+
+
+/** \brief Policy of an AppendOnlyBidiList: atomic links and no node cache, as
+ *  nodes are never popped
+ */
+struct AppendOnlyBidiListPolicy : DefaultBidiListPolicy
+{
+    static const bool RCU_READERS = true;
+    static const std::size_t NODE_CACHE_SIZE = 0;
+};
+
+
+/** \brief Declares a BidiLinkedList that only grows at its end, such as an event
+ *  log, read by any number of threads while one writer appends to it
+ *
+ *  The writer links a new node and then publishes it as the tail with release
+ *  stores, so neither side takes a lock: an append does not wait for anything
+ *  unless a reader is blocked in Cursor::wait(), and readers iterate with acquire
+ *  loads. Since nodes are freed by the destructor only, readers need no guards,
+ *  and a node pointer stays valid as long as the list.
+ *
+ *  A reader follows new entries by a Cursor, which remembers the last entry it
+ *  has consumed. It may poll for the next one, or wait until it is appended: a
+ *  waiting reader yields a few times first, then registers itself and blocks, and
+ *  only then the writer takes a mutex to notify it, so appends stay cheap while
+ *  nobody is blocked. close() wakes up every blocked reader for good.
+ *
+ *  Values must not be changed once appended. **Requirements to a `T`** are the
+ *  same as for BidiLinkedList.
+ */
+template<typename T, typename Policy = AppendOnlyBidiListPolicy>
+class AppendOnlyBidiList : protected BidiLinkedList<T, Policy>
+{
+    static_assert(Policy::RCU_READERS, "an append-only list needs atomic links");
+
+    typedef BidiLinkedList<T, Policy> Base;
+
+public:
+    //-----<Types>-----
+    typedef typename Base::Node Node;
+    typedef typename Base::iterator iterator;
+    typedef typename Base::const_iterator const_iterator;
+    typedef typename Base::reverse_iterator reverse_iterator;
+    typedef typename Base::const_reverse_iterator const_reverse_iterator;
+
+    /** \brief Position of a reader in a log: the entry consumed last */
+    class Cursor
+    {
+    public:
+        /** \brief Creates a cursor before the first entry of \a log */
+        explicit Cursor(AppendOnlyBidiList &log) : _log(&log), _node(nullptr) {}
+
+        /** \brief Creates a cursor after \a node, an entry of \a log, or before the
+         *  first entry if \a node is nullptr
+         */
+        Cursor(AppendOnlyBidiList &log, Node *node) : _log(&log), _node(node) {}
+
+        /** \brief Returns an entry after the cursor without consuming it, or nullptr */
+        Node *peek() const { return _log->entryAfter(_node); }
+
+        /** \brief Consumes and returns an entry after the cursor, or returns nullptr
+         *  if there is none yet
+         */
+        Node *poll();
+
+        /** \brief Consumes and returns an entry after the cursor, waiting for it to
+         *  be appended; returns nullptr if the log is closed and has no more entries
+         */
+        Node *wait();
+
+        /** \brief Same as wait(), but gives up after \a timeout, returning nullptr */
+        template<typename Rep, typename Period>
+        Node *waitFor(const std::chrono::duration<Rep, Period> &timeout)
+        {
+            return waitUntil(std::chrono::steady_clock::now() + timeout);
+        }
+
+        /** \brief Same as wait(), but gives up at \a deadline, returning nullptr */
+        Node *waitUntil(std::chrono::steady_clock::time_point deadline);
+
+        /** \brief Returns the entry consumed last, or nullptr if none */
+        Node *getNode() const { return _node; }
+
+    protected:
+        AppendOnlyBidiList *_log;
+        Node *_node;                    ///< Entry consumed last
+    }; // class Cursor
+
+public:
+    /** \brief Default constructor */
+    AppendOnlyBidiList() : _count(0), _waiters(0), _closed(false) {}
+
+    /** \brief Destructor; must not run concurrently with other methods */
+    ~AppendOnlyBidiList() {}
+
+    AppendOnlyBidiList(const AppendOnlyBidiList &) = delete;
+    AppendOnlyBidiList &operator=(const AppendOnlyBidiList &) = delete;
+
+public:
+    //-----<Writer>-----
+    // called by one thread at a time
+
+    /** \brief Appends a given element and returns a new node */
+    Node *appendEl(const T &val);
+
+    /** \brief Appends a given element, like appendEl() does */
+    void pushBack(const T &val) { appendEl(val); }
+
+    /** \brief Appends copies of values of a range `[first, last)`, which readers
+     *  see appear at once; returns the first new node, or nullptr for an empty range
+     */
+    template<typename InputIt>
+    Node *appendRange(InputIt first, InputIt last);
+
+    /** \brief Tells readers no more entries come: wakes up blocked ones, and makes
+     *  later waits return nullptr at the end of the log
+     */
+    void close();
+
+public:
+    //-----<Readers>-----
+    // called from any number of threads, concurrently with the writer
+
+    using Base::begin;
+    using Base::end;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::crbegin;
+    using Base::crend;
+
+    using Base::getHeadNode;
+    using Base::getLastNode;
+    using Base::getNextNode;
+    using Base::getPrevNode;
+
+    /** \brief Returns a number of entries published so far */
+    std::size_t getSize() const { return _count.load(std::memory_order_acquire); }
+
+    /** \brief Returns whether close() has been called */
+    bool isClosed() const { return _closed.load(); }
+
+    /** \brief Finds first node carrying \a val, or returns nullptr */
+    Node *findFirst(const T &val) const;
+
+    /** \brief Returns a number of nodes carrying a given value \a val */
+    std::size_t count(const T &val) const;
+
+protected:
+    //-----<Consts>------
+    /** \brief Number of times a waiting reader yields before it blocks */
+    static const std::size_t WAIT_SPINS = 16;
+
+protected:
+    /** \brief Returns an entry after \a node, or the first one if \a node is nullptr */
+    Node *entryAfter(Node *node) const { return node ? node->getNext() : getHeadNode(); }
+
+    /** \brief Waits for an entry after \a node until \a deadline, or for ever if
+     *  \a deadline is nullptr; returns nullptr on a timeout or if the log is closed
+     */
+    Node *awaitAfter(Node *node, const std::chrono::steady_clock::time_point *deadline);
+
+    /** \brief Counts \a count published entries and wakes up blocked readers, if any */
+    void published(std::size_t count);
+
+protected:
+    std::atomic<std::size_t> _count;    ///< Number of published entries
+    std::atomic<std::size_t> _waiters;  ///< Number of readers about to block
+    std::atomic<bool> _closed;          ///< Whether close() has been called
+
+    std::mutex _waitLock;               ///< Taken to block and to wake up readers
+    std::condition_variable _appended;  ///< Signals entries and closing
+}; // class AppendOnlyBidiList
+
+
+// declaration of template class template methods
+#include "append_only_bidi_list.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_APPENDONLYLIST_H_
@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the append-only bidirectional
+/// list template declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+//==============================================================================
+// class AppendOnlyBidiList<T, Policy>::Cursor
+//==============================================================================
+
+
+template<typename T, typename Policy>
+typename AppendOnlyBidiList<T, Policy>::Node *
+AppendOnlyBidiList<T, Policy>::Cursor::poll()
+{
+    Node *next = peek();
+    if (next != nullptr)
+        _node = next;
+
+    return next;
+}
+
+
+template<typename T, typename Policy>
+typename AppendOnlyBidiList<T, Policy>::Node *
+AppendOnlyBidiList<T, Policy>::Cursor::wait()
+{
+    Node *next = _log->awaitAfter(_node, nullptr);
+    if (next != nullptr)
+        _node = next;
+
+    return next;
+}
+
+
+template<typename T, typename Policy>
+typename AppendOnlyBidiList<T, Policy>::Node *
+AppendOnlyBidiList<T, Policy>::Cursor::waitUntil(std::chrono::steady_clock::time_point deadline)
+{
+    Node *next = _log->awaitAfter(_node, &deadline);
+    if (next != nullptr)
+        _node = next;
+
+    return next;
+}
+
+
+
+//==============================================================================
+// class AppendOnlyBidiList<T, Policy>
+//==============================================================================
+
+
+template<typename T, typename Policy>
+void AppendOnlyBidiList<T, Policy>::published(std::size_t count)
+{
+    _count.store(_count.load(std::memory_order_relaxed) + count, std::memory_order_release);
+
+    // pairs with the fence in awaitAfter(): either the reader sees the entry
+    // before blocking, or the writer sees the reader registered
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waiters.load(std::memory_order_relaxed) == 0)
+        return;
+
+    // a reader that has not seen the entry holds the lock until it blocks
+    {
+        std::lock_guard<std::mutex> guard(_waitLock);
+    }
+    _appended.notify_all();
+}
+
+
+template<typename T, typename Policy>
+typename AppendOnlyBidiList<T, Policy>::Node *
+AppendOnlyBidiList<T, Policy>::appendEl(const T &val)
+{
+    Node *node = Base::appendEl(val);
+    published(1);
+    return node;
+}
+
+
+template<typename T, typename Policy>
+template<typename InputIt>
+typename AppendOnlyBidiList<T, Policy>::Node *
+AppendOnlyBidiList<T, Policy>::appendRange(InputIt first, InputIt last)
+{
+    // the chain is built aside and linked by one release store of the old tail
+    std::size_t count;
+    Node *end;
+    Node *beg = this->buildChain(first, last, end, count);
+    if (beg == nullptr)
+        return nullptr;
+
+    this->linkChainAfter(nullptr, beg, end);
+    this->growSize(count);
+    published(count);
+    return beg;
+}
+
+
+template<typename T, typename Policy>
+void AppendOnlyBidiList<T, Policy>::close()
+{
+    {
+        std::lock_guard<std::mutex> guard(_waitLock);
+        _closed.store(true);
+    }
+    _appended.notify_all();
+}
+
+
+template<typename T, typename Policy>
+typename AppendOnlyBidiList<T, Policy>::Node *
+AppendOnlyBidiList<T, Policy>::awaitAfter(Node *node, const std::chrono::steady_clock::time_point *deadline)
+{
+    // an entry is often about to come, so the thread steps aside a few times
+    // before it blocks and makes the writer notify it
+    for (std::size_t i = 0; ; ++i)
+    {
+        Node *next = entryAfter(node);
+        if (next != nullptr || _closed.load())
+            return next;
+        if (i == WAIT_SPINS)
+            break;
+        std::this_thread::yield();
+    }
+
+    Node *next;
+    _waiters.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    {
+        std::unique_lock<std::mutex> lock(_waitLock);
+        for (;;)
+        {
+            next = entryAfter(node);
+            if (next != nullptr || _closed.load())
+                break;
+
+            if (deadline == nullptr)
+                _appended.wait(lock);
+            else if (_appended.wait_until(lock, *deadline) == std::cv_status::timeout)
+            {
+                next = entryAfter(node);
+                break;
+            }
+        }
+    }
+    _waiters.fetch_sub(1);
+
+    return next;
+}
+
+
+template<typename T, typename Policy>
+typename AppendOnlyBidiList<T, Policy>::Node *
+AppendOnlyBidiList<T, Policy>::findFirst(const T &val) const
+{
+    std::size_t tag = Node::tagOf(val);
+    return this->traverse(getHeadNode(), [&val, tag](Node *node) { return Base::carries(node, val, tag); });
+}
+
+
+template<typename T, typename Policy>
+std::size_t AppendOnlyBidiList<T, Policy>::count(const T &val) const
+{
+    std::size_t res = 0;
+    std::size_t tag = Node::tagOf(val);
+    this->traverse(getHeadNode(), [&val, tag, &res](Node *node)
+    {
+        if (Base::carries(node, val, tag))
+            ++res;
+        return false;
+    });
+
+    return res;
+}
@@ -0,0 +1,483 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the augmented bidirectional list
+/// template that maintains monoid summaries for range aggregate queries.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_AUGMENTEDLIST_H_
+#define XI_ENHLINKEDLIST_AUGMENTEDLIST_H_
+
+#include <cstddef>      // size_t
+#include <cstdint>
+#include <functional>   // hash
+#include <limits>
+#include <type_traits>
+#include <utility>      // declval
+#include <vector>
+
+
+//==============================================================================
+// Predefined monoids
+//==============================================================================
+
+/** \brief Sum of elements. `T` should support `operator+` and `T()` as zero.
+ *
+ *  Any user-supplied monoid must provide the same members: a `Summary` type,
+ *  `identity()`, `lift()` converting a single value into a summary and an
+ *  associative `combine()`.
+ */
+template<typename T>
+struct SumMonoid
+{
+    typedef T Summary;
+
+    static Summary identity() { return T(); }
+    static Summary lift(const T &val) { return val; }
+    static Summary combine(const Summary &a, const Summary &b) { return a + b; }
+};
+
+/** \brief Minimum of elements. `T` should have `std::numeric_limits` defined */
+template<typename T>
+struct MinMonoid
+{
+    typedef T Summary;
+
+    static Summary identity() { return std::numeric_limits<T>::max(); }
+    static Summary lift(const T &val) { return val; }
+    static Summary combine(const Summary &a, const Summary &b) { return b < a ? b : a; }
+};
+
+/** \brief Maximum of elements. `T` should have `std::numeric_limits` defined */
+template<typename T>
+struct MaxMonoid
+{
+    typedef T Summary;
+
+    static Summary identity() { return std::numeric_limits<T>::lowest(); }
+    static Summary lift(const T &val) { return val; }
+    static Summary combine(const Summary &a, const Summary &b) { return a < b ? b : a; }
+};
+
+/** \brief Number of elements */
+template<typename T>
+struct CountMonoid
+{
+    typedef std::size_t Summary;
+
+    static Summary identity() { return 0; }
+    static Summary lift(const T &) { return 1; }
+    static Summary combine(const Summary &a, const Summary &b) { return a + b; }
+};
+
+
+//==============================================================================
+// Filter monoids
+//==============================================================================
+
+/** \brief Min/max zone map of elements, for types ordered by `operator<`
+ *
+ *  Besides the members of SumMonoid, a *filter* monoid provides `mayContain()`,
+ *  which returns false only if no element under a summary is equal to a value.
+ *  AugmentedBidiList searches use it to skip whole chunks. A zone map pays off
+ *  when the list is (roughly) ordered.
+ */
+template<typename T>
+struct ZoneMapMonoid
+{
+    struct Summary
+    {
+        T min;
+        T max;
+    };
+
+    static Summary identity()
+    {
+        Summary res = { std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest() };
+        return res;
+    }
+
+    static Summary lift(const T &val)
+    {
+        Summary res = { val, val };
+        return res;
+    }
+
+    static Summary combine(const Summary &a, const Summary &b)
+    {
+        Summary res = { b.min < a.min ? b.min : a.min, a.max < b.max ? b.max : a.max };
+        return res;
+    }
+
+    static bool mayContain(const Summary &s, const T &val) { return !(val < s.min) && !(s.max < val); }
+};
+
+
+/** \brief Bloom filter of elements with \a Bits bits and two probes per element
+ *
+ *  A filter monoid (see ZoneMapMonoid) for any hashable type. Summaries of a chunk
+ *  are unions of filters below, so filters of big chunks saturate and stop
+ *  skipping: \a Bits should be several times the number of elements of the chunks
+ *  expected to be skipped, e.g. the default 512 gives about 2% false positives
+ *  for a leaf chunk of 32 elements.
+ */
+template<typename T, std::size_t Bits = 512, typename Hash = std::hash<T> >
+struct BloomMonoid
+{
+    static_assert(Bits % 64 == 0, "a filter consists of 64-bit words");
+
+    struct Summary
+    {
+        uint64_t words[Bits / 64];
+    };
+
+    static Summary identity()
+    {
+        Summary res;
+        for (std::size_t i = 0; i < Bits / 64; ++i)
+            res.words[i] = 0;
+        return res;
+    }
+
+    static Summary lift(const T &val)
+    {
+        Summary res = identity();
+        std::size_t a, b;
+        probes(val, a, b);
+        res.words[a / 64] |= (uint64_t) 1 << (a % 64);
+        res.words[b / 64] |= (uint64_t) 1 << (b % 64);
+        return res;
+    }
+
+    static Summary combine(const Summary &a, const Summary &b)
+    {
+        Summary res;
+        for (std::size_t i = 0; i < Bits / 64; ++i)
+            res.words[i] = a.words[i] | b.words[i];
+        return res;
+    }
+
+    static bool mayContain(const Summary &s, const T &val)
+    {
+        std::size_t a, b;
+        probes(val, a, b);
+        return (s.words[a / 64] >> (a % 64) & 1) && (s.words[b / 64] >> (b % 64) & 1);
+    }
+
+    /** \brief Computes positions of the bits of \a val */
+    static void probes(const T &val, std::size_t &a, std::size_t &b)
+    {
+        // std::hash of integers is the identity, so the hash is mixed first
+        uint64_t h = (uint64_t) Hash()(val) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29;
+        a = (std::size_t) (h % Bits);
+        b = (std::size_t) ((h >> 32) % Bits);
+    }
+};
+
+
+/** \brief Tells whether \a Monoid is a filter monoid, that is has `mayContain()` */
+template<typename Monoid, typename T>
+class IsFilterMonoid
+{
+    template<typename M>
+    static char test(decltype(M::mayContain(std::declval<const typename M::Summary &>(),
+                                            std::declval<const T &>())) *);
+
+    template<typename M>
+    static long test(...);
+
+public:
+    static const bool value = sizeof(test<Monoid>(nullptr)) == 1;
+};
+
+template<typename Monoid, typename T>
+const bool IsFilterMonoid<Monoid, T>::value;
+
+
+/** \brief Declares a bidirectional list that keeps monoid summaries over its nodes
+ *
+ *  Nodes are grouped into chunks of at most `MAX_FANOUT` consecutive nodes, chunks
+ *  are grouped the same way into upper level chunks and so on, which gives
+ *  a B-tree like hierarchy with all the leaf chunks on the same depth.
+ *  Every chunk caches a summary of all the nodes below it, so an aggregate over
+ *  any subrange `[beg, end]` is assembled from O(log n) chunk summaries.
+ *
+ *  Summaries are kept in sync by Node::setValue() and by insertions, each of
+ *  which costs O(MAX_FANOUT * log n). Cuts only mark chunks above the cut nodes as
+ *  stale in O(log n), and stale summaries are rebuilt by the next query or update
+ *  that reads them. Chunks are not merged on underflow, so the depth stays
+ *  bounded by the largest size the list has ever reached.
+ *
+ *  With a filter monoid (see ZoneMapMonoid and BloomMonoid) findFirst(), findAll()
+ *  and cutAll() skip chunks that cannot contain a searched value; getSearchStats()
+ *  tells how much they skip.
+ *
+ *  **Requirements to a `Monoid`**: see SumMonoid.
+ */
+template<typename T, typename Monoid>
+class AugmentedBidiList
+{
+public:
+    //-----<Consts>------
+    /** \brief Maximum number of children of a chunk; an overfull chunk is split in halves */
+    static const std::size_t MAX_FANOUT = 32;
+
+public:
+    //-----<Types>-----
+    typedef typename Monoid::Summary Summary;
+
+    class Group;
+
+    /** \brief Counters of searches, see getSearchStats() */
+    struct SearchStats
+    {
+        std::size_t searches;       ///< Number of findFirst() calls, direct or by findAll()
+        std::size_t nodesVisited;   ///< Nodes compared with a searched value
+        std::size_t chunksSkipped;  ///< Chunks ruled out by their summaries
+    };
+
+    /** \brief Node of an augmented list
+     *
+     *  Unlike BidiLinkedList::Node, a value can be changed through setValue() only,
+     *  since every change has to be propagated to the summaries.
+     */
+    class Node
+    {
+        friend class AugmentedBidiList;
+
+    public:
+        /** \brief Default constructor */
+        Node() : _next(nullptr), _prev(nullptr), _group(nullptr) {}
+
+        /** \brief Inititalization wit a node element */
+        Node(const T &el) : _val(el), _next(nullptr), _prev(nullptr), _group(nullptr) {}
+
+    public:
+        /** \brief Returns a pointer to a previous element */
+        Node *getPrev() const { return _prev; }
+
+        /** \brief Returns a pointer to a next element */
+        Node *getNext() const { return _next; }
+
+        /** \brief Returns node's value */
+        const T &getValue() const { return _val; }
+
+        /** \brief Sets a new value carried by the node and updates summaries of
+         *  all the chunks containing the node
+         */
+        void setValue(const T &newVal);
+
+    protected:
+        T _val;                 ///< Storage a value
+        Node *_next;            ///< Next element. nullptr, if no one presented
+        Node *_prev;            ///< Previous element. nullptr, if no one presented
+        Group *_group;          ///< Leaf chunk the node belongs to; nullptr for a free node
+    }; // class Node
+
+
+    /** \brief Chunk of the summary hierarchy
+     *
+     *  A leaf chunk stores its nodes, an inner one stores its subchunks, in list order.
+     */
+    class Group
+    {
+        friend class AugmentedBidiList;
+
+    protected:
+        Group(bool leaf) : _parent(nullptr), _leaf(leaf), _summary(Monoid::identity()), _stale(false) {}
+
+        /** \brief Returns a number of children (nodes or subchunks) */
+        std::size_t childCount() const { return _leaf ? _nodes.size() : _children.size(); }
+
+    protected:
+        Group *_parent;                 ///< Upper level chunk; nullptr for the root
+        bool _leaf;                     ///< Whether the chunk stores nodes or subchunks
+        std::vector<Node *> _nodes;     ///< Nodes of a leaf chunk
+        std::vector<Group *> _children; ///< Subchunks of an inner chunk
+        mutable Summary _summary;       ///< Summary of all the nodes below, unless stale
+        mutable bool _stale;            ///< Whether _summary is to be rebuilt
+    }; // class Group
+
+public:
+    /** \brief Default constructor */
+    AugmentedBidiList() : _head(nullptr), _tail(nullptr), _root(nullptr), _size(0), _stats() {}
+
+    /** \brief Destructor */
+    ~AugmentedBidiList();
+
+    AugmentedBidiList(const AugmentedBidiList &) = delete;
+    AugmentedBidiList &operator=(const AugmentedBidiList &) = delete;
+
+public:
+    /** \brief Clears the list (deletes all elements and frees memory) */
+    void clear();
+
+    /** \brief Appends a given element (to the end) and returns a pointer to a new Node */
+    Node *appendEl(const T &val) { return insertNodeAfter(nullptr, new Node(val)); }
+
+    /** \brief Inserts a given new (free) node \a insNode after node \a node
+     *
+     *  If \a node is nullptr, inserts \a insNode at the very end.
+     *  If \a insNode is nullptr or is not free, an exception is thrown.
+     */
+    Node *insertNodeAfter(Node *node, Node *insNode);
+
+    /** \brief Inserts a given new (free) node \a insNode before node \a node
+     *
+     *  If \a node is nullptr, inserts \a insNode in the very begin.
+     *  If \a insNode is nullptr or is not free, an exception is thrown.
+     */
+    Node *insertNodeBefore(Node *node, Node *insNode);
+
+    /** \brief Cuts a chain of nodes determined by its begin and end node from the list
+     *
+     *  Costs O(k (MAX_FANOUT + log n)) for a chain of k nodes; summaries are rebuilt lazily.
+     *  If either \a beg or \a end is nullptr, an expection is thrown.
+     */
+    void cutNodes(Node *beg, Node *end);
+
+    /** \brief Cuts a given node from the list and returns it */
+    Node *cutNode(Node *node)
+    {
+        cutNodes(node, node);
+        return node;
+    }
+
+public:
+    /** \brief Finds first node carrying a given value \a val, starting from a given
+     *  node \a startFrom; returns nullptr if nothing is found
+     *
+     *  With a filter monoid, chunks whose summaries rule \a val out are skipped.
+     */
+    Node *findFirst(Node *startFrom, const T &val)
+    {
+        return findFirstIn(startFrom, val,
+                           std::integral_constant<bool, IsFilterMonoid<Monoid, T>::value>());
+    }
+
+    /** \brief Overloaded version of findFirst(): searching in the entire list */
+    Node *findFirst(const T &val) { return findFirst(_head, val); }
+
+    /** \brief Finds all the nodes carrying \a val from \a startFrom on
+     *
+     *  Returns a newly created array that should be freed by caller, or nullptr if
+     *  nothing is found, like BidiLinkedList::findAll() does.
+     */
+    Node **findAll(Node *startFrom, const T &val, int &size);
+
+    /** \brief Overloaded version of findAll(): searching in the entire list */
+    Node **findAll(const T &val, int &size) { return findAll(_head, val, size); }
+
+    /** \brief Cuts all the nodes carrying \a val and returns an array of them, see findAll() */
+    Node **cutAll(Node *startFrom, const T &val, int &size);
+
+    /** \brief Overloaded version of cutAll(): searching in the entire list */
+    Node **cutAll(const T &val, int &size) { return cutAll(_head, val, size); }
+
+    /** \brief Returns counters of searches since construction or resetSearchStats()
+     *
+     *  For negative searches over the entire list, a skip rate is
+     *  `1 - nodesVisited / (searches * getSize())`.
+     */
+    const SearchStats &getSearchStats() const { return _stats; }
+
+    /** \brief Zeroes counters returned by getSearchStats() */
+    void resetSearchStats() { _stats = SearchStats(); }
+
+    /** \brief Returns a summary of the chain `[beg, end]` in O(MAX_FANOUT * log n)
+     *
+     *  \a end must not precede \a beg in the list, otherwise unpredictable behavior
+     *  is expected. If either \a beg or \a end is nullptr, an expection is thrown.
+     */
+    Summary aggregate(const Node *beg, const Node *end) const;
+
+    /** \brief Returns a summary of the entire list in O(1), unless summaries are stale */
+    Summary aggregate() const { return _root ? summaryOf(_root) : Monoid::identity(); }
+
+public:
+    /** \brief Returns a lists's head */
+    Node *getHeadNode() const { return _head; }
+
+    /** \brief Returns a pointer to a last node */
+    Node *getLastNode() const { return _tail; }
+
+    /** \brief Returns a size of a list */
+    std::size_t getSize() const { return _size; }
+
+protected:
+    /** \brief Places a free node \a insNode to a leaf chunk \a leaf at position \a pos */
+    void attach(Group *leaf, std::size_t pos, Node *insNode);
+
+    /** \brief Removes a node from its leaf chunk, dropping chunks that become empty */
+    void detach(Node *node);
+
+    /** \brief Splits chunk \a g if it is overfull, proceeding upwards */
+    void splitIfNeeded(Group *g);
+
+    /** \brief Recalculates summaries of \a g and all its ancestors */
+    static void refreshUp(Group *g);
+
+    /** \brief Marks summaries of \a g and all its ancestors stale */
+    static void markStale(Group *g);
+
+    /** \brief Recalculates a summary of a single chunk from its children */
+    static void recalc(const Group *g);
+
+    /** \brief Returns a summary of \a g, rebuilding it if stale */
+    static const Summary &summaryOf(const Group *g)
+    {
+        if (g->_stale)
+            recalc(g);
+        return g->_summary;
+    }
+
+    /** \brief Linear search, for monoids that are not filters */
+    Node *findFirstIn(Node *startFrom, const T &val, std::false_type);
+
+    /** \brief Search skipping chunks, for filter monoids */
+    Node *findFirstIn(Node *startFrom, const T &val, std::true_type);
+
+    /** \brief Returns a first leaf under \a g that may contain \a val, or nullptr;
+     *  the summary of \a g itself is supposed to be checked
+     */
+    Group *firstCandidateLeaf(Group *g, const T &val);
+
+    /** \brief Returns a first leaf after leaf \a g that may contain \a val, or nullptr */
+    Group *nextCandidateLeaf(Group *g, const T &val);
+
+    /** \brief Folds summaries of nodes `[from, to)` of a leaf chunk */
+    static Summary foldNodes(const Group *g, std::size_t from, std::size_t to);
+
+    /** \brief Folds summaries of subchunks `[from, to)` of an inner chunk */
+    static Summary foldGroups(const Group *g, std::size_t from, std::size_t to);
+
+    /** \brief Returns a position of \a item in \a items */
+    template<typename Item>
+    static std::size_t indexOf(const std::vector<Item *> &items, const Item *item);
+
+    /** \brief Deletes the chunk \a g with all its subchunks (but not nodes) */
+    static void deleteGroups(Group *g);
+
+protected:
+    Node *_head;            ///< Pointer to a first element of a list
+    Node *_tail;            ///< Pointer to the last element of the list
+    Group *_root;           ///< Root of the summary hierarchy; nullptr for an empty list
+    std::size_t _size;      ///< Number of elements
+    SearchStats _stats;     ///< Counters of searches
+}; // class AugmentedBidiList
+
+
+// declaration of template class template methods
+#include "augmented_bidi_list.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_AUGMENTEDLIST_H_
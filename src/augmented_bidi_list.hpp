@@ -0,0 +1,491 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the augmented bidirectional
+/// list template declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+
+
+//==============================================================================
+// class AugmentedBidiList<T, Monoid>::Node
+//==============================================================================
+
+
+template<typename T, typename Monoid>
+void AugmentedBidiList<T, Monoid>::Node::setValue(const T &newVal)
+{
+    _val = newVal;
+    if (_group)
+        refreshUp(_group);
+}
+
+
+//==============================================================================
+// class AugmentedBidiList<T, Monoid>
+//==============================================================================
+
+
+template<typename T, typename Monoid>
+AugmentedBidiList<T, Monoid>::~AugmentedBidiList()
+{
+    clear();
+}
+
+
+template<typename T, typename Monoid>
+void AugmentedBidiList<T, Monoid>::clear()
+{
+    Node *node = _head;
+    while (node != nullptr)
+    {
+        Node *next = node->_next;
+        delete node;
+        node = next;
+    }
+
+    if (_root)
+        deleteGroups(_root);
+
+    _head = nullptr;
+    _tail = nullptr;
+    _root = nullptr;
+    _size = 0;
+}
+
+
+template<typename T, typename Monoid>
+typename AugmentedBidiList<T, Monoid>::Node *
+AugmentedBidiList<T, Monoid>::insertNodeAfter(Node *node, Node *insNode)
+{
+    if (insNode == nullptr || insNode->_next != nullptr || insNode->_prev != nullptr
+            || insNode->_group != nullptr)
+        throw std::invalid_argument("INA NP");
+
+    if (node == nullptr)
+        node = _tail;
+
+    if (node == nullptr)
+    {
+        _root = new Group(true);
+        _head = insNode;
+        _tail = insNode;
+        attach(_root, 0, insNode);
+        return insNode;
+    }
+
+    insNode->_prev = node;
+    insNode->_next = node->_next;
+    if (node->_next)
+        node->_next->_prev = insNode;
+    else
+        _tail = insNode;
+    node->_next = insNode;
+
+    Group *leaf = node->_group;
+    attach(leaf, indexOf(leaf->_nodes, node) + 1, insNode);
+    return insNode;
+}
+
+
+template<typename T, typename Monoid>
+typename AugmentedBidiList<T, Monoid>::Node *
+AugmentedBidiList<T, Monoid>::insertNodeBefore(Node *node, Node *insNode)
+{
+    if (insNode == nullptr || insNode->_next != nullptr || insNode->_prev != nullptr
+            || insNode->_group != nullptr)
+        throw std::invalid_argument("INB NP");
+
+    if (node == nullptr)
+        node = _head;
+
+    if (node == nullptr)
+        return insertNodeAfter(nullptr, insNode);
+
+    insNode->_next = node;
+    insNode->_prev = node->_prev;
+    if (node->_prev)
+        node->_prev->_next = insNode;
+    else
+        _head = insNode;
+    node->_prev = insNode;
+
+    Group *leaf = node->_group;
+    attach(leaf, indexOf(leaf->_nodes, node), insNode);
+    return insNode;
+}
+
+
+template<typename T, typename Monoid>
+void AugmentedBidiList<T, Monoid>::cutNodes(Node *beg, Node *end)
+{
+    if (beg == nullptr || end == nullptr)
+        throw std::invalid_argument("CNS");
+
+    Node *before = beg->_prev;
+    Node *after = end->_next;
+
+    for (Node *node = beg; ; node = node->_next)
+    {
+        detach(node);
+        if (node == end)
+            break;
+    }
+
+    if (before)
+        before->_next = after;
+    else
+        _head = after;
+
+    if (after)
+        after->_prev = before;
+    else
+        _tail = before;
+
+    beg->_prev = nullptr;
+    end->_next = nullptr;
+}
+
+
+template<typename T, typename Monoid>
+typename AugmentedBidiList<T, Monoid>::Node *
+AugmentedBidiList<T, Monoid>::findFirstIn(Node *startFrom, const T &val, std::false_type)
+{
+    ++_stats.searches;
+    for (Node *node = startFrom; node != nullptr; node = node->_next)
+    {
+        ++_stats.nodesVisited;
+        if (node->_val == val)
+            return node;
+    }
+
+    return nullptr;
+}
+
+
+template<typename T, typename Monoid>
+typename AugmentedBidiList<T, Monoid>::Node *
+AugmentedBidiList<T, Monoid>::findFirstIn(Node *startFrom, const T &val, std::true_type)
+{
+    if (startFrom == nullptr || startFrom->_group == nullptr)
+        return findFirstIn(startFrom, val, std::false_type());
+
+    ++_stats.searches;
+    Group *leaf = startFrom->_group;
+    std::size_t i = indexOf(leaf->_nodes, startFrom);
+    if (!Monoid::mayContain(summaryOf(leaf), val))
+    {
+        ++_stats.chunksSkipped;
+        i = leaf->_nodes.size();
+    }
+
+    while (leaf != nullptr)
+    {
+        for (; i < leaf->_nodes.size(); ++i)
+        {
+            ++_stats.nodesVisited;
+            if (leaf->_nodes[i]->_val == val)
+                return leaf->_nodes[i];
+        }
+
+        leaf = nextCandidateLeaf(leaf, val);
+        i = 0;
+    }
+
+    return nullptr;
+}
+
+
+template<typename T, typename Monoid>
+typename AugmentedBidiList<T, Monoid>::Group *
+AugmentedBidiList<T, Monoid>::firstCandidateLeaf(Group *g, const T &val)
+{
+    if (g->_leaf)
+        return g;
+
+    for (std::size_t i = 0; i < g->_children.size(); ++i)
+    {
+        Group *child = g->_children[i];
+        if (!Monoid::mayContain(summaryOf(child), val))
+        {
+            ++_stats.chunksSkipped;
+            continue;
+        }
+
+        // a summary of a big chunk may be a false positive for all its subchunks
+        if (Group *leaf = firstCandidateLeaf(child, val))
+            return leaf;
+    }
+
+    return nullptr;
+}
+
+
+template<typename T, typename Monoid>
+typename AugmentedBidiList<T, Monoid>::Group *
+AugmentedBidiList<T, Monoid>::nextCandidateLeaf(Group *g, const T &val)
+{
+    // climb while there are no candidates among following siblings
+    for (Group *parent = g->_parent; parent != nullptr; g = parent, parent = parent->_parent)
+    {
+        for (std::size_t i = indexOf(parent->_children, g) + 1; i < parent->_children.size(); ++i)
+        {
+            Group *sibling = parent->_children[i];
+            if (!Monoid::mayContain(summaryOf(sibling), val))
+            {
+                ++_stats.chunksSkipped;
+                continue;
+            }
+
+            if (Group *leaf = firstCandidateLeaf(sibling, val))
+                return leaf;
+        }
+    }
+
+    return nullptr;
+}
+
+
+template<typename T, typename Monoid>
+typename AugmentedBidiList<T, Monoid>::Node **
+AugmentedBidiList<T, Monoid>::findAll(Node *startFrom, const T &val, int &size)
+{
+    std::vector<Node *> found;
+    for (Node *node = findFirst(startFrom, val); node != nullptr; node = findFirst(node->_next, val))
+        found.push_back(node);
+
+    size = (int) found.size();
+    if (found.empty())
+        return nullptr;
+
+    Node **res = new Node *[found.size()];
+    for (std::size_t i = 0; i < found.size(); ++i)
+        res[i] = found[i];
+
+    return res;
+}
+
+
+template<typename T, typename Monoid>
+typename AugmentedBidiList<T, Monoid>::Node **
+AugmentedBidiList<T, Monoid>::cutAll(Node *startFrom, const T &val, int &size)
+{
+    Node **res = findAll(startFrom, val, size);
+    for (int i = 0; i < size; ++i)
+        cutNode(res[i]);
+
+    return res;
+}
+
+
+template<typename T, typename Monoid>
+typename AugmentedBidiList<T, Monoid>::Summary
+AugmentedBidiList<T, Monoid>::aggregate(const Node *beg, const Node *end) const
+{
+    if (beg == nullptr || end == nullptr || beg->_group == nullptr || end->_group == nullptr)
+        throw std::invalid_argument("AGG");
+
+    const Group *lg = beg->_group;
+    const Group *rg = end->_group;
+    std::size_t li = indexOf(lg->_nodes, beg);
+    std::size_t ri = indexOf(rg->_nodes, end);
+
+    if (lg == rg)
+        return foldNodes(lg, li, ri + 1);
+
+    // all the leaves are on the same depth, so both sides climb in lockstep
+    // until they meet in a common parent
+    Summary left = foldNodes(lg, li, lg->_nodes.size());
+    Summary right = foldNodes(rg, 0, ri + 1);
+    while (lg->_parent != rg->_parent)
+    {
+        const Group *lp = lg->_parent;
+        const Group *rp = rg->_parent;
+        left = Monoid::combine(left,
+                               foldGroups(lp, indexOf(lp->_children, lg) + 1, lp->_children.size()));
+        right = Monoid::combine(foldGroups(rp, 0, indexOf(rp->_children, rg)), right);
+        lg = lp;
+        rg = rp;
+    }
+
+    const Group *p = lg->_parent;
+    Summary middle = foldGroups(p, indexOf(p->_children, lg) + 1, indexOf(p->_children, rg));
+    return Monoid::combine(Monoid::combine(left, middle), right);
+}
+
+
+template<typename T, typename Monoid>
+void AugmentedBidiList<T, Monoid>::attach(Group *leaf, std::size_t pos, Node *insNode)
+{
+    leaf->_nodes.insert(leaf->_nodes.begin() + pos, insNode);
+    insNode->_group = leaf;
+    ++_size;
+
+    splitIfNeeded(leaf);
+    refreshUp(insNode->_group);
+}
+
+
+template<typename T, typename Monoid>
+void AugmentedBidiList<T, Monoid>::detach(Node *node)
+{
+    Group *g = node->_group;
+    if (g == nullptr)
+        throw std::invalid_argument("CNS NP");
+
+    g->_nodes.erase(g->_nodes.begin() + indexOf(g->_nodes, node));
+    node->_group = nullptr;
+    --_size;
+
+    // drop chunks that became empty
+    while (g->childCount() == 0)
+    {
+        Group *parent = g->_parent;
+        delete g;
+        if (parent == nullptr)
+        {
+            _root = nullptr;
+            return;
+        }
+        parent->_children.erase(parent->_children.begin() + indexOf(parent->_children, g));
+        g = parent;
+    }
+    markStale(g);
+
+    // shrink the hierarchy while the root has a single subchunk
+    while (!_root->_leaf && _root->_children.size() == 1)
+    {
+        Group *oldRoot = _root;
+        _root = oldRoot->_children[0];
+        _root->_parent = nullptr;
+        delete oldRoot;
+    }
+}
+
+
+template<typename T, typename Monoid>
+void AugmentedBidiList<T, Monoid>::splitIfNeeded(Group *g)
+{
+    while (g->childCount() > MAX_FANOUT)
+    {
+        Group *sibling = new Group(g->_leaf);
+        std::size_t half = g->childCount() / 2;
+
+        if (g->_leaf)
+        {
+            sibling->_nodes.assign(g->_nodes.begin() + half, g->_nodes.end());
+            g->_nodes.resize(half);
+            for (std::size_t i = 0; i < sibling->_nodes.size(); ++i)
+                sibling->_nodes[i]->_group = sibling;
+        } else
+        {
+            sibling->_children.assign(g->_children.begin() + half, g->_children.end());
+            g->_children.resize(half);
+            for (std::size_t i = 0; i < sibling->_children.size(); ++i)
+                sibling->_children[i]->_parent = sibling;
+        }
+        recalc(g);
+        recalc(sibling);
+
+        Group *parent = g->_parent;
+        if (parent == nullptr)
+        {
+            parent = new Group(false);
+            parent->_children.push_back(g);
+            g->_parent = parent;
+            _root = parent;
+        }
+        parent->_children.insert(parent->_children.begin() + indexOf(parent->_children, g) + 1,
+                                 sibling);
+        sibling->_parent = parent;
+
+        g = parent;
+    }
+}
+
+
+template<typename T, typename Monoid>
+void AugmentedBidiList<T, Monoid>::refreshUp(Group *g)
+{
+    while (g != nullptr)
+    {
+        recalc(g);
+        g = g->_parent;
+    }
+}
+
+
+template<typename T, typename Monoid>
+void AugmentedBidiList<T, Monoid>::markStale(Group *g)
+{
+    // ancestors of a stale chunk are stale already
+    while (g != nullptr && !g->_stale)
+    {
+        g->_stale = true;
+        g = g->_parent;
+    }
+}
+
+
+template<typename T, typename Monoid>
+void AugmentedBidiList<T, Monoid>::recalc(const Group *g)
+{
+    g->_summary = g->_leaf ? foldNodes(g, 0, g->_nodes.size())
+                           : foldGroups(g, 0, g->_children.size());
+    g->_stale = false;
+}
+
+
+template<typename T, typename Monoid>
+typename AugmentedBidiList<T, Monoid>::Summary
+AugmentedBidiList<T, Monoid>::foldNodes(const Group *g, std::size_t from, std::size_t to)
+{
+    Summary res = Monoid::identity();
+    for (std::size_t i = from; i < to; ++i)
+        res = Monoid::combine(res, Monoid::lift(g->_nodes[i]->_val));
+
+    return res;
+}
+
+
+template<typename T, typename Monoid>
+typename AugmentedBidiList<T, Monoid>::Summary
+AugmentedBidiList<T, Monoid>::foldGroups(const Group *g, std::size_t from, std::size_t to)
+{
+    Summary res = Monoid::identity();
+    for (std::size_t i = from; i < to; ++i)
+        res = Monoid::combine(res, summaryOf(g->_children[i]));
+
+    return res;
+}
+
+
+template<typename T, typename Monoid>
+template<typename Item>
+std::size_t AugmentedBidiList<T, Monoid>::indexOf(const std::vector<Item *> &items, const Item *item)
+{
+    std::size_t i = 0;
+    while (items[i] != item)
+        ++i;
+
+    return i;
+}
+
+
+template<typename T, typename Monoid>
+void AugmentedBidiList<T, Monoid>::deleteGroups(Group *g)
+{
+    for (std::size_t i = 0; i < g->_children.size(); ++i)
+        deleteGroups(g->_children[i]);
+
+    delete g;
+}
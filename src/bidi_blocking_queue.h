@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the bounded blocking queue built on
+/// BidiLinkedList splices.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_BLOCKINGQUEUE_H_
+#define XI_ENHLINKEDLIST_BLOCKINGQUEUE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>      // size_t
+#include <mutex>
+
+#include "bidi_linked_list.h"
+
+
+/** \brief Declares a bounded FIFO queue of values for any number of producer and
+ *  consumer threads, which block while it is full or empty
+ *
+ *  Values travel in batches of nodes: a producer builds its chain aside and the
+ *  queue links it to its end by one splice, a consumer gets a chain cut from the
+ *  front by one BidiLinkedList::cutNodes() and spliced into a list of its own. So
+ *  nodes are allocated and freed outside the lock, and a batch costs one lock and
+ *  at most one wake-up however many values it carries. Taking every queued value
+ *  is O(1) under the lock; taking fewer walks to the end of the batch.
+ *
+ *  A batch is let in once it fits into the capacity, or into an empty queue if it
+ *  is bigger than the capacity, so producers are slowed down to the pace of
+ *  consumers. Threads are woken one at a time: a notification goes out only if
+ *  somebody waits, and a woken thread passes it on if there is more for others to
+ *  do, so a batch never wakes up every waiting thread at once. The exception is a
+ *  woken producer whose batch still does not fit: it cannot tell which of the
+ *  others would, so it wakes them all, once per room made by consumers.
+ *
+ *  close() makes pushes fail and lets consumers take what is left, then their pops
+ *  return nothing instead of blocking.
+ */
+template<typename T, typename Policy = DefaultBidiListPolicy>
+class BidiBlockingQueue
+{
+public:
+    //-----<Types>-----
+    typedef BidiLinkedList<T, Policy> List;
+    typedef typename List::Node Node;
+
+public:
+    /** \brief Creates a queue of \a capacity values at most, which must not be 0 */
+    explicit BidiBlockingQueue(std::size_t capacity);
+
+    BidiBlockingQueue(const BidiBlockingQueue &) = delete;
+    BidiBlockingQueue &operator=(const BidiBlockingQueue &) = delete;
+
+public:
+    //-----<Producers>-----
+
+    /** \brief Pushes \a val, waiting for room; returns false if the queue is closed */
+    bool push(const T &val);
+
+    /** \brief Moves all nodes of \a src to the end of the queue at once, waiting
+     *  for room; returns false and leaves \a src as it is if the queue is closed
+     */
+    bool pushBatch(List &src);
+
+    /** \brief Pushes copies of values of a range `[first, last)` at once, see
+     *  pushBatch(List&)
+     */
+    template<typename InputIt>
+    bool pushBatch(InputIt first, InputIt last);
+
+public:
+    //-----<Consumers>-----
+
+    /** \brief Pops a front value into \a val, waiting for it; returns false if the
+     *  queue is closed and empty
+     */
+    bool pop(T &val);
+
+    /** \brief Moves at most \a maxCount front nodes to the end of \a out, waiting
+     *  for at least one
+     *  \return a number of nodes moved; 0 if the queue is closed and empty
+     */
+    std::size_t popBatch(List &out, std::size_t maxCount);
+
+    /** \brief Same as popBatch(List&, std::size_t), but gives up after \a timeout,
+     *  returning 0
+     */
+    template<typename Rep, typename Period>
+    std::size_t popBatch(List &out, std::size_t maxCount, const std::chrono::duration<Rep, Period> &timeout)
+    {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+        return popBatchUntil(out, maxCount, &deadline);
+    }
+
+public:
+    //-----<Common>-----
+
+    /** \brief Makes pushes fail from now on and wakes up every waiting thread */
+    void close();
+
+    /** \brief Returns whether close() has been called */
+    bool isClosed();
+
+    /** \brief Returns a number of queued values */
+    std::size_t getSize();
+
+    /** \brief Returns the capacity given on creation */
+    std::size_t getCapacity() const { return _capacity; }
+
+protected:
+    /** \brief Links a free chain `[beg, end]` of \a count nodes to the end once it
+     *  fits; returns false without taking the chain if the queue is closed
+     */
+    bool admit(Node *beg, Node *end, std::size_t count);
+
+    /** \brief Cuts at most \a maxCount front nodes as a free chain `[beg, end]`,
+     *  waiting until \a deadline, or for ever if \a deadline is nullptr
+     *  \return a number of nodes cut; 0 on a timeout or if the queue is closed and empty
+     */
+    std::size_t take(std::size_t maxCount, const std::chrono::steady_clock::time_point *deadline,
+                     Node *&beg, Node *&end);
+
+    /** \brief See popBatch() */
+    std::size_t popBatchUntil(List &out, std::size_t maxCount,
+                              const std::chrono::steady_clock::time_point *deadline);
+
+protected:
+    List _lst;                          ///< Queued nodes
+    std::size_t _count;                 ///< Number of queued nodes
+    std::size_t _capacity;
+    bool _closed;
+
+    std::size_t _producersWaiting;      ///< Number of producers blocked on #_notFull
+    std::size_t _consumersWaiting;      ///< Number of consumers blocked on #_notEmpty
+    bool _roomOffered;                  ///< Whether all producers have seen the room made last
+
+    std::mutex _lock;                   ///< Guards all the members above
+    std::condition_variable _notFull;   ///< Signals room for producers
+    std::condition_variable _notEmpty;  ///< Signals values for consumers
+}; // class BidiBlockingQueue
+
+
+// declaration of template class template methods
+#include "bidi_blocking_queue.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_BLOCKINGQUEUE_H_
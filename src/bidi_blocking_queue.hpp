@@ -0,0 +1,237 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the bounded blocking queue
+/// declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+
+
+//==============================================================================
+// class BidiBlockingQueue<T, Policy>
+//==============================================================================
+
+
+template<typename T, typename Policy>
+BidiBlockingQueue<T, Policy>::BidiBlockingQueue(std::size_t capacity)
+    : _count(0)
+    , _capacity(capacity)
+    , _closed(false)
+    , _producersWaiting(0)
+    , _consumersWaiting(0)
+    , _roomOffered(false)
+{
+    if (capacity == 0)
+        throw std::invalid_argument("BQ CAP");
+}
+
+
+template<typename T, typename Policy>
+bool BidiBlockingQueue<T, Policy>::admit(Node *beg, Node *end, std::size_t count)
+{
+    bool wakeConsumer, wakeProducer;
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        bool woken = false;
+        while (!_closed && _count != 0 && _count + count > _capacity)
+        {
+            // a smaller batch of another producer may fit into the room this one
+            // has been woken for
+            if (woken && _producersWaiting != 0 && !_roomOffered)
+            {
+                _roomOffered = true;
+                _notFull.notify_all();
+            }
+
+            ++_producersWaiting;
+            _notFull.wait(lock);
+            --_producersWaiting;
+            woken = true;
+        }
+        if (_closed)
+            return false;
+
+        _lst.insertNodesAfter(nullptr, beg, end, count);
+        _count += count;
+
+        // one consumer is woken, it passes the wake-up on if it leaves values over;
+        // room left over is passed on to the next producer the same way
+        wakeConsumer = _consumersWaiting != 0;
+        wakeProducer = _producersWaiting != 0 && _count < _capacity;
+    }
+
+    if (wakeConsumer)
+        _notEmpty.notify_one();
+    if (wakeProducer)
+        _notFull.notify_one();
+    return true;
+}
+
+
+template<typename T, typename Policy>
+bool BidiBlockingQueue<T, Policy>::push(const T &val)
+{
+    Node *node = new Node(val);
+    if (admit(node, node, 1))
+        return true;
+
+    delete node;
+    return false;
+}
+
+
+template<typename T, typename Policy>
+bool BidiBlockingQueue<T, Policy>::pushBatch(List &src)
+{
+    Node *beg = src.getHeadNode();
+    if (beg == nullptr)
+        return !isClosed();
+
+    std::size_t count = src.getSize();
+    Node *end = src.getLastNode();
+    src.cutNodes(beg, end);
+    if (admit(beg, end, count))
+        return true;
+
+    src.insertNodesAfter(nullptr, beg, end, count);
+    return false;
+}
+
+
+template<typename T, typename Policy>
+template<typename InputIt>
+bool BidiBlockingQueue<T, Policy>::pushBatch(InputIt first, InputIt last)
+{
+    // nodes are made before the lock is taken; the chain is freed if not pushed
+    List chain;
+    chain.appendRange(first, last);
+    return pushBatch(chain);
+}
+
+
+template<typename T, typename Policy>
+std::size_t BidiBlockingQueue<T, Policy>::take(std::size_t maxCount,
+                                               const std::chrono::steady_clock::time_point *deadline,
+                                               Node *&beg, Node *&end)
+{
+    if (maxCount == 0)
+        return 0;
+
+    std::size_t count;
+    bool wakeConsumer, wakeProducer;
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        while (_count == 0 && !_closed)
+        {
+            bool timedOut = false;
+            ++_consumersWaiting;
+            if (deadline == nullptr)
+                _notEmpty.wait(lock);
+            else
+                timedOut = _notEmpty.wait_until(lock, *deadline) == std::cv_status::timeout;
+            --_consumersWaiting;
+
+            if (timedOut)
+                break;
+        }
+        if (_count == 0)
+            return 0;
+
+        // the whole queue is cut in O(1), a part of it needs a walk to its end
+        beg = _lst.getHeadNode();
+        if (maxCount >= _count)
+        {
+            end = _lst.getLastNode();
+            count = _count;
+        } else
+        {
+            end = beg;
+            for (count = 1; count < maxCount; ++count)
+                end = end->getNext();
+        }
+        _lst.cutNodes(beg, end);
+        _count -= count;
+        _roomOffered = false;
+
+        wakeConsumer = _consumersWaiting != 0 && _count != 0;
+        wakeProducer = _producersWaiting != 0;
+    }
+
+    if (wakeConsumer)
+        _notEmpty.notify_one();
+    if (wakeProducer)
+        _notFull.notify_one();
+    return count;
+}
+
+
+template<typename T, typename Policy>
+std::size_t BidiBlockingQueue<T, Policy>::popBatchUntil(List &out, std::size_t maxCount,
+                                                        const std::chrono::steady_clock::time_point *deadline)
+{
+    Node *beg;
+    Node *end;
+    std::size_t count = take(maxCount, deadline, beg, end);
+    if (count != 0)
+        out.insertNodesAfter(nullptr, beg, end, count);
+
+    return count;
+}
+
+
+template<typename T, typename Policy>
+std::size_t BidiBlockingQueue<T, Policy>::popBatch(List &out, std::size_t maxCount)
+{
+    return popBatchUntil(out, maxCount, nullptr);
+}
+
+
+template<typename T, typename Policy>
+bool BidiBlockingQueue<T, Policy>::pop(T &val)
+{
+    Node *beg;
+    Node *end;
+    if (take(1, nullptr, beg, end) == 0)
+        return false;
+
+    val = beg->getValue();
+    delete beg;
+    return true;
+}
+
+
+template<typename T, typename Policy>
+void BidiBlockingQueue<T, Policy>::close()
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _closed = true;
+    }
+    _notFull.notify_all();
+    _notEmpty.notify_all();
+}
+
+
+template<typename T, typename Policy>
+bool BidiBlockingQueue<T, Policy>::isClosed()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _closed;
+}
+
+
+template<typename T, typename Policy>
+std::size_t BidiBlockingQueue<T, Policy>::getSize()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _count;
+}
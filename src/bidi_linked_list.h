@@ -21,6 +21,178 @@
 #define IWANNAGET10POINTS
 
 #include <cstddef>      // size_t
+#include <functional>   // hash
+
+/** \brief Default number of nodes a traversal prefetches ahead of the visited one.
+ *  Can be overridden with `-DBIDI_PREFETCH_DISTANCE=n` or per list with
+ *  BidiLinkedList::setPrefetchDistance(); zero disables prefetching.
+ */
+#ifndef BIDI_PREFETCH_DISTANCE
+#define BIDI_PREFETCH_DISTANCE 4
+#endif
+
+
+/** \brief Ways a list reorders itself on successful findFirst() calls, so that
+ *  frequently searched values gather near the head
+ */
+enum BidiSelfOrganization
+{
+    BIDI_SELF_ORG_NONE = 0,     ///< the order is never changed by searches
+    BIDI_MOVE_TO_FRONT,         ///< a found node is moved to the head
+    BIDI_TRANSPOSE,             ///< a found node is swapped with its predecessor
+    BIDI_FREQUENCY_COUNT        ///< nodes count hits and stay ordered by them
+};
+
+
+/** \brief Hit counter of a node of a list with BIDI_FREQUENCY_COUNT organization;
+ *  empty and free for other lists
+ */
+template<bool Counted>
+class BidiNodeHits
+{
+public:
+    /** \brief Returns a number of times the node was found by findFirst() */
+    std::size_t getHits() const { return 0; }
+
+protected:
+    void hit() {}
+    void resetHits() {}
+    void copyHits(const BidiNodeHits &) {}
+};
+
+template<>
+class BidiNodeHits<true>
+{
+public:
+    BidiNodeHits() : _hits(0) {}
+
+    std::size_t getHits() const { return _hits; }
+
+protected:
+    void hit() { ++_hits; }
+    void resetHits() { _hits = 0; }
+    void copyHits(const BidiNodeHits &other) { _hits = other._hits; }
+
+protected:
+    std::size_t _hits;          ///< Number of hits
+};
+
+
+/** \brief Cached hash of a value of a node of a list with `HASH_TAGS` policy;
+ *  empty and free for other lists, whose tags match everything
+ */
+template<typename T, bool Tagged>
+class BidiNodeTag
+{
+public:
+    /** \brief Returns a tag to be compared with tags of nodes carrying \a val */
+    static std::size_t tagOf(const T &) { return 0; }
+
+protected:
+    bool tagMatches(std::size_t) const { return true; }
+    void retag(const T &) {}
+    void copyTag(const BidiNodeTag &) {}
+};
+
+template<typename T>
+class BidiNodeTag<T, true>
+{
+public:
+    BidiNodeTag() : _tag(0) {}
+
+    static std::size_t tagOf(const T &val) { return std::hash<T>()(val); }
+
+    /** \brief Returns the cached hash of the value of the node */
+    std::size_t getHashTag() const { return _tag; }
+
+protected:
+    bool tagMatches(std::size_t tag) const { return _tag == tag; }
+    void retag(const T &val) { _tag = tagOf(val); }
+    void copyTag(const BidiNodeTag &other) { _tag = other._tag; }
+
+protected:
+    std::size_t _tag;           ///< `std::hash` of the value
+};
+
+
+/** \brief Default configuration of a BidiLinkedList: every feature is on
+ *
+ *  A policy is a class with static constant members, which are read at compile
+ *  time, so a disabled feature leaves neither code nor branches behind. To change
+ *  some of them, derive from this class and redeclare the constants:
+ *
+ *  `struct FastPolicy : DefaultBidiListPolicy { static const bool CHECKED = false; };`
+ */
+struct DefaultBidiListPolicy
+{
+    /** \brief Whether structural methods validate their arguments
+     *
+     *  An unchecked list trusts a caller: passing nullptr or a node that is not
+     *  free leads to undefined behavior.
+     */
+    static const bool CHECKED = true;
+
+    /** \brief Whether a size is cached; otherwise getSize() counts nodes on every call */
+    static const bool TRACK_SIZE = true;
+
+    /** \brief Whether a pointer to the last node is kept; otherwise getLastNode(),
+     *  and so appending, walks the list from the head
+     */
+    static const bool TRACK_TAIL = true;
+
+    /** \brief Whether failed checks throw `std::invalid_argument`; otherwise they
+     *  are reported by BidiLinkedList::getLastError()
+     */
+    static const bool USE_EXCEPTIONS = true;
+
+    /** \brief Maximum number of nodes freed by pops that are kept for reuse by pushes;
+     *  zero disables caching
+     */
+    static const std::size_t NODE_CACHE_SIZE = 16;
+
+    /** \brief Whether BidiLinkedList::reverse() is available; requires TRACK_TAIL
+     *
+     *  Off by default, so that link accesses of other lists compile to plain loads.
+     */
+    static const bool REVERSIBLE = false;
+
+    /** \brief How findFirst() reorders a list, see BidiSelfOrganization */
+    static const BidiSelfOrganization SELF_ORGANIZATION = BIDI_SELF_ORG_NONE;
+
+    /** \brief Whether nodes cache `std::hash` of their values, so that searches run
+     *  `operator==` on a hash match only
+     *
+     *  Pays off for values that are expensive to compare, such as long strings.
+     *  A tag is updated by Node::setValue() and by list methods; a value changed
+     *  in place, through getValue() or an iterator, needs Node::setValue() after.
+     */
+    static const bool HASH_TAGS = false;
+
+    /** \brief Whether links are read with acquire and written with release atomic
+     *  accesses, so that readers may traverse the list while one writer changes it
+     *
+     *  Cut chains then keep their outer links, so that a reader standing on a cut
+     *  node goes on to the rest of the list; such nodes must not be reinserted or
+     *  freed until the readers are gone. Used by RcuBidiList, which takes care of
+     *  that. Off by default, so that link accesses compile to plain loads and stores
+     *  regardless of a compiler.
+     */
+    static const bool RCU_READERS = false;
+};
+
+
+/** \brief Errors reported by a list whose policy disables exceptions */
+enum BidiListError
+{
+    BIDI_LIST_OK = 0,           ///< no error
+    BIDI_LIST_NULL_NODE,        ///< a node argument is nullptr
+    BIDI_LIST_NODE_NOT_FREE,    ///< an inserted node or chain is linked to other nodes
+    BIDI_LIST_EMPTY             ///< an element is popped from an empty list
+};
+
+
+template<typename T, typename Policy>
+class BidiMpscQueue;
 
 
 /** \brief Declares a generic purpose bidirectional list
@@ -31,10 +203,15 @@
  *  **Requirements to a `T`** are as follows:
  *  *   `T` should be default constructable
  *  *   `T` should be copyable
+ *
+ *  Checks, size and tail tracking and error reporting are configured by
+ *  \a Policy, see DefaultBidiListPolicy.
  */
-template<typename T>
+template<typename T, typename Policy = DefaultBidiListPolicy>
 class BidiLinkedList
 {
+    static_assert(!Policy::REVERSIBLE || Policy::TRACK_TAIL, "a reversible list needs a tail pointer");
+
 public:
     //-----<Consts>------
     /** \brief Determines a value for case when a size has not been still calculated */
@@ -53,27 +230,31 @@ public:
      *
      *  *    `template <typename T> typename BidiList<T>::Node* BidiList<T>::getLastNode() const`
      */
-    class Node
+    class Node : public BidiNodeHits<Policy::SELF_ORGANIZATION == BIDI_FREQUENCY_COUNT>,
+                 public BidiNodeTag<T, Policy::HASH_TAGS>
     {
         /** \brief Declare a Bidilist as a friend class to allow it to have access to 
          *  Node's private members. 
          */
         friend class BidiLinkedList;
 
+        /** \brief A queue links nodes by the same fields, see BidiMpscQueue */
+        friend class BidiMpscQueue<T, Policy>;
+
     public:
         /** \brief Default constructor */
-        Node() : _next(nullptr), _prev(nullptr) {}
+        Node() : _next(nullptr), _prev(nullptr) { this->retag(_val); }
 
         /** \brief Inititalization wit a node element */
-        Node(const T &el) : _next(nullptr), _prev(nullptr), _val(el) {}
+        Node(const T &el) : _next(nullptr), _prev(nullptr), _val(el) { this->retag(_val); }
 
 
     public:
         /** \brief Returns a pointer to a previous element */
-        Node *getPrev() const { return _prev; }
+        Node *getPrev() const { return loadLink(_prev); }
 
         /** \brief Returns a pointer to a next element */
-        Node *getNext() const { return _next; }
+        Node *getNext() const { return loadLink(_next); }
 
         /** \brief Returns node's value */
         T &getValue() { return _val; }
@@ -82,7 +263,11 @@ public:
         const T &getValue() const { return _val; }
 
         /** \brief Sets a new value carried by the node */
-        void setValue(const T &newVal) { _val = newVal; }
+        void setValue(const T &newVal)
+        {
+            _val = newVal;
+            this->retag(_val);
+        }
 
     public:
 
@@ -121,19 +306,21 @@ public:
     {
 
     public:
-        MyIterator(Node *n, bool b = false)
+        MyIterator(Node *n, bool b = false, bool rev = false)
         {
             _point = n;
-            _isItEnd = b;
+            _isItEnd = b || n == nullptr;
+            _rev = rev;
         }
 
         MyIterator &operator++()
         {
-            if (_point->_next == nullptr)
+            Node *next = nextNode(_point, _rev);
+            if (next == nullptr)
                 _isItEnd = true;
 
             else
-                _point = _point->_next;
+                _point = next;
             return *this;
         }
 
@@ -153,18 +340,13 @@ public:
 
         bool operator!=(const MyIterator &obj) const
         {
-            if (obj._point != this->_point || obj._isItEnd != this->_isItEnd)
-                return true;
-            else
-                return false;
+            return !(*this == obj);
         }
 
         bool operator==(const MyIterator &obj) const
         {
-            if (obj._point == this->_point && obj._isItEnd == this->_isItEnd)
-                return true;
-            else
-                return false;
+            // end iterators are equal wherever the list ended when they were taken
+            return obj._isItEnd == this->_isItEnd && (_isItEnd || obj._point == this->_point);
         }
 
         T &operator*() const
@@ -183,7 +365,7 @@ public:
                 _isItEnd = false;
 
             else
-                _point = _point->_prev;
+                _point = prevNode(_point, _rev);
             return *this;
         }
 
@@ -191,26 +373,29 @@ public:
     protected:
         Node *_point;
         bool _isItEnd;
+        bool _rev;              ///< Whether the list was reversed, see BidiLinkedList::reverse()
     };
 
 
     class MyIteratorConst // You can rename it and extend it from std::iterator if you need for some reason.
     {
     public:
-        MyIteratorConst(Node *n, bool b = false)
+        MyIteratorConst(Node *n, bool b = false, bool rev = false)
         {
             _point = n;
-            _isItEnd = b;
+            _isItEnd = b || n == nullptr;
+            _rev = rev;
         }
 
         const MyIteratorConst &operator++()
         {
 
-            if (_point->_next == nullptr)
+            Node *next = nextNode(_point, _rev);
+            if (next == nullptr)
                 _isItEnd = true;
 
             else
-                _point = _point->_next;
+                _point = next;
             return *this;
         }
 
@@ -231,18 +416,13 @@ public:
 
         bool operator!=(const MyIteratorConst &obj) const
         {
-            if (obj._point != this->_point || obj._isItEnd != this->_isItEnd)
-                return true;
-            else
-                return false;
+            return !(*this == obj);
         }
 
         bool operator==(const MyIteratorConst &obj) const
         {
-            if (obj._point == this->_point && obj._isItEnd == this->_isItEnd)
-                return true;
-            else
-                return false;
+            // end iterators are equal wherever the list ended when they were taken
+            return obj._isItEnd == this->_isItEnd && (_isItEnd || obj._point == this->_point);
         }
 
         const T &operator*() const
@@ -261,7 +441,7 @@ public:
                 _isItEnd = false;
 
             else
-                _point = _point->_prev;
+                _point = prevNode(_point, _rev);
             return *this;
         }
 
@@ -269,16 +449,18 @@ public:
     protected:
         Node *_point;
         bool _isItEnd;
+        bool _rev;              ///< Whether the list was reversed, see BidiLinkedList::reverse()
     };
 
 
     class MyIteratorReverse // You can rename it and extend it from std::iterator if you need for some reason.
     {
     public:
-        MyIteratorReverse(Node *n, bool b = false)
+        MyIteratorReverse(Node *n, bool b = false, bool rev = false)
         {
             _point = n;
-            _isItEnd = b;
+            _isItEnd = b || n == nullptr;
+            _rev = rev;
         }
 
         MyIteratorReverse &operator--()
@@ -288,7 +470,7 @@ public:
                 _isItEnd = false;
 
             else
-                _point = _point->_next;
+                _point = nextNode(_point, _rev);
             return *this;
         }
 
@@ -308,18 +490,13 @@ public:
 
         bool operator!=(const MyIteratorReverse &obj) const
         {
-            if (obj._point != this->_point || obj._isItEnd != this->_isItEnd)
-                return true;
-            else
-                return false;
+            return !(*this == obj);
         }
 
         bool operator==(const MyIteratorReverse &obj) const
         {
-            if (obj._point == this->_point && obj._isItEnd == this->_isItEnd)
-                return true;
-            else
-                return false;
+            // end iterators are equal wherever the list ended when they were taken
+            return obj._isItEnd == this->_isItEnd && (_isItEnd || obj._point == this->_point);
         }
 
         T &operator*() const
@@ -334,11 +511,12 @@ public:
 
         MyIteratorReverse &operator++()
         {
-            if (_point->_prev == nullptr)
+            Node *next = prevNode(_point, _rev);
+            if (next == nullptr)
                 _isItEnd = true;
 
             else
-                _point = _point->_prev;
+                _point = next;
             return *this;
         }
 
@@ -346,16 +524,18 @@ public:
     protected:
         Node *_point;
         bool _isItEnd;
+        bool _rev;              ///< Whether the list was reversed, see BidiLinkedList::reverse()
     };
 
 
     class MyIteratorReverseConst // You can rename it and extend it from std::iterator if you need for some reason.
     {
     public:
-        MyIteratorReverseConst(Node *n, bool b = false)
+        MyIteratorReverseConst(Node *n, bool b = false, bool rev = false)
         {
             _point = n;
-            _isItEnd = b;
+            _isItEnd = b || n == nullptr;
+            _rev = rev;
         }
 
         const MyIteratorReverseConst &operator--()
@@ -364,7 +544,7 @@ public:
                 _isItEnd = false;
 
             else
-                _point = _point->_next;
+                _point = nextNode(_point, _rev);
             return *this;
         }
 
@@ -384,18 +564,13 @@ public:
 
         bool operator!=(const MyIteratorReverseConst &obj) const
         {
-            if (obj._point != this->_point || obj._isItEnd != this->_isItEnd)
-                return true;
-            else
-                return false;
+            return !(*this == obj);
         }
 
         bool operator==(const MyIteratorReverseConst &obj) const
         {
-            if (obj._point == this->_point && obj._isItEnd == this->_isItEnd)
-                return true;
-            else
-                return false;
+            // end iterators are equal wherever the list ended when they were taken
+            return obj._isItEnd == this->_isItEnd && (_isItEnd || obj._point == this->_point);
         }
 
         const T &operator*() const
@@ -410,11 +585,12 @@ public:
 
         const MyIteratorReverseConst &operator++()
         {
-            if (_point->_prev == nullptr)
+            Node *next = prevNode(_point, _rev);
+            if (next == nullptr)
                 _isItEnd = true;
 
             else
-                _point = _point->_prev;
+                _point = next;
             return *this;
         }
 
@@ -422,6 +598,7 @@ public:
     protected:
         Node *_point;
         bool _isItEnd;
+        bool _rev;              ///< Whether the list was reversed, see BidiLinkedList::reverse()
     };
 
 
@@ -442,7 +619,7 @@ public:
      */
     iterator begin()
     {
-        return MyIterator(_head, false);
+        return MyIterator(getHeadNode(), false, isReversed());
     }
 
     /** \brief Returns an iterator to the non existing element after the end of the list.
@@ -450,39 +627,39 @@ public:
     */
     iterator end()
     {
-        return MyIterator(_tail, true);
+        return MyIterator(getLastNode(), true, isReversed());
     }
 
     // Similary you should define rbegin() rend() and their const combinations for reversed iterators:
 
     const_iterator cbegin()
     {
-        return MyIteratorConst(_head, false);
+        return MyIteratorConst(getHeadNode(), false, isReversed());
     }
 
     const_iterator cend()
     {
-        return MyIteratorConst(_tail, true);
+        return MyIteratorConst(getLastNode(), true, isReversed());
     }
 
     reverse_iterator rbegin()
     {
-        return MyIteratorReverse(_tail, false);
+        return MyIteratorReverse(getLastNode(), false, isReversed());
     }
 
     reverse_iterator rend()
     {
-        return MyIteratorReverse(_head, true);
+        return MyIteratorReverse(getHeadNode(), true, isReversed());
     }
 
     const_reverse_iterator crbegin()
     {
-        return MyIteratorReverseConst(_tail, false);
+        return MyIteratorReverseConst(getLastNode(), false, isReversed());
     }
 
     const_reverse_iterator crend()
     {
-        return MyIteratorReverseConst(_head, true);
+        return MyIteratorReverseConst(getHeadNode(), true, isReversed());
     }
 
 protected:
@@ -492,7 +669,9 @@ protected:
 
 public:
     /** \brief Default constructor */
-    BidiLinkedList() : _head(nullptr), _tail(nullptr), _size(NO_SIZE) {};
+    BidiLinkedList() : _head(nullptr), _tail(nullptr), _size(NO_SIZE),
+        _prefetchDist(BIDI_PREFETCH_DISTANCE), _relinCursor(nullptr), _lastError(BIDI_LIST_OK),
+        _nodeCache(nullptr), _cachedNodes(0), _reversed(false), _finger(nullptr) {};
 
     /** \brief Destructor
      *
@@ -503,7 +682,8 @@ public:
     // TODO don't forget about big three. You can either implement it or just declare private.
 public:
 
-    /** \brief Clears the list (deletes all elements and frees memory) 
+    /** \brief Clears the list (deletes all elements and frees memory, including
+     *  cached nodes)
      *
      *  <b style='color:orange'>Must be implemented by students</b>
      */
@@ -546,6 +726,69 @@ public:
      */
     void insertNodesAfter(Node *node, Node *beg, Node *end);
 
+    /** \brief Overloaded version of insertNodesAfter() for a chain of known length
+     *  \a count, which keeps a calculated size valid instead of invalidating it
+     *
+     *  \a count must be the exact number of nodes in `[beg, end]`.
+     */
+    void insertNodesAfter(Node *node, Node *beg, Node *end, std::size_t count);
+
+    /** \brief Inserts copies of values of a range `[first, last)` after node \a node
+     *  \return the first inserted node, or nullptr for an empty range
+     *
+     *  Nodes are created and linked to each other aside from the list, then the
+     *  chain is spliced in at once with no checks, and the size is updated by the
+     *  number of nodes. If \a node is nullptr, the values are appended. If copying
+     *  a value throws, the list stays unchanged.
+     */
+    template<typename InputIt>
+    Node *insertRangeAfter(Node *node, InputIt first, InputIt last);
+
+    /** \brief Appends copies of values of a range `[first, last)`, see insertRangeAfter() */
+    template<typename InputIt>
+    Node *appendRange(InputIt first, InputIt last) { return insertRangeAfter(nullptr, first, last); }
+
+    /** \brief Replaces the content of the list with copies of values of a range
+     *  `[first, last)`
+     *
+     *  Existing nodes are reused in order: they get new values, the ones left over
+     *  are deleted and missing ones are appended as by appendRange(). Pointers to
+     *  the reused nodes stay valid.
+     *
+     *  Reused nodes are overwritten in place, so if copying a value throws, the
+     *  list stays valid but may carry some of the new values followed by old ones.
+     */
+    template<typename InputIt>
+    void assign(InputIt first, InputIt last);
+
+    //-----<Deque-style access>-----
+
+    /** \brief Inserts a given element at the very begin */
+    void pushFront(const T &val);
+
+    /** \brief Appends a given element, like appendEl() does */
+    void pushBack(const T &val) { appendEl(val); }
+
+    /** \brief Removes the first element and returns its value
+     *
+     *  A node of the element is kept for reuse by following pushes, as long as
+     *  there are less than `Policy::NODE_CACHE_SIZE` cached nodes, so a list used
+     *  as a queue of bounded length stops allocating memory. Popping from an
+     *  empty list is an error reported as by insertNodeAfter(), and `T()` is returned.
+     */
+    T popFront();
+
+    /** \brief Removes the last element and returns its value, see popFront() */
+    T popBack();
+
+    /** \brief Removes at most \a n first elements moving their values to \a out
+     *  \return a number of removed elements
+     */
+    std::size_t popFrontN(T *out, std::size_t n);
+
+    /** \brief Returns a number of nodes cached for reuse by pushes */
+    std::size_t getCachedNodeCount() const { return _cachedNodes; }
+
     // this part of code is active only if you'd like to get the highest mark
 #ifdef IWANNAGET10POINTS
 
@@ -614,7 +857,7 @@ public:
      *  
      *  <b style='color:orange'>Must be implemented by students</b>
      */
-    Node *findFirst(const T &val) { return findFirst(_head, val); };
+    Node *findFirst(const T &val) { return findFirst(getHeadNode(), val); };
 
     /** \brief Finds first node carrying a given value \a val, starting from a given 
      *  node \a startFrom, and returns it
@@ -626,6 +869,10 @@ public:
      *  Node \a startFrom is also tested for suitability of the search condition.
      *  If the given \a startFrom node is nullptr, returns nullptr immediately
      *
+     *  Unless `Policy::SELF_ORGANIZATION` is BIDI_SELF_ORG_NONE, a found node is
+     *  moved towards the head, see BidiSelfOrganization. Iterators stay valid,
+     *  but an iteration in progress may then visit nodes twice or skip them.
+     *
      *  <b style='color:orange'>Must be implemented by students</b>
      */
     Node *findFirst(Node *startFrom, const T &val);
@@ -647,14 +894,39 @@ public:
     Node **findAll(Node *startFrom, const T &val, int &size);
 
     /** \brief Overloaded version of findAll(): searching in the entire list */
-    Node **findAll(const T &val, int &size) { return findAll(_head, val, size); };
+    Node **findAll(const T &val, int &size) { return findAll(getHeadNode(), val, size); };
+
+    /** \brief Finds a node carrying \a val closest to the finger, that is the node
+     *  found last by findFirst() or findNear()
+     *  \return a found node, which becomes the finger; nullptr if nothing is found
+     *
+     *  The search goes outward from the finger in both directions by turns, so a
+     *  value `k` nodes away is found in about `2k` steps. Without a finger, the
+     *  search starts from the head. Cutting the finger's node, cutting any chain of
+     *  several nodes and clearing drop the finger.
+     */
+    Node *findNear(const T &val);
+
+    /** \brief Returns the finger used by findNear(), or nullptr */
+    Node *getFinger() const { return _finger; }
+
+    /** \brief Sets the finger used by findNear() to a node of this list, or nullptr */
+    void setFinger(Node *node) { _finger = node; }
+
+    /** \brief Returns a number of nodes carrying a given value \a val */
+    std::size_t count(const T &val);
+
+    /** \brief Returns whether any node carries a given value \a val */
+    bool contains(const T &val) { return findFirst(val) != nullptr; }
 
     /** \brief Looking for a node with value \a val and cuts it from the list. 
      *  \param cutted node if found, nullptr otherwise
      */
     Node *cutFirst(Node *startFrom, const T &val)
     {
-        Node *res = findFirst(startFrom, val);
+        // the node is going away, so the list is not reorganized
+        std::size_t tag = Node::tagOf(val);
+        Node *res = traverse(startFrom, [&val, tag](Node *node) { return carries(node, val, tag); });
         if (res)
             return cutNode(res);
 
@@ -662,7 +934,19 @@ public:
     }
 
     /** \brief Cuts first node with the given value \a val */
-    Node *cutFirst(const T &val) { return cutFirst(_head, val); }
+    Node *cutFirst(const T &val) { return cutFirst(getHeadNode(), val); }
+
+    /** \brief Applies \a func to the value of every node, starting from \a startFrom
+     *
+     *  \a func is invoked as `func(T&)`. Traversal prefetches nodes ahead the same
+     *  way searching methods do.
+     */
+    template<typename Func>
+    void forEach(Node *startFrom, Func func);
+
+    /** \brief Overloaded version of forEach(): visiting the entire list */
+    template<typename Func>
+    void forEach(Func func) { forEach(getHeadNode(), func); }
 
     // this part of code is active only if you'd like to get the highest mark
 #ifdef IWANNAGET10POINTS
@@ -677,17 +961,18 @@ public:
     Node **cutAll(Node *startFrom, const T &val, int &size);
 
     /** \brief Overloaded version of cutAll(): searching in the entire list */
-    Node **cutAll(const T &val, int &size) { return cutAll(_head, val, size); };
+    Node **cutAll(const T &val, int &size) { return cutAll(getHeadNode(), val, size); };
 
 #endif // IWANNAGET10POINTS
 
 public:
     /** \brief Returns a lists's head */
-    Node *getHeadNode() const { return _head; }
+    Node *getHeadNode() const { return loadLink(isReversed() ? _tail : _head); }
 
     /** \brief Returns a pointer to a last node
      *
-     *  If the list is empty, returns nullptr
+     *  If the list is empty, returns nullptr. Unless the policy tracks a tail,
+     *  takes O(n).
      *
      *  <b style='color:orange'>Must be implemented by students</b>
      */
@@ -696,11 +981,205 @@ public:
     /** \brief Returns a size of a list that is equal to a number of storing elements */
     std::size_t getSize();
 
+    /** \brief Returns a node following \a node in the list order, respecting reverse() */
+    Node *getNextNode(const Node *node) const { return nextNode(node, isReversed()); }
+
+    /** \brief Returns a node preceding \a node in the list order, respecting reverse() */
+    Node *getPrevNode(const Node *node) const { return prevNode(node, isReversed()); }
+
+    /** \brief Reverses the order of the list in O(1)
+     *
+     *  Only a direction flag is flipped: the head and the last node swap places,
+     *  and every method and iterator obtained afterwards treats previous links as
+     *  next ones and vice versa. Node::getNext() and Node::getPrev() still return
+     *  raw links, so walk a reversed list by getNextNode() and getPrevNode(). For
+     *  the same reason a chain given to or cut by a reversed list runs along
+     *  previous links. Iterators obtained before the call are invalidated.
+     *
+     *  Available if `Policy::REVERSIBLE` is set.
+     */
+    void reverse()
+    {
+        static_assert(Policy::REVERSIBLE, "reverse() needs Policy::REVERSIBLE");
+        _reversed = !_reversed;
+    }
+
+    /** \brief Returns whether the list order is flipped by reverse() */
+    bool isReversed() const { return Policy::REVERSIBLE && _reversed; }
+
+    /** \brief Reverses the order of the list in O(n) by swapping links of every node
+     *
+     *  Unlike reverse(), works with any policy and leaves raw links agreeing with
+     *  the list order (unless the list is also flipped by reverse()).
+     */
+    void reverseInPlace();
+
+    /** \brief Returns an error of the last failed check, if the policy disables exceptions
+     *
+     *  Like `errno`, a successful call does not reset the error; use resetError().
+     *  Calls failing a check leave the list unchanged and return nullptr, if they
+     *  return a node.
+     */
+    BidiListError getLastError() const { return _lastError; }
+
+    /** \brief Resets an error returned by getLastError() */
+    void resetError() { _lastError = BIDI_LIST_OK; }
+
+    /** \brief Returns an average distance in bytes between addresses of consecutive nodes
+     *
+     *  A freshly built or relinearized list gives a value close to a node allocation
+     *  size; a list scattered over the heap gives a much larger one, which is a signal
+     *  to call relinearize(). Returns 0 for lists of less than two nodes.
+     */
+    double averageLinkDistance() const;
+
+    /** \brief Reallocates all the nodes so that their addresses grow in list order
+     *
+     *  Values are moved to new nodes in the same order, old nodes are freed.
+     *  **All the Node pointers obtained before are invalidated.**
+     */
+    void relinearize();
+
+    /** \brief Relinearizes at most \a budget nodes following the ones relocated by the
+     *  previous call, so that the job can be spread between other work
+     *  \return true if the pass has reached the end of the list; the next call starts
+     *  a new pass from the head
+     *
+     *  Pointers to relocated nodes are invalidated as by relinearize(). Cutting nodes
+     *  restarts the pass from the head, since the remembered position could be cut.
+     */
+    bool relinearizeStep(std::size_t budget);
+
+    /** \brief Returns a number of nodes traversals prefetch ahead */
+    std::size_t getPrefetchDistance() const { return _prefetchDist; }
+
+    /** \brief Sets a number of nodes traversals prefetch ahead; zero disables prefetching */
+    void setPrefetchDistance(std::size_t dist) { _prefetchDist = dist; }
+
 protected:
     /** \brief Method invalidate size cache value until it is calculated again. 
      *  Should be invoked every time a structure of the list is changed
      */
-    void invalidateSize() { _size = NO_SIZE; }
+    void invalidateSize()
+    {
+        if (Policy::TRACK_SIZE)
+            _size = NO_SIZE;
+    }
+
+    /** \brief Reports a failed check of an argument: throws `std::invalid_argument`
+     *  with a given \a code or stores \a err, depending on the policy
+     */
+    void reportError(BidiListError err, const char *code);
+
+    /** \brief Checks \a beg and \a end make a free chain, reporting an error with
+     *  a given \a code otherwise
+     */
+    bool checkChain(Node *beg, Node *end, const char *code);
+
+    /** \brief Links a free chain `[beg, end]` after \a node (after the last node, if
+     *  \a node is nullptr) without any checks and size updates
+     */
+    void linkChainAfter(Node *node, Node *beg, Node *end);
+
+    /** \brief Links a free chain `[beg, end]` before \a node (before the head, if
+     *  \a node is nullptr) without any checks and size updates
+     */
+    void linkChainBefore(Node *node, Node *beg, Node *end);
+
+    /** \brief Creates a free chain of nodes with copies of values of `[first, last)`
+     *  \param end *out* the last node of the chain
+     *  \param count *out* a number of created nodes
+     *  \return the first node of the chain, or nullptr for an empty range
+     *
+     *  If copying a value throws, nodes created so far are deleted.
+     */
+    template<typename InputIt>
+    Node *buildChain(InputIt first, InputIt last, Node *&end, std::size_t &count);
+
+    /** \brief Deletes a free chain starting from \a beg */
+    void deleteChain(Node *beg);
+
+    /** \brief Returns a next node of \a node in the order given by \a rev */
+    static Node *nextNode(const Node *node, bool rev)
+    {
+        return loadLink(Policy::REVERSIBLE && rev ? node->_prev : node->_next);
+    }
+
+    /** \brief Returns a previous node of \a node in the order given by \a rev */
+    static Node *prevNode(const Node *node, bool rev)
+    {
+        return loadLink(Policy::REVERSIBLE && rev ? node->_next : node->_prev);
+    }
+
+    /** \brief Reads a \a link, with acquire semantics if `Policy::RCU_READERS` is set */
+    static Node *loadLink(Node *const &link)
+    {
+        return Policy::RCU_READERS ? __atomic_load_n(&link, __ATOMIC_ACQUIRE) : link;
+    }
+
+    /** \brief Stores \a node to a \a link, with release semantics if
+     *  `Policy::RCU_READERS` is set, so that a reader following the link sees the
+     *  node initialized
+     */
+    static void publishLink(Node *&link, Node *node)
+    {
+        if (Policy::RCU_READERS)
+            __atomic_store_n(&link, node, __ATOMIC_RELEASE);
+        else
+            link = node;
+    }
+
+    /** \brief Returns a link of \a node to the next node in the list order */
+    Node *&nextOf(Node *node) const { return isReversed() ? node->_prev : node->_next; }
+
+    /** \brief Returns a link of \a node to the previous node in the list order */
+    Node *&prevOf(Node *node) const { return isReversed() ? node->_next : node->_prev; }
+
+    /** \brief Returns a pointer to the first node in the list order */
+    Node *&headRef() { return isReversed() ? _tail : _head; }
+
+    /** \brief Returns a pointer to the last node in the list order */
+    Node *&tailRef() { return isReversed() ? _head : _tail; }
+
+    /** \brief Returns whether \a node carries \a val, whose tag is \a tag; compares
+     *  values only if the tags match
+     */
+    static bool carries(const Node *node, const T &val, std::size_t tag)
+    {
+        return node->tagMatches(tag) && node->_val == val;
+    }
+
+    /** \brief Gives \a node a new value \a val with no hits, as a fresh node has */
+    static void renewNode(Node *node, const T &val)
+    {
+        node->setValue(val);
+        node->resetHits();
+    }
+
+    /** \brief Moves a node found by findFirst() according to `Policy::SELF_ORGANIZATION` */
+    void selfOrganize(Node *node);
+
+    /** \brief Returns a free node carrying \a val, taken from the node cache if possible */
+    Node *acquireNode(const T &val);
+
+    /** \brief Takes a node unlinked from the list to the node cache, or deletes it
+     *  if the cache is full; the node's links may be stale
+     */
+    void recycleNode(Node *node);
+
+    /** \brief Adds \a count to a calculated size */
+    void growSize(std::size_t count)
+    {
+        if (Policy::TRACK_SIZE && _size != NO_SIZE)
+            _size += count;
+    }
+
+    /** \brief Subtracts \a count from a calculated size */
+    void shrinkSize(std::size_t count)
+    {
+        if (Policy::TRACK_SIZE && _size != NO_SIZE)
+            _size -= count;
+    }
 
     /** \brief (Re)calculate size of the list 
      *
@@ -708,6 +1187,25 @@ protected:
      */
     void calculateSize();
 
+    /** \brief Visits nodes from \a startFrom on until \a visit returns true
+     *  \return a node \a visit has stopped on or nullptr if the chain is exhausted
+     *
+     *  A runner pointer is kept `_prefetchDist` nodes ahead of the visited node and
+     *  the node it points to is prefetched, so cache misses on scattered nodes overlap
+     *  with visiting. The next link is read before \a visit is invoked, thus
+     *  \a visit may delete the node it is given.
+     */
+    template<typename Visitor>
+    Node *traverse(Node *startFrom, Visitor visit) const;
+
+    /** \brief Hints a processor to bring a node into cache */
+    static void prefetch(const Node *node)
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(node);
+#endif
+    }
+
 protected:
     /** \brief Pointer to a first element of a list
      *
@@ -724,6 +1222,27 @@ protected:
     /** \brief Caches a size of a list. If no size has been calculated, stores NO_SIZE value */
     std::size_t _size;
 
+    /** \brief Number of nodes traversals prefetch ahead */
+    std::size_t _prefetchDist;
+
+    /** \brief First node to be relocated by relinearizeStep(); nullptr for the head */
+    Node *_relinCursor;
+
+    /** \brief Error of the last failed check, see getLastError() */
+    BidiListError _lastError;
+
+    /** \brief Nodes kept for reuse, chained by next links */
+    Node *_nodeCache;
+
+    /** \brief Number of nodes in _nodeCache */
+    std::size_t _cachedNodes;
+
+    /** \brief Whether the list order is flipped, see reverse() */
+    bool _reversed;
+
+    /** \brief Node found last, see findNear() */
+    Node *_finger;
+
 }; // class BidiList 
 
 
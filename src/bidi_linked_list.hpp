@@ -12,7 +12,11 @@
 /// When altering code, a copyright line must be preserved.
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>    // sort
+#include <functional>   // less
 #include <stdexcept>
+#include <utility>      // move
+#include <vector>
 
 
 
@@ -21,9 +25,9 @@
 //==============================================================================
 
 
-template<typename T>
-typename BidiLinkedList<T>::Node *
-BidiLinkedList<T>::Node::insertAfterInternal(Node *insNode)
+template<typename T, typename Policy>
+typename BidiLinkedList<T, Policy>::Node *
+BidiLinkedList<T, Policy>::Node::insertAfterInternal(Node *insNode)
 {
     if (insNode == nullptr || this == nullptr)
         return nullptr;
@@ -48,121 +52,562 @@ BidiLinkedList<T>::Node::insertAfterInternal(Node *insNode)
 
 
 
-template<typename T>
-BidiLinkedList<T>::~BidiLinkedList()
+template<typename T, typename Policy>
+BidiLinkedList<T, Policy>::~BidiLinkedList()
 {
     clear();
 }
 
 
-template<typename T>
-void BidiLinkedList<T>::clear()
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::clear()
 {
-    Node *specialfordelite = _head;
-    while (specialfordelite != nullptr)
+    // traverse() reads a next link before visiting, so a visited node can be deleted
+    traverse(getHeadNode(), [](Node *killhim) { delete killhim; return false; });
+
+    _head = nullptr;
+    _tail = nullptr;
+    _relinCursor = nullptr;
+    _finger = nullptr;
+    invalidateSize();
+
+    while (_nodeCache != nullptr)
     {
-        Node *killhim = specialfordelite;
-        specialfordelite = specialfordelite->_next;
-        delete killhim;
+        Node *next = _nodeCache->_next;
+        delete _nodeCache;
+        _nodeCache = next;
     }
-
+    _cachedNodes = 0;
 }
 
-template<typename T>
-size_t BidiLinkedList<T>::getSize()
+template<typename T, typename Policy>
+size_t BidiLinkedList<T, Policy>::getSize()
 {
+    if (!Policy::TRACK_SIZE)
+    {
+        std::size_t size = 0;
+        traverse(getHeadNode(), [&size](Node *) { ++size; return false; });
+        return size;
+    }
+
     if (_size == NO_SIZE)
         calculateSize();
     return _size;
 }
 
 
-template<typename T>
-void BidiLinkedList<T>::calculateSize()
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::reportError(BidiListError err, const char *code)
+{
+    if (Policy::USE_EXCEPTIONS)
+        throw std::invalid_argument(code);
+
+    _lastError = err;
+}
+
+
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::calculateSize()
+{
+    std::size_t size = 0;
+    traverse(getHeadNode(), [&size](Node *) { ++size; return false; });
+    _size = size;
+}
+
+
+template<typename T, typename Policy>
+template<typename Visitor>
+typename BidiLinkedList<T, Policy>::Node *
+BidiLinkedList<T, Policy>::traverse(Node *startFrom, Visitor visit) const
+{
+    // with no runner there is nothing to prefetch or to load twice
+    if (_prefetchDist == 0)
+    {
+        for (Node *node = startFrom; node != nullptr; )
+        {
+            Node *next = loadLink(nextOf(node));
+            if (visit(node))
+                return node;
+
+            node = next;
+        }
+
+        return nullptr;
+    }
+
+    Node *ahead = startFrom;
+    for (std::size_t i = 0; i < _prefetchDist && ahead != nullptr; ++i)
+        ahead = loadLink(nextOf(ahead));
+
+    Node *node = startFrom;
+    while (node != nullptr)
+    {
+        if (ahead != nullptr)
+        {
+            prefetch(ahead);
+            ahead = loadLink(nextOf(ahead));
+        }
+
+        Node *next = loadLink(nextOf(node));
+        if (visit(node))
+            return node;
+
+        node = next;
+    }
+
+    return nullptr;
+}
+
+
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::reverseInPlace()
 {
-    _size = 0;
     Node *node = _head;
     while (node != nullptr)
     {
-        node = node->_next;
-        _size++;
+        Node *next = node->_next;
+        std::swap(node->_next, node->_prev);
+        _tail = node;
+        node = next;
     }
+
+    std::swap(_head, _tail);
+    if (!Policy::TRACK_TAIL)
+        _tail = nullptr;
+
+    // the pass would go on backwards
+    _relinCursor = nullptr;
 }
 
 
-template<typename T>
-typename BidiLinkedList<T>::Node *
-BidiLinkedList<T>::getLastNode() const
+template<typename T, typename Policy>
+double BidiLinkedList<T, Policy>::averageLinkDistance() const
 {
-    return _tail;
+    if (_head == nullptr || _head->_next == nullptr)
+        return 0;
+
+    double total = 0;
+    std::size_t links = 0;
+    for (Node *node = _head; node->_next != nullptr; node = node->_next)
+    {
+        const char *a = reinterpret_cast<const char *>(node);
+        const char *b = reinterpret_cast<const char *>(node->_next);
+        total += (double) (a < b ? b - a : a - b);
+        ++links;
+    }
+
+    return total / (double) links;
 }
 
 
-template<typename T>
-typename BidiLinkedList<T>::Node *
-BidiLinkedList<T>::appendEl(const T &val)
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::relinearize()
 {
-    Node *newNode = new Node(val);
-    insertNodeAfter(getLastNode(), newNode);
-    _tail = newNode;
+    _relinCursor = nullptr;
+    relinearizeStep(getSize());
+}
+
+
+template<typename T, typename Policy>
+bool BidiLinkedList<T, Policy>::relinearizeStep(std::size_t budget)
+{
+    Node *beg = _relinCursor ? _relinCursor : _head;
+    if (beg == nullptr || budget == 0)
+        return beg == nullptr;
+
+    // collect old nodes of the segment
+    std::vector<Node *> oldNodes;
+    for (Node *node = beg; node != nullptr && oldNodes.size() < budget; node = node->_next)
+        oldNodes.push_back(node);
+    std::size_t count = oldNodes.size();
+
+    Node *before = oldNodes[0]->_prev;
+    Node *after = oldNodes[count - 1]->_next;
+
+    // fresh nodes are allocated in a row and ordered by address, so a traversal
+    // walks memory forwards no matter how the allocator has placed them; all of
+    // them are there before the list is touched
+    std::vector<Node *> newNodes;
+    newNodes.reserve(count);
+    try
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            newNodes.push_back(new Node());
+    }
+    catch (...)
+    {
+        for (std::size_t i = 0; i < newNodes.size(); ++i)
+            delete newNodes[i];
+        throw;
+    }
+    std::sort(newNodes.begin(), newNodes.end(), std::less<Node *>());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Node *node = newNodes[i];
+        node->_val = std::move(oldNodes[i]->_val);
+        node->copyTag(*oldNodes[i]);
+        node->copyHits(*oldNodes[i]);
+        node->_prev = i > 0 ? newNodes[i - 1] : before;
+        node->_next = i + 1 < count ? newNodes[i + 1] : after;
+        delete oldNodes[i];
+    }
+
+    if (before)
+        before->_next = newNodes[0];
+    else
+        _head = newNodes[0];
+
+    if (after)
+        after->_prev = newNodes[count - 1];
+    else if (Policy::TRACK_TAIL)
+        _tail = newNodes[count - 1];
+
+    // the finger could be relocated
+    _finger = nullptr;
+
+    _relinCursor = after;
+    return after == nullptr;
+}
+
+
+template<typename T, typename Policy>
+typename BidiLinkedList<T, Policy>::Node *
+BidiLinkedList<T, Policy>::getLastNode() const
+{
+    if (Policy::TRACK_TAIL)
+        return loadLink(isReversed() ? _head : _tail);
+
+    Node *node = loadLink(_head);
+    if (node)
+        while (Node *next = loadLink(node->_next))
+            node = next;
+    return node;
+}
+
+
+template<typename T, typename Policy>
+typename BidiLinkedList<T, Policy>::Node *
+BidiLinkedList<T, Policy>::appendEl(const T &val)
+{
+    // a fresh node needs no checks
+    Node *newNode = acquireNode(val);
+    linkChainAfter(nullptr, newNode, newNode);
+    growSize(1);
     return newNode;
 
 }
 
 // возможно, этот метод даже не надо изменять
-template<typename T>
-typename BidiLinkedList<T>::Node *
-BidiLinkedList<T>::insertNodeAfter(Node *node, Node *insNode)
+template<typename T, typename Policy>
+typename BidiLinkedList<T, Policy>::Node *
+BidiLinkedList<T, Policy>::insertNodeAfter(Node *node, Node *insNode)
 {
-    if (insNode == nullptr || insNode->_next != nullptr || insNode->_prev != nullptr)
-        throw std::invalid_argument("INA NP");
+    if (Policy::CHECKED)
+    {
+        if (insNode == nullptr)
+        {
+            reportError(BIDI_LIST_NULL_NODE, "INA NP");
+            return nullptr;
+        }
+        if (insNode->_next != nullptr || insNode->_prev != nullptr)
+        {
+            reportError(BIDI_LIST_NODE_NOT_FREE, "INA NP");
+            return nullptr;
+        }
+    }
+
+    linkChainAfter(node, insNode, insNode);
+    invalidateSize();
+    return insNode;
+}
+
+template<typename T, typename Policy>
+void
+BidiLinkedList<T, Policy>::insertNodesAfter(BidiLinkedList::Node *node, BidiLinkedList::Node *beg, BidiLinkedList::Node *end)
+{
+    if (Policy::CHECKED && !checkChain(beg, end, "INA"))
+        return;
+
+    linkChainAfter(node, beg, end);
+    invalidateSize();
+}
+
+
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::insertNodesAfter(Node *node, Node *beg, Node *end, std::size_t count)
+{
+    if (Policy::CHECKED && !checkChain(beg, end, "INA"))
+        return;
+
+    linkChainAfter(node, beg, end);
+    growSize(count);
+}
+
 
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::linkChainAfter(Node *node, Node *beg, Node *end)
+{
     if (node == nullptr)
         node = getLastNode();
 
+    // links of the chain are set before it is published, see Policy::RCU_READERS
     if (node == nullptr)
     {
-        _head = insNode;
-        _tail = insNode;
+        publishLink(headRef(), beg);
+        if (Policy::TRACK_TAIL)
+            publishLink(tailRef(), end);
+    } else if (nextOf(node) == nullptr)
+    {
+        prevOf(beg) = node;
+        publishLink(nextOf(node), beg);
+        if (Policy::TRACK_TAIL)
+            publishLink(tailRef(), end);
     } else
     {
-        node->insertAfterInternal(insNode);
-        if (insNode->_next == nullptr)
-            _tail = insNode;
+        nextOf(end) = nextOf(node);
+        prevOf(beg) = node;
+        publishLink(prevOf(nextOf(node)), end);
+        publishLink(nextOf(node), beg);
     }
+}
 
-    invalidateSize();
-    return insNode;
+
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::linkChainBefore(Node *node, Node *beg, Node *end)
+{
+    if (node == nullptr)
+        node = getHeadNode();
+
+    if (node == nullptr)
+    {
+        publishLink(headRef(), beg);
+        if (Policy::TRACK_TAIL)
+            publishLink(tailRef(), end);
+    } else if (prevOf(node) == nullptr)
+    {
+        nextOf(end) = node;
+        publishLink(prevOf(node), end);
+        publishLink(headRef(), beg);
+    } else
+    {
+        nextOf(end) = node;
+        prevOf(beg) = prevOf(node);
+        publishLink(nextOf(prevOf(node)), beg);
+        publishLink(prevOf(node), end);
+    }
 }
 
-template<typename T>
-void
-BidiLinkedList<T>::insertNodesAfter(BidiLinkedList::Node *node, BidiLinkedList::Node *beg, BidiLinkedList::Node *end)
+
+template<typename T, typename Policy>
+template<typename InputIt>
+typename BidiLinkedList<T, Policy>::Node *
+BidiLinkedList<T, Policy>::buildChain(InputIt first, InputIt last, Node *&end, std::size_t &count)
 {
-    if (beg == nullptr || end == nullptr || beg->_prev != nullptr || end->_next != nullptr)
+    Node *beg = nullptr;
+    end = nullptr;
+    count = 0;
+    try
     {
-        throw std::invalid_argument("INA");
+        for (; first != last; ++first)
+        {
+            Node *node = new Node(*first);
+            if (end)
+            {
+                nextOf(end) = node;
+                prevOf(node) = end;
+            } else
+                beg = node;
+
+            end = node;
+            ++count;
+        }
+    }
+    catch (...)
+    {
+        deleteChain(beg);
+        throw;
     }
 
-    if (node == nullptr)
-        node = getLastNode();
+    return beg;
+}
 
-    if (node == nullptr)
+
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::deleteChain(Node *beg)
+{
+    while (beg != nullptr)
     {
-        _head = beg;
-        _tail = end;
-    } else if (node->_next == nullptr)
+        Node *next = nextOf(beg);
+        delete beg;
+        beg = next;
+    }
+}
+
+
+template<typename T, typename Policy>
+template<typename InputIt>
+typename BidiLinkedList<T, Policy>::Node *
+BidiLinkedList<T, Policy>::insertRangeAfter(Node *node, InputIt first, InputIt last)
+{
+    Node *end;
+    std::size_t count;
+    Node *beg = buildChain(first, last, end, count);
+    if (beg == nullptr)
+        return nullptr;
+
+    // the chain is private, so it needs no checks
+    linkChainAfter(node, beg, end);
+    growSize(count);
+
+    return beg;
+}
+
+
+template<typename T, typename Policy>
+template<typename InputIt>
+void BidiLinkedList<T, Policy>::assign(InputIt first, InputIt last)
+{
+    // reuse existing nodes first
+    Node *node = headRef();
+    std::size_t count = 0;
+    for (; node != nullptr && first != last; node = nextOf(node), ++first, ++count)
+        renewNode(node, *first);
+
+    if (node != nullptr)
     {
-        node->_next = beg;
-        beg->_prev = node;
-        _tail = end;
+        // the list is longer than the range: drop the rest
+        if (node == headRef())
+            clear();
+        else
+        {
+            cutNodes(node, getLastNode());
+            deleteChain(node);
+        }
     } else
     {
-        end->_next = node->_next;
-        beg->_prev = node;
-        node->_next->_prev = end;
-        node->_next = beg;
+        Node *end;
+        std::size_t added;
+        Node *beg = buildChain(first, last, end, added);
+        if (beg != nullptr)
+            linkChainAfter(nullptr, beg, end);
+        count += added;
+    }
+
+    // every node has been visited, so the size is known regardless of the cache
+    if (Policy::TRACK_SIZE)
+        _size = count;
+}
+
+
+template<typename T, typename Policy>
+typename BidiLinkedList<T, Policy>::Node *
+BidiLinkedList<T, Policy>::acquireNode(const T &val)
+{
+    if (_nodeCache == nullptr)
+        return new Node(val);
+
+    Node *node = _nodeCache;
+    _nodeCache = node->_next;
+    --_cachedNodes;
+
+    node->_next = nullptr;
+    renewNode(node, val);
+    return node;
+}
+
+
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::recycleNode(Node *node)
+{
+    if (_cachedNodes >= Policy::NODE_CACHE_SIZE)
+    {
+        delete node;
+        return;
+    }
+
+    node->_prev = nullptr;
+    node->_next = _nodeCache;
+    _nodeCache = node;
+    ++_cachedNodes;
+}
+
+
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::pushFront(const T &val)
+{
+    Node *node = acquireNode(val);
+    linkChainBefore(nullptr, node, node);
+    growSize(1);
+}
+
+
+template<typename T, typename Policy>
+T BidiLinkedList<T, Policy>::popFront()
+{
+    T val;
+    if (popFrontN(&val, 1) == 0 && Policy::CHECKED)
+        reportError(BIDI_LIST_EMPTY, "PF E");
+
+    return val;
+}
+
+
+template<typename T, typename Policy>
+T BidiLinkedList<T, Policy>::popBack()
+{
+    Node *node = getLastNode();
+    if (Policy::CHECKED && node == nullptr)
+    {
+        reportError(BIDI_LIST_EMPTY, "PB E");
+        return T();
     }
+
+    if (prevOf(node))
+        nextOf(prevOf(node)) = nullptr;
+    else
+        headRef() = nullptr;
+    if (Policy::TRACK_TAIL)
+        tailRef() = prevOf(node);
+    if (_relinCursor == node)
+        _relinCursor = nullptr;
+    if (_finger == node)
+        _finger = nullptr;
+    shrinkSize(1);
+
+    T val = std::move(node->_val);
+    recycleNode(node);
+    return val;
+}
+
+
+template<typename T, typename Policy>
+std::size_t BidiLinkedList<T, Policy>::popFrontN(T *out, std::size_t n)
+{
+    std::size_t popped = 0;
+    Node *node = headRef();
+    while (node != nullptr && popped < n)
+    {
+        Node *next = nextOf(node);
+        if (_relinCursor == node)
+            _relinCursor = nullptr;
+        if (_finger == node)
+            _finger = nullptr;
+
+        out[popped++] = std::move(node->_val);
+        recycleNode(node);
+        node = next;
+    }
+
+    // links are fixed once for the whole chain
+    headRef() = node;
+    if (node)
+        prevOf(node) = nullptr;
+    else if (Policy::TRACK_TAIL)
+        tailRef() = nullptr;
+    shrinkSize(popped);
+
+    return popped;
 }
 
 
@@ -170,155 +615,267 @@ BidiLinkedList<T>::insertNodesAfter(BidiLinkedList::Node *node, BidiLinkedList::
 // макрос IWANNAGET10POINTS, взяв тем самым на себя повышенные обязательства
 #ifdef IWANNAGET10POINTS
 
-template<typename T>
-typename BidiLinkedList<T>::Node *BidiLinkedList<T>::insertNodeBefore(Node *node, Node *insNode)
+template<typename T, typename Policy>
+typename BidiLinkedList<T, Policy>::Node *BidiLinkedList<T, Policy>::insertNodeBefore(Node *node, Node *insNode)
 {
+    // without exceptions, a failure is to be told by the result
+    if (Policy::CHECKED && !Policy::USE_EXCEPTIONS && !checkChain(insNode, insNode, "INB"))
+        return nullptr;
+
     insertNodesBefore(node, insNode, insNode);
     return insNode;
 }
 
 
-template<typename T>
-void BidiLinkedList<T>::insertNodesBefore(Node *node, Node *beg, Node *end)
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::insertNodesBefore(Node *node, Node *beg, Node *end)
 {
-    if (beg == nullptr || end == nullptr || beg->_prev != nullptr || end->_next != nullptr)
-        throw std::invalid_argument("INB");
+    if (Policy::CHECKED && !checkChain(beg, end, "INB"))
+        return;
 
-    if (node == nullptr)
-        node = getHeadNode();
-
-    if (node == nullptr)
-    {
-        _head = beg;
-        _tail = end;
-    } else if (node->_prev == nullptr)
-    {
-        node->_prev = end;
-        end->_next = node;
-        _head = beg;
-    } else
-    {
-        end->_next = node;
-        beg->_prev = node->_prev;
-        node->_prev->_next = beg;
-        node->_prev = end;
-    }
+    linkChainBefore(node, beg, end);
     invalidateSize();
 }
 
 
+
 #endif // IWANNAGET10POINTS
 
 
-template<typename T>
-void BidiLinkedList<T>::cutNodes(Node *beg, Node *end)
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::cutNodes(Node *beg, Node *end)
 {
-    if (beg == nullptr || end == nullptr)
-        throw std::invalid_argument("CNS");
+    if (Policy::CHECKED && (beg == nullptr || end == nullptr))
+    {
+        reportError(BIDI_LIST_NULL_NODE, "CNS");
+        return;
+    }
 
-    if (end->_next == nullptr && beg->_prev == nullptr)
+    if (nextOf(end) == nullptr && prevOf(beg) == nullptr)
     {
-        _head = nullptr;
-        _tail = nullptr;
-    } else if (end->_next == nullptr)
+        publishLink(headRef(), nullptr);
+        if (Policy::TRACK_TAIL)
+            publishLink(tailRef(), nullptr);
+    } else if (nextOf(end) == nullptr)
     {
-        _tail = beg->_prev;
-        beg->_prev->_next = nullptr;
-        beg->_prev = nullptr;
-    } else if (beg->_prev == nullptr)
+        if (Policy::TRACK_TAIL)
+            publishLink(tailRef(), prevOf(beg));
+        publishLink(nextOf(prevOf(beg)), nullptr);
+    } else if (prevOf(beg) == nullptr)
     {
-        _head = end->_next;
-        end->_next->_prev = nullptr;
-        end->_next = nullptr;
+        publishLink(headRef(), nextOf(end));
+        publishLink(prevOf(nextOf(end)), nullptr);
     } else
     {
-        beg->_prev->_next = end->_next;
-        end->_next->_prev = beg->_prev;
-        beg->_prev = nullptr;
-        end->_next = nullptr;
+        publishLink(nextOf(prevOf(beg)), nextOf(end));
+        publishLink(prevOf(nextOf(end)), prevOf(beg));
+    }
+
+    // readers standing on the chain go on along its outer links
+    if (!Policy::RCU_READERS)
+    {
+        prevOf(beg) = nullptr;
+        nextOf(end) = nullptr;
     }
+    _relinCursor = nullptr;
+    // membership of the finger in a longer chain would take O(n) to check
+    if (beg != end || beg == _finger)
+        _finger = nullptr;
     invalidateSize();
 }
 
 
-template<typename T>
-typename BidiLinkedList<T>::Node *
-BidiLinkedList<T>::cutNode(Node *node)
+template<typename T, typename Policy>
+typename BidiLinkedList<T, Policy>::Node *
+BidiLinkedList<T, Policy>::cutNode(Node *node)
 {
     cutNodes(node, node);
     return node;
 }
 
 
-template<typename T>
-typename BidiLinkedList<T>::Node *
-BidiLinkedList<T>::findFirst(Node *startFrom, const T &val)
+template<typename T, typename Policy>
+bool BidiLinkedList<T, Policy>::checkChain(Node *beg, Node *end, const char *code)
 {
-    if (startFrom == nullptr)
-        return nullptr;
-    Node *findfirst = startFrom;
-    while (findfirst != nullptr)
+    if (beg == nullptr || end == nullptr)
+    {
+        reportError(BIDI_LIST_NULL_NODE, code);
+        return false;
+    }
+    if (prevOf(beg) != nullptr || nextOf(end) != nullptr)
     {
-        if (findfirst->getValue() == val)
-            return findfirst;
+        reportError(BIDI_LIST_NODE_NOT_FREE, code);
+        return false;
+    }
+
+    return true;
+}
+
+
+template<typename T, typename Policy>
+typename BidiLinkedList<T, Policy>::Node *
+BidiLinkedList<T, Policy>::findFirst(Node *startFrom, const T &val)
+{
+    std::size_t tag = Node::tagOf(val);
+    Node *res = traverse(startFrom, [&val, tag](Node *node) { return carries(node, val, tag); });
+    if (res == nullptr)
+        return nullptr;
+
+    _finger = res;
+    if (Policy::SELF_ORGANIZATION != BIDI_SELF_ORG_NONE)
+        selfOrganize(res);
+
+    return res;
+}
+
+
+template<typename T, typename Policy>
+typename BidiLinkedList<T, Policy>::Node *
+BidiLinkedList<T, Policy>::findNear(const T &val)
+{
+    if (_finger == nullptr)
+        return findFirst(val);
+
+    std::size_t tag = Node::tagOf(val);
+    if (carries(_finger, val, tag))
+        return _finger;
 
-        findfirst = findfirst->_next;
+    Node *back = prevOf(_finger);
+    Node *fwd = nextOf(_finger);
+    while (back != nullptr || fwd != nullptr)
+    {
+        if (fwd != nullptr)
+        {
+            if (carries(fwd, val, tag))
+                return _finger = fwd;
+            fwd = nextOf(fwd);
+        }
+        if (back != nullptr)
+        {
+            if (carries(back, val, tag))
+                return _finger = back;
+            back = prevOf(back);
+        }
     }
 
     return nullptr;
 }
 
 
-template<typename T>
-typename BidiLinkedList<T>::Node **
-BidiLinkedList<T>::findAll(Node *startFrom, const T &val, int &size)
+template<typename T, typename Policy>
+void BidiLinkedList<T, Policy>::selfOrganize(Node *node)
+{
+    // a node to move the found one before
+    Node *dest = nullptr;
+    switch (Policy::SELF_ORGANIZATION)
+    {
+    case BIDI_MOVE_TO_FRONT:
+        dest = getHeadNode();
+        break;
+
+    case BIDI_TRANSPOSE:
+        dest = prevOf(node);
+        break;
+
+    case BIDI_FREQUENCY_COUNT:
+        node->hit();
+        for (Node *prev = prevOf(node); prev != nullptr && prev->getHits() < node->getHits();
+             prev = prevOf(prev))
+            dest = prev;
+        break;
+
+    default:
+        return;
+    }
+
+    if (dest == nullptr || dest == node)
+        return;
+
+    // the node has a predecessor, since dest precedes it
+    Node *prev = prevOf(node);
+    Node *next = nextOf(node);
+    nextOf(prev) = next;
+    if (next != nullptr)
+        prevOf(next) = prev;
+    else if (Policy::TRACK_TAIL)
+        tailRef() = prev;
+
+    prevOf(node) = nullptr;
+    nextOf(node) = nullptr;
+    linkChainBefore(dest, node, node);
+}
+
+
+template<typename T, typename Policy>
+typename BidiLinkedList<T, Policy>::Node **
+BidiLinkedList<T, Policy>::findAll(Node *startFrom, const T &val, int &size)
 {
     if (!startFrom)
         return nullptr;
     // try not to use any standard containers. create an array only when found a first occurence
-    Node **res = nullptr;
-    size = 0;
-    Node *letsfind = startFrom;
-    while (startFrom)
+    int found = 0;
+    std::size_t tag = Node::tagOf(val);
+    traverse(startFrom, [&val, tag, &found](Node *node)
     {
-        if (startFrom->getValue() == val)
-            size++;
+        if (carries(node, val, tag))
+            ++found;
+        return false;
+    });
 
-        startFrom = startFrom->_next;
-    }
-
-    if (size == 0)
+    size = found;
+    if (found == 0)
         return nullptr;
-    else
-        res = new Node *[size];
 
+    Node **res = new Node *[found];
     int i = 0;
+    traverse(startFrom, [&val, tag, res, &i](Node *node)
+    {
+        if (carries(node, val, tag))
+            res[i++] = node;
+        return false;
+    });
+
+    return res;
+}
 
-    if (res)
+
+template<typename T, typename Policy>
+std::size_t BidiLinkedList<T, Policy>::count(const T &val)
+{
+    std::size_t res = 0;
+    std::size_t tag = Node::tagOf(val);
+    traverse(getHeadNode(), [&val, tag, &res](Node *node)
     {
-        while (letsfind)
-        {
-            if (letsfind->getValue() == val)
-            {
-                res[i] = letsfind;
-                i++;
-            }
-            letsfind = letsfind->_next;
-        }
-    }
+        if (carries(node, val, tag))
+            ++res;
+        return false;
+    });
 
     return res;
 }
 
 
+template<typename T, typename Policy>
+template<typename Func>
+void BidiLinkedList<T, Policy>::forEach(Node *startFrom, Func func)
+{
+    traverse(startFrom, [&func](Node *node)
+    {
+        func(node->_val);
+        node->retag(node->_val);      // func may change the value
+        return false;
+    });
+}
+
+
 
 // Следующий фрагмент кода перестанет быть "блеклым" и станет "ярким", как только вы определите
 // макрос IWANNAGET10POINTS, взяв тем самым на себя повышенные обязательства
 #ifdef IWANNAGET10POINTS
 
-template<typename T>
-typename BidiLinkedList<T>::Node **
-BidiLinkedList<T>::cutAll(Node *startFrom, const T &val, int &size)
+template<typename T, typename Policy>
+typename BidiLinkedList<T, Policy>::Node **
+BidiLinkedList<T, Policy>::cutAll(Node *startFrom, const T &val, int &size)
 {
     Node **letskillhim = findAll(startFrom, val, size);
     int i = 0;
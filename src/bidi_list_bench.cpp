@@ -0,0 +1,1871 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Defines the entry point for the benchmark application.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+/// Usage: `bidi_list_bench [name [maxMB]]`. Without a name all the benchmarks
+/// are run; `maxMB` limits the biggest workload (64 MB by default).
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "append_only_bidi_list.h"
+#include "augmented_bidi_list.h"
+#include "bidi_blocking_queue.h"
+#include "bidi_linked_list.h"
+#include "bidi_mpsc_queue.h"
+#include "bidi_small_list.h"
+#include "bidi_soa_list.h"
+#include "concurrent_bidi_list.h"
+#include "flat_combining_bidi_list.h"
+#include "lockfree_bidi_list.h"
+#include "parallel_bidi_list.h"
+#include "rcu_bidi_list.h"
+#include "simd_search.h"
+#include "staged_bidi_list.h"
+
+
+/** \brief Type alias for a list of 64-bit integers. */
+typedef BidiLinkedList<int64_t> Int64List;
+
+
+/** \brief Number of calls of the global operator new, see benchSmallList() */
+static std::size_t allocCount = 0;
+
+void *operator new(std::size_t size)
+{
+    ++allocCount;
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+/** \brief Runs \a func once and returns elapsed time in seconds */
+template<typename Func>
+double measureSec(Func func)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+
+/** \brief Keeps the compiler from throwing away a computed value */
+template<typename V>
+void doNotOptimize(const V &val)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(val) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &val;
+#endif
+}
+
+
+/** \brief Fills \a lst with \a count values; if \a shuffled is set, nodes are linked
+ *  in a random order of their addresses, as after a long insert/cut churn
+ */
+void buildList(Int64List &lst, std::size_t count, bool shuffled)
+{
+    std::vector<Int64List::Node *> nodes(count);
+    for (std::size_t i = 0; i < count; ++i)
+        nodes[i] = new Int64List::Node((int64_t) i);
+
+    if (shuffled)
+        std::shuffle(nodes.begin(), nodes.end(), std::mt19937_64(count));
+
+    for (std::size_t i = 0; i < count; ++i)
+        lst.insertNodeAfter(nullptr, nodes[i]);
+}
+
+
+//==============================================================================
+// Benchmarks
+//==============================================================================
+
+
+/** \brief Full scans (findFirst for a missing value) over lists growing from
+ *  L1-resident to \a maxBytes, for sequential and shuffled node addresses and
+ *  several prefetch distances
+ */
+void benchPrefetch(std::size_t maxBytes)
+{
+    static const std::size_t DISTANCES[] = { 0, 2, 4, 8, 16 };
+    static const std::size_t DIST_NUM = sizeof(DISTANCES) / sizeof(DISTANCES[0]);
+
+    std::printf("%12s %10s", "bytes", "order");
+    for (std::size_t d = 0; d < DIST_NUM; ++d)
+        std::printf("   dist=%-2zu", DISTANCES[d]);
+    std::printf("   (ns/node)\n");
+
+    for (std::size_t bytes = 16 * 1024; bytes <= maxBytes; bytes *= 4)
+    {
+        std::size_t count = bytes / sizeof(Int64List::Node);
+        for (int shuffled = 0; shuffled < 2; ++shuffled)
+        {
+            Int64List lst;
+            buildList(lst, count, shuffled != 0);
+
+            // repeat small lists so that every measurement covers ~16M nodes
+            std::size_t reps = std::max<std::size_t>(1, (16u << 20) / count);
+            std::printf("%12zu %10s", bytes, shuffled ? "shuffled" : "sequential");
+            for (std::size_t d = 0; d < DIST_NUM; ++d)
+            {
+                lst.setPrefetchDistance(DISTANCES[d]);
+                double sec = measureSec([&lst, reps]()
+                {
+                    for (std::size_t r = 0; r < reps; ++r)
+                        doNotOptimize(lst.findFirst(-1));
+                });
+                std::printf("   %7.2f", sec * 1e9 / (double) (count * reps));
+            }
+            std::printf("\n");
+        }
+    }
+}
+
+
+/** \brief Scan speed and link distance of shuffled lists before and after
+ *  relinearize(), along with a cost of relinearizing
+ */
+void benchRelinearize(std::size_t maxBytes)
+{
+    std::printf("%12s %14s %14s %12s %12s %12s\n", "bytes", "dist before", "dist after",
+                "scan before", "scan after", "relin");
+    std::printf("%12s %14s %14s %12s %12s %12s\n", "", "(bytes)", "(bytes)",
+                "(ns/node)", "(ns/node)", "(ns/node)");
+
+    for (std::size_t bytes = 1024 * 1024; bytes <= maxBytes; bytes *= 4)
+    {
+        std::size_t count = bytes / sizeof(Int64List::Node);
+        Int64List lst;
+        buildList(lst, count, true);
+
+        double distBefore = lst.averageLinkDistance();
+        double scanBefore = measureSec([&lst]() { doNotOptimize(lst.findFirst(-1)); });
+        double relin = measureSec([&lst]() { lst.relinearize(); });
+        double distAfter = lst.averageLinkDistance();
+        double scanAfter = measureSec([&lst]() { doNotOptimize(lst.findFirst(-1)); });
+
+        std::printf("%12zu %14.0f %14.0f %12.2f %12.2f %12.2f\n", bytes, distBefore, distAfter,
+                    scanBefore * 1e9 / (double) count, scanAfter * 1e9 / (double) count,
+                    relin * 1e9 / (double) count);
+    }
+}
+
+
+/** \brief Throughput of SimdSearch kernels on every supported level against
+ *  the scalar findFirst() over a sequentially allocated list
+ */
+void benchSimd(std::size_t maxBytes)
+{
+    static const char *LEVEL_NAMES[] = { "scalar", "sse4.2", "avx2", "avx512" };
+    SimdLevel best = simdDetectLevel();
+
+    std::printf("%12s %12s", "bytes", "list");
+    for (int lvl = SIMD_SCALAR; lvl <= best; ++lvl)
+        std::printf(" %12s", LEVEL_NAMES[lvl]);
+    std::printf("   (GB/s of int64 values, findFirst of a missing value)\n");
+
+    for (std::size_t bytes = 16 * 1024; bytes <= maxBytes; bytes *= 4)
+    {
+        std::size_t count = bytes / sizeof(int64_t);
+        std::size_t reps = std::max<std::size_t>(1, (256u << 20) / bytes);
+        std::vector<int64_t> data(count);
+        for (std::size_t i = 0; i < count; ++i)
+            data[i] = (int64_t) i;
+
+        Int64List lst;
+        buildList(lst, count, false);
+        double sec = measureSec([&lst, reps]()
+        {
+            for (std::size_t r = 0; r < reps; ++r)
+                doNotOptimize(lst.findFirst(-1));
+        });
+        std::printf("%12zu %12.2f", bytes, (double) (bytes * reps) / sec / 1e9);
+
+        for (int lvl = SIMD_SCALAR; lvl <= best; ++lvl)
+        {
+            simdSetLevel((SimdLevel) lvl);
+            sec = measureSec([&data, reps]()
+            {
+                for (std::size_t r = 0; r < reps; ++r)
+                    doNotOptimize(SimdSearch<int64_t>::findFirst(data.data(), data.size(), -1));
+            });
+            std::printf(" %12.2f", (double) (bytes * reps) / sec / 1e9);
+        }
+        std::printf("\n");
+    }
+    simdSetLevel(best);
+}
+
+
+/** \brief Value-only passes (sum and count) over node-based and SoA lists */
+void benchSoa(std::size_t maxBytes)
+{
+    std::printf("%12s %12s %12s %12s %12s   (ns/element)\n", "elements", "list sum", "soa sum",
+                "list count", "soa count");
+
+    for (std::size_t count = 4096; count * sizeof(Int64List::Node) <= maxBytes; count *= 4)
+    {
+        std::size_t reps = std::max<std::size_t>(1, (16u << 20) / count);
+        Int64List lst;
+        buildList(lst, count, false);
+        BidiSoaList<int64_t> soa;
+        for (std::size_t i = 0; i < count; ++i)
+            soa.appendEl((int64_t) i);
+
+        double listSum = measureSec([&lst, reps]()
+        {
+            for (std::size_t r = 0; r < reps; ++r)
+            {
+                int64_t sum = 0;
+                lst.forEach([&sum](int64_t &v) { sum += v; });
+                doNotOptimize(sum);
+            }
+        });
+        double soaSum = measureSec([&soa, reps]()
+        {
+            for (std::size_t r = 0; r < reps; ++r)
+                doNotOptimize(soa.sum());
+        });
+        double listCount = measureSec([&lst, reps]()
+        {
+            for (std::size_t r = 0; r < reps; ++r)
+                doNotOptimize(lst.count(7));
+        });
+        double soaCount = measureSec([&soa, reps]()
+        {
+            for (std::size_t r = 0; r < reps; ++r)
+                doNotOptimize(soa.count(7));
+        });
+
+        double norm = 1e9 / (double) (count * reps);
+        std::printf("%12zu %12.2f %12.2f %12.2f %12.2f\n", count, listSum * norm, soaSum * norm,
+                    listCount * norm, soaCount * norm);
+    }
+}
+
+
+/** \brief Heap allocations and build/destroy time of many short lists, whose
+ *  sizes follow a geometric distribution (mean 4, long tail), with and without
+ *  an inline buffer
+ */
+void benchSmallList(std::size_t maxBytes)
+{
+    std::size_t lists = std::max<std::size_t>(1, maxBytes / 256);
+    std::vector<std::size_t> sizes(lists);
+    std::mt19937_64 rnd(lists);
+    std::geometric_distribution<std::size_t> dist(0.2);
+    std::size_t elements = 0;
+    for (std::size_t i = 0; i < lists; ++i)
+        elements += sizes[i] = dist(rnd);
+
+    std::printf("%10s %12s %14s %14s\n", "buffer", "allocs/list", "ns/list", "ns/element");
+
+    std::size_t before = allocCount;
+    double sec = measureSec([&sizes]()
+    {
+        for (std::size_t i = 0; i < sizes.size(); ++i)
+        {
+            Int64List lst;
+            for (std::size_t j = 0; j < sizes[i]; ++j)
+                lst.appendEl((int64_t) j);
+            doNotOptimize(lst.getLastNode());
+        }
+    });
+    std::printf("%10s %12.2f %14.1f %14.2f\n", "none", (double) (allocCount - before) / (double) lists,
+                sec * 1e9 / (double) lists, sec * 1e9 / (double) elements);
+
+    before = allocCount;
+    sec = measureSec([&sizes]()
+    {
+        for (std::size_t i = 0; i < sizes.size(); ++i)
+        {
+            BidiSmallList<int64_t, 8> lst;
+            for (std::size_t j = 0; j < sizes[i]; ++j)
+                lst.appendEl((int64_t) j);
+            doNotOptimize(lst.getLastNode());
+        }
+    });
+    std::printf("%10s %12.2f %14.1f %14.2f\n", "8 nodes", (double) (allocCount - before) / (double) lists,
+                sec * 1e9 / (double) lists, sec * 1e9 / (double) elements);
+}
+
+
+/** \brief Policy with no argument checks */
+struct UncheckedPolicy : DefaultBidiListPolicy
+{
+    static const bool CHECKED = false;
+};
+
+/** \brief Policy with no argument checks and no size cache */
+struct BarePolicy : UncheckedPolicy
+{
+    static const bool TRACK_SIZE = false;
+};
+
+
+/** \brief Moves nodes of a list of \a count nodes after other nodes as given by
+ *  pairs of indices in \a moves; returns the best of three runs in ns per move
+ */
+template<typename List>
+double moveNodes(std::size_t count, const std::vector<uint32_t> &moves)
+{
+    List lst;
+    std::vector<typename List::Node *> nodes(count);
+    for (std::size_t i = 0; i < count; ++i)
+        nodes[i] = lst.appendEl((int64_t) i);
+
+    double sec = 0;
+    for (int run = 0; run < 3; ++run)
+    {
+        double runSec = measureSec([&lst, &nodes, &moves]()
+        {
+            for (std::size_t i = 0; i + 1 < moves.size(); i += 2)
+            {
+                typename List::Node *node = nodes[moves[i]];
+                lst.cutNode(node);
+                lst.insertNodeAfter(nodes[moves[i + 1]], node);
+            }
+        });
+        sec = run == 0 ? runSec : std::min(sec, runSec);
+    }
+    doNotOptimize(lst.getHeadNode());
+    return sec * 1e9 / (double) (moves.size() / 2);
+}
+
+
+/** \brief Cost of a cut and an insertion with every policy feature and with checks
+ *  and size tracking compiled out
+ */
+void benchPolicy(std::size_t maxBytes)
+{
+    std::printf("%12s %12s %12s %12s   (ns/move)\n", "nodes", "default", "unchecked", "bare");
+
+    for (std::size_t count = 1024; count * sizeof(Int64List::Node) <= maxBytes; count *= 16)
+    {
+        // pairs of a moved node and a different node to move it after
+        std::vector<uint32_t> moves(1u << 23);
+        std::mt19937 rnd((uint32_t) count);
+        for (std::size_t i = 0; i < moves.size(); i += 2)
+        {
+            moves[i] = (uint32_t) (rnd() % count);
+            do
+                moves[i + 1] = (uint32_t) (rnd() % count);
+            while (moves[i + 1] == moves[i]);
+        }
+
+        std::printf("%12zu %12.2f %12.2f %12.2f\n", count,
+                    moveNodes<BidiLinkedList<int64_t> >(count, moves),
+                    moveNodes<BidiLinkedList<int64_t, UncheckedPolicy> >(count, moves),
+                    moveNodes<BidiLinkedList<int64_t, BarePolicy> >(count, moves));
+    }
+}
+
+
+/** \brief Appending a batch of values one by one against appendRange(), also
+ *  with a size query after every batch
+ */
+void benchRange(std::size_t maxBytes)
+{
+    std::printf("%10s %12s %12s %14s %14s   (ns/element)\n", "batch", "appendEl", "appendRange",
+                "appendEl+size", "range+size");
+
+    for (std::size_t batch = 1000; batch * sizeof(Int64List::Node) <= maxBytes && batch <= 1000000;
+         batch *= 10)
+    {
+        std::vector<int64_t> vals(batch);
+        for (std::size_t i = 0; i < batch; ++i)
+            vals[i] = (int64_t) i;
+
+        // a list keeps growing by 8 batches, so a recount of size is not free
+        const std::size_t BATCHES = 8;
+        {
+            // let the allocator grow the heap before measuring
+            Int64List warmUp;
+            for (std::size_t b = 0; b < BATCHES; ++b)
+                warmUp.appendRange(vals.begin(), vals.end());
+        }
+
+        double res[4];
+        for (int mode = 0; mode < 4; ++mode)
+        {
+            bool range = mode % 2 != 0;
+            bool size = mode >= 2;
+            Int64List lst;
+            res[mode] = measureSec([&lst, &vals, range, size, BATCHES]()
+            {
+                for (std::size_t b = 0; b < BATCHES; ++b)
+                {
+                    if (range)
+                        lst.appendRange(vals.begin(), vals.end());
+                    else
+                        for (std::size_t i = 0; i < vals.size(); ++i)
+                            lst.appendEl(vals[i]);
+
+                    if (size)
+                        doNotOptimize(lst.getSize());
+                }
+            });
+            res[mode] *= 1e9 / (double) (batch * BATCHES);
+        }
+
+        std::printf("%10zu %12.2f %12.2f %14.2f %14.2f\n", batch, res[0], res[1], res[2], res[3]);
+    }
+}
+
+
+/** \brief Steady-state queue of a bounded length: appendEl() with cutNode() and
+ *  delete against pushBack() and popFront() with the node cache
+ */
+void benchDeque(std::size_t maxBytes)
+{
+    std::size_t ops = std::max<std::size_t>(1024, maxBytes / 4);
+    std::printf("%10s %16s %16s %16s %16s\n", "length", "append/cut", "push/pop", "append/cut",
+                "push/pop");
+    std::printf("%10s %16s %16s %16s %16s\n", "", "(ns/op)", "(ns/op)", "(allocs/op)", "(allocs/op)");
+
+    for (std::size_t length = 4; length <= 4096; length *= 8)
+    {
+        Int64List manual;
+        Int64List deque;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            manual.appendEl((int64_t) i);
+            deque.pushBack((int64_t) i);
+        }
+
+        std::size_t before = allocCount;
+        double manualSec = measureSec([&manual, ops]()
+        {
+            for (std::size_t i = 0; i < ops; ++i)
+            {
+                manual.appendEl((int64_t) i);
+                Int64List::Node *node = manual.cutNode(manual.getHeadNode());
+                doNotOptimize(node->getValue());
+                delete node;
+            }
+        });
+        std::size_t manualAllocs = allocCount - before;
+
+        before = allocCount;
+        double dequeSec = measureSec([&deque, ops]()
+        {
+            for (std::size_t i = 0; i < ops; ++i)
+            {
+                deque.pushBack((int64_t) i);
+                doNotOptimize(deque.popFront());
+            }
+        });
+        std::size_t dequeAllocs = allocCount - before;
+
+        std::printf("%10zu %16.2f %16.2f %16.3f %16.3f\n", length, manualSec * 1e9 / (double) ops,
+                    dequeSec * 1e9 / (double) ops, (double) manualAllocs / (double) ops,
+                    (double) dequeAllocs / (double) ops);
+    }
+}
+
+
+/** \brief Policy with O(1) reversal */
+struct ReversiblePolicy : DefaultBidiListPolicy
+{
+    static const bool REVERSIBLE = true;
+};
+
+
+/** \brief Scans and push/pop pairs on a list \a lst of \a count nodes; returns ns per
+ *  scanned node and ns per pair
+ */
+template<typename List>
+void scanAndQueue(List &lst, std::size_t count, double &scanNs, double &queueNs)
+{
+    std::size_t reps = std::max<std::size_t>(1, (16u << 20) / count);
+    double sec = measureSec([&lst, reps]()
+    {
+        for (std::size_t r = 0; r < reps; ++r)
+            doNotOptimize(lst.findFirst(-1));
+    });
+    scanNs = sec * 1e9 / (double) (count * reps);
+
+    const std::size_t OPS = 1u << 24;
+    sec = measureSec([&lst, OPS]()
+    {
+        for (std::size_t i = 0; i < OPS; ++i)
+        {
+            lst.pushBack((int64_t) i);
+            doNotOptimize(lst.popFront());
+        }
+    });
+    queueNs = sec * 1e9 / (double) OPS;
+}
+
+
+/** \brief Overhead of the direction flag of a reversible list, used and unused,
+ *  and a cost of reverseInPlace()
+ */
+void benchReverse(std::size_t maxBytes)
+{
+    std::printf("%10s %10s %10s %10s %10s %10s %10s %12s\n", "nodes", "scan", "scan", "scan",
+                "queue", "queue", "queue", "inPlace");
+    std::printf("%10s %10s %10s %10s %10s %10s %10s %12s\n", "", "default", "flag off", "flag on",
+                "default", "flag off", "flag on", "(ns/node)");
+
+    for (std::size_t count = 4096; count * sizeof(Int64List::Node) <= maxBytes; count *= 16)
+    {
+        std::vector<int64_t> vals(count);
+        for (std::size_t i = 0; i < count; ++i)
+            vals[i] = (int64_t) i;
+
+        double scan[3], queue[3];
+        Int64List lst;
+        lst.appendRange(vals.begin(), vals.end());
+        scanAndQueue(lst, count, scan[0], queue[0]);
+
+        BidiLinkedList<int64_t, ReversiblePolicy> revLst;
+        revLst.appendRange(vals.begin(), vals.end());
+        scanAndQueue(revLst, count, scan[1], queue[1]);
+        revLst.reverse();
+        scanAndQueue(revLst, count, scan[2], queue[2]);
+
+        double inPlace = measureSec([&lst]() { lst.reverseInPlace(); });
+
+        std::printf("%10zu %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %12.2f\n", count, scan[0], scan[1],
+                    scan[2], queue[0], queue[1], queue[2], inPlace * 1e9 / (double) count);
+    }
+}
+
+
+/** \brief Key that counts its comparisons, so that nodes visited by a search are known */
+struct CountedKey
+{
+    CountedKey(int64_t v = 0) : val(v) {}
+
+    bool operator==(const CountedKey &other) const
+    {
+        ++compares;
+        return val == other.val;
+    }
+
+    int64_t val;
+    static std::size_t compares;
+};
+
+std::size_t CountedKey::compares = 0;
+
+
+/** \brief Policy of a list with a given self-organization */
+template<BidiSelfOrganization Org>
+struct SelfOrgPolicy : DefaultBidiListPolicy
+{
+    static const BidiSelfOrganization SELF_ORGANIZATION = Org;
+};
+
+
+/** \brief Runs \a lookups over a list of keys inserted in \a order; returns ns per
+ *  lookup and writes an average number of visited nodes to \a visited
+ */
+template<BidiSelfOrganization Org>
+double zipfLookups(const std::vector<int64_t> &order, const std::vector<int64_t> &lookups,
+                   double &visited)
+{
+    BidiLinkedList<CountedKey, SelfOrgPolicy<Org> > lst;
+    for (std::size_t i = 0; i < order.size(); ++i)
+        lst.appendEl(CountedKey(order[i]));
+
+    CountedKey::compares = 0;
+    double sec = measureSec([&lst, &lookups]()
+    {
+        for (std::size_t i = 0; i < lookups.size(); ++i)
+            doNotOptimize(lst.findFirst(CountedKey(lookups[i])));
+    });
+
+    visited = (double) CountedKey::compares / (double) lookups.size();
+    return sec * 1e9 / (double) lookups.size();
+}
+
+
+/** \brief Lookups of keys following a Zipf distribution (s = 1) in lists with every
+ *  self-organization
+ */
+void benchSelfOrg(std::size_t maxBytes)
+{
+    std::printf("%8s %22s %22s %22s %22s\n", "keys", "none", "move-to-front", "transpose",
+                "count");
+    std::printf("%8s", "");
+    for (int i = 0; i < 4; ++i)
+        std::printf(" %10s %11s", "(visited)", "(ns/lookup)");
+    std::printf("\n");
+
+    for (std::size_t keys = 100; keys * sizeof(Int64List::Node) * 64 <= maxBytes && keys <= 100000;
+         keys *= 10)
+    {
+        // ranks of keys are unrelated to the order they are inserted
+        std::vector<int64_t> order(keys);
+        for (std::size_t i = 0; i < keys; ++i)
+            order[i] = (int64_t) i;
+        std::mt19937_64 rnd(keys);
+        std::shuffle(order.begin(), order.end(), rnd);
+
+        std::vector<double> cdf(keys);
+        double total = 0;
+        for (std::size_t i = 0; i < keys; ++i)
+            cdf[i] = total += 1.0 / (double) (i + 1);
+
+        std::vector<int64_t> lookups(std::max<std::size_t>(100000, keys * 20));
+        std::uniform_real_distribution<double> uni(0, total);
+        for (std::size_t i = 0; i < lookups.size(); ++i)
+            lookups[i] = std::lower_bound(cdf.begin(), cdf.end(), uni(rnd)) - cdf.begin();
+
+        double visited[4], ns[4];
+        ns[0] = zipfLookups<BIDI_SELF_ORG_NONE>(order, lookups, visited[0]);
+        ns[1] = zipfLookups<BIDI_MOVE_TO_FRONT>(order, lookups, visited[1]);
+        ns[2] = zipfLookups<BIDI_TRANSPOSE>(order, lookups, visited[2]);
+        ns[3] = zipfLookups<BIDI_FREQUENCY_COUNT>(order, lookups, visited[3]);
+
+        std::printf("%8zu", keys);
+        for (int i = 0; i < 4; ++i)
+            std::printf(" %10.1f %11.1f", visited[i], ns[i]);
+        std::printf("\n");
+    }
+}
+
+
+/** \brief Lookups of values near the previous hit: findFirst() from the head
+ *  against findNear() from the finger
+ */
+void benchFinger(std::size_t maxBytes)
+{
+    std::printf("%10s %8s %16s %16s   (ns/lookup)\n", "nodes", "spread", "findFirst", "findNear");
+
+    for (std::size_t count = 4096; count * sizeof(Int64List::Node) <= maxBytes; count *= 16)
+    {
+        Int64List lst;
+        buildList(lst, count, false);
+
+        for (std::size_t spread = 16; spread <= 1024; spread *= 8)
+        {
+            // a random walk over values
+            std::vector<int64_t> lookups(4096);
+            std::mt19937_64 rnd(count + spread);
+            int64_t pos = (int64_t) count / 2;
+            for (std::size_t i = 0; i < lookups.size(); ++i)
+            {
+                pos += (int64_t) (rnd() % (2 * spread + 1)) - (int64_t) spread;
+                pos = std::min<int64_t>(std::max<int64_t>(pos, 0), (int64_t) count - 1);
+                lookups[i] = pos;
+            }
+
+            // full scans are slow, so only a prefix of the walk is timed for them
+            std::size_t headLookups = std::min<std::size_t>(lookups.size(),
+                                                            std::max<std::size_t>(16, (16u << 20) / count));
+            double headSec = measureSec([&lst, &lookups, headLookups]()
+            {
+                for (std::size_t i = 0; i < headLookups; ++i)
+                    doNotOptimize(lst.findFirst(lookups[i]));
+            });
+            lst.setFinger(nullptr);
+            double nearSec = measureSec([&lst, &lookups]()
+            {
+                for (std::size_t i = 0; i < lookups.size(); ++i)
+                    doNotOptimize(lst.findNear(lookups[i]));
+            });
+
+            std::printf("%10zu %8zu %16.1f %16.1f\n", count, spread,
+                        headSec * 1e9 / (double) headLookups, nearSec * 1e9 / (double) lookups.size());
+        }
+    }
+}
+
+
+/** \brief Runs negative lookups on an AugmentedBidiList with \a Monoid over \a vals;
+ *  sets ns per lookup and a share of nodes that were not visited
+ */
+template<typename Monoid>
+void negativeLookups(const std::vector<int64_t> &vals, const std::vector<int64_t> &lookups,
+                     double &ns, double &skipRate)
+{
+    AugmentedBidiList<int64_t, Monoid> lst;
+    for (std::size_t i = 0; i < vals.size(); ++i)
+        lst.appendEl(vals[i]);
+
+    // plain scans are slow, so fewer lookups are timed for big lists
+    std::size_t n = std::min<std::size_t>(lookups.size(),
+                                          std::max<std::size_t>(16, (64u << 20) / vals.size()));
+    lst.resetSearchStats();
+    double sec = measureSec([&lst, &lookups, n]()
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            doNotOptimize(lst.findFirst(lookups[i]));
+    });
+
+    ns = sec * 1e9 / (double) n;
+    skipRate = 1.0 - (double) lst.getSearchStats().nodesVisited / ((double) n * (double) vals.size());
+}
+
+
+/** \brief Negative lookups with chunk summaries: a linear scan (SumMonoid) against
+ *  Bloom filters and zone maps, on random and sorted values
+ */
+void benchSkip(std::size_t maxBytes)
+{
+    typedef AugmentedBidiList<int64_t, BloomMonoid<int64_t> > BloomList;
+
+    std::printf("%10s %8s %10s %10s %10s %12s %12s   (ns/lookup, share of nodes skipped)\n",
+                "nodes", "order", "scan", "bloom", "zonemap", "bloom skip", "zone skip");
+
+    for (std::size_t count = 4096; count * sizeof(BloomList::Node) <= maxBytes; count *= 16)
+    {
+        for (int sorted = 0; sorted < 2; ++sorted)
+        {
+            // list values are even and looked up ones are odd, so nothing is found
+            std::mt19937_64 rnd(count);
+            std::vector<int64_t> vals(count);
+            for (std::size_t i = 0; i < count; ++i)
+                vals[i] = (int64_t) (rnd() % (count * 8)) * 2;
+            if (sorted)
+                std::sort(vals.begin(), vals.end());
+
+            std::vector<int64_t> lookups(4096);
+            for (std::size_t i = 0; i < lookups.size(); ++i)
+                lookups[i] = (int64_t) (rnd() % (count * 8)) * 2 + 1;
+
+            double ns[3], skip[3];
+            negativeLookups<SumMonoid<int64_t> >(vals, lookups, ns[0], skip[0]);
+            negativeLookups<BloomMonoid<int64_t> >(vals, lookups, ns[1], skip[1]);
+            negativeLookups<ZoneMapMonoid<int64_t> >(vals, lookups, ns[2], skip[2]);
+
+            std::printf("%10zu %8s %10.0f %10.0f %10.0f %11.1f%% %11.1f%%\n", count,
+                        sorted ? "sorted" : "random", ns[0], ns[1], ns[2],
+                        skip[1] * 100, skip[2] * 100);
+        }
+    }
+}
+
+
+/** \brief Policy of a list whose nodes cache hashes of values */
+struct TaggedPolicy : DefaultBidiListPolicy
+{
+    static const bool HASH_TAGS = true;
+};
+
+
+/** \brief Times lookups of \a lookups in \a lst; returns ns per lookup */
+template<typename List>
+double stringLookups(List &lst, const std::vector<std::string> &lookups)
+{
+    // the best of a few runs, as in benchPolicy()
+    double best = 0;
+    for (int run = 0; run < 3; ++run)
+    {
+        double sec = measureSec([&lst, &lookups]()
+        {
+            for (std::size_t i = 0; i < lookups.size(); ++i)
+                doNotOptimize(lst.findFirst(lookups[i]));
+        });
+        best = run == 0 ? sec : std::min(best, sec);
+    }
+    return best * 1e9 / (double) lookups.size();
+}
+
+
+/** \brief Searches of long strings with a common prefix: plain nodes against
+ *  nodes with hash tags
+ */
+void benchHashTags(std::size_t maxBytes)
+{
+    std::printf("%10s %8s %12s %12s   (ns/lookup, half of lookups miss)\n",
+                "nodes", "length", "plain", "tagged");
+
+    for (std::size_t len = 16; len <= 1024; len *= 8)
+    {
+        for (std::size_t count = 1024; count * (len + 64) <= maxBytes / 4 && count <= 65536; count *= 8)
+        {
+            // keys of equal length differ in the last characters only, so operator==
+            // compares them almost entirely
+            std::string prefix(len - 8, 'k');
+            std::vector<std::string> keys(count);
+            char buf[16];
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                std::snprintf(buf, sizeof(buf), "%08zu", i * 2);
+                keys[i] = prefix + buf;
+            }
+
+            std::mt19937_64 rnd(count + len);
+            std::vector<std::string> lookups(std::max<std::size_t>(16, (1u << 22) / count));
+            for (std::size_t i = 0; i < lookups.size(); ++i)
+            {
+                std::snprintf(buf, sizeof(buf), "%08zu", (std::size_t) (rnd() % (count * 2)));
+                lookups[i] = prefix + buf;
+            }
+
+            // both lists are built before timing, so that neither reuses memory freed
+            // by the other in a scattered order
+            BidiLinkedList<std::string> plain;
+            BidiLinkedList<std::string, TaggedPolicy> tagged;
+            for (std::size_t i = 0; i < count; ++i)
+                plain.appendEl(keys[i]);
+            for (std::size_t i = 0; i < count; ++i)
+                tagged.appendEl(keys[i]);
+
+            double plainNs = stringLookups(plain, lookups);
+            double taggedNs = stringLookups(tagged, lookups);
+            std::printf("%10zu %8zu %12.0f %12.0f\n", count, len, plainNs, taggedNs);
+        }
+    }
+}
+
+
+/** \brief BidiLinkedList behind one mutex, the way it is shared without ConcurrentBidiList */
+class GlobalLockedList
+{
+public:
+    typedef Int64List::Node Node;
+
+    Node *appendEl(int64_t val)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        return _lst.appendEl(val);
+    }
+
+    Node *insertNodeAfter(Node *node, Node *insNode)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        return _lst.insertNodeAfter(node, insNode);
+    }
+
+    Node *cutNode(Node *node)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        return _lst.cutNode(node);
+    }
+
+    Node *findFirst(int64_t val)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        return _lst.findFirst(val);
+    }
+
+    Node *cutFirst(int64_t val)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        return _lst.cutFirst(val);
+    }
+
+protected:
+    Int64List _lst;
+    std::mutex _lock;
+};
+
+
+/** \brief Runs \a threads threads doing \a opsPerThread operations on \a lst:
+ *  8 of 10 are searches, the rest insert and cut nodes next to a node of the
+ *  thread; returns total operations per microsecond
+ */
+template<typename List>
+double mixedOps(List &lst, std::size_t listSize, std::size_t threads, std::size_t opsPerThread)
+{
+    typedef typename List::Node Node;
+
+    std::vector<Node *> anchors;
+    for (std::size_t i = 0; i < listSize; ++i)
+    {
+        Node *nd = lst.appendEl((int64_t) i);
+        if (i % (listSize / threads) == 0 && anchors.size() < threads)
+            anchors.push_back(nd);
+    }
+
+    std::vector<std::thread> workers;
+    double sec = measureSec([&]()
+    {
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            workers.push_back(std::thread([&lst, &anchors, listSize, opsPerThread, t]()
+            {
+                std::mt19937_64 rnd(t);
+                std::vector<Node *> own;
+                for (std::size_t i = 0; i < opsPerThread; ++i)
+                {
+                    std::size_t op = i % 10;
+                    if (op == 8)
+                        own.push_back(lst.insertNodeAfter(anchors[t], new Node(-1)));
+                    else if (op == 9)
+                    {
+                        delete lst.cutNode(own.back());
+                        own.pop_back();
+                    } else
+                        doNotOptimize(lst.findFirst((int64_t) (rnd() % listSize)));
+                }
+            }));
+        }
+        for (std::size_t t = 0; t < threads; ++t)
+            workers[t].join();
+    });
+
+    return (double) (threads * opsPerThread) / sec / 1e6;
+}
+
+
+/** \brief Throughput of a shared list against a number of threads: one global mutex
+ *  against per-node locks
+ */
+void benchConcurrent(std::size_t maxBytes)
+{
+    (void) maxBytes;        // lists are small, contention is what is measured
+    std::printf("(%u hardware threads)\n", std::thread::hardware_concurrency());
+    std::printf("%10s %8s %14s %14s   (Mops/s, 80%% searches)\n",
+                "nodes", "threads", "global mutex", "per-node");
+
+    for (std::size_t listSize = 64; listSize <= 1024; listSize *= 16)
+    {
+        for (std::size_t threads = 1; threads <= 32; threads *= 2)
+        {
+            std::size_t ops = std::max<std::size_t>(100, (8u << 20) / listSize / threads);
+            GlobalLockedList global;
+            double globalMops = mixedOps(global, listSize, threads, ops);
+            ConcurrentBidiList<int64_t> fine;
+            double fineMops = mixedOps(fine, listSize, threads, ops);
+            std::printf("%10zu %8zu %14.2f %14.2f\n", listSize, threads, globalMops, fineMops);
+        }
+    }
+}
+
+
+/** \brief Runs \a threads threads doing \a opsPerThread operations on \a lst of
+ *  \a listSize nodes: every other one appends a value of the thread, the rest cut
+ *  it by value again; returns total operations per microsecond
+ */
+template<typename List>
+double updateOps(List &lst, std::size_t listSize, std::size_t threads, std::size_t opsPerThread)
+{
+    for (std::size_t i = 0; i < listSize; ++i)
+        lst.appendEl(-1 - (int64_t) i);
+
+    std::vector<std::thread> workers;
+    double sec = measureSec([&]()
+    {
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            workers.push_back(std::thread([&lst, opsPerThread, t]()
+            {
+                int64_t base = (int64_t) (t * opsPerThread);
+                for (std::size_t i = 0; i < opsPerThread; ++i)
+                {
+                    if (i % 2 == 0)
+                        lst.appendEl(base + (int64_t) i);
+                    else
+                        delete lst.cutFirst(base + (int64_t) i - 1);
+                }
+            }));
+        }
+        for (std::size_t t = 0; t < threads; ++t)
+            workers[t].join();
+    });
+
+    return (double) (threads * opsPerThread) / sec / 1e6;
+}
+
+
+/** \brief Throughput of an update-heavy shared list against a number of threads:
+ *  one global mutex, per-node locks and flat combining
+ */
+void benchCombining(std::size_t maxBytes)
+{
+    (void) maxBytes;        // lists are small, contention is what is measured
+    std::printf("(%u hardware threads)\n", std::thread::hardware_concurrency());
+    std::printf("%10s %8s %14s %14s %14s   (Mops/s, appends and cuts)\n",
+                "nodes", "threads", "global mutex", "per-node", "combining");
+
+    for (std::size_t listSize = 16; listSize <= 256; listSize *= 16)
+    {
+        for (std::size_t threads = 1; threads <= 32; threads *= 2)
+        {
+            std::size_t ops = std::max<std::size_t>(100, (8u << 20) / listSize / threads);
+            GlobalLockedList global;
+            double globalMops = updateOps(global, listSize, threads, ops);
+            ConcurrentBidiList<int64_t> fine;
+            double fineMops = updateOps(fine, listSize, threads, ops);
+            FlatCombiningBidiList<int64_t> combining;
+            double combiningMops = updateOps(combining, listSize, threads, ops);
+            std::printf("%10zu %8zu %14.2f %14.2f %14.2f\n", listSize, threads,
+                        globalMops, fineMops, combiningMops);
+        }
+    }
+}
+
+
+/** \brief BidiLinkedList deque behind one mutex */
+class GlobalLockedDeque
+{
+public:
+    void pushBack(int64_t val)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _lst.pushBack(val);
+    }
+
+    bool popFront(int64_t &val)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (_lst.getHeadNode() == nullptr)
+            return false;
+        val = _lst.popFront();
+        return true;
+    }
+
+protected:
+    Int64List _lst;
+    std::mutex _lock;
+};
+
+
+/** \brief Runs \a threads threads doing pairs of pushBack() and popFront() on \a deque;
+ *  sets total Mops/s and the median and 99th percentile of an operation in ns
+ */
+template<typename Deque>
+void queueOps(Deque &deque, std::size_t threads, std::size_t pairsPerThread,
+              double &mops, double &p50, double &p99)
+{
+    std::vector<std::vector<float> > latencies(threads);
+    std::vector<std::thread> workers;
+    double sec = measureSec([&]()
+    {
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            workers.push_back(std::thread([&deque, &latencies, pairsPerThread, t]()
+            {
+                std::vector<float> &lat = latencies[t];
+                lat.reserve(pairsPerThread * 2);
+                int64_t val = 0;
+                for (std::size_t i = 0; i < pairsPerThread; ++i)
+                {
+                    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+                    deque.pushBack((int64_t) i);
+                    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+                    doNotOptimize(deque.popFront(val));
+                    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+                    lat.push_back((float) std::chrono::duration<double, std::nano>(t1 - t0).count());
+                    lat.push_back((float) std::chrono::duration<double, std::nano>(t2 - t1).count());
+                }
+            }));
+        }
+        for (std::size_t t = 0; t < threads; ++t)
+            workers[t].join();
+    });
+
+    std::vector<float> all;
+    for (std::size_t t = 0; t < threads; ++t)
+        all.insert(all.end(), latencies[t].begin(), latencies[t].end());
+    std::sort(all.begin(), all.end());
+
+    mops = (double) all.size() / sec / 1e6;
+    p50 = all[all.size() / 2];
+    p99 = all[all.size() * 99 / 100];
+}
+
+
+/** \brief A shared queue: BidiLinkedList behind a global mutex against LockFreeBidiList;
+ *  throughput and per-operation latency percentiles
+ */
+void benchLockFree(std::size_t maxBytes)
+{
+    (void) maxBytes;        // queues stay short, contention is what is measured
+    std::printf("(%u hardware threads)\n", std::thread::hardware_concurrency());
+    std::printf("%8s %22s %22s   (Mops/s p50/p99 ns, timing included)\n",
+                "threads", "global mutex", "lock-free");
+
+    for (std::size_t threads = 1; threads <= 16; threads *= 2)
+    {
+        std::size_t pairs = (1u << 19) / threads;
+        double mops[2], p50[2], p99[2];
+        {
+            GlobalLockedDeque deque;
+            queueOps(deque, threads, pairs, mops[0], p50[0], p99[0]);
+        }
+        {
+            LockFreeBidiList<int64_t> deque;
+            queueOps(deque, threads, pairs, mops[1], p50[1], p99[1]);
+        }
+
+        std::printf("%8zu %8.2f %6.0f/%-6.0f %8.2f %6.0f/%-6.0f\n", threads,
+                    mops[0], p50[0], p99[0], mops[1], p50[1], p99[1]);
+    }
+}
+
+
+/** \brief Sums values of \a lst by its iterators; returns a number of nodes visited */
+template<typename List>
+std::size_t scanList(List &lst)
+{
+    std::size_t seen = 0;
+    int64_t sum = 0;
+    for (int64_t val : lst)
+    {
+        sum += val;
+        ++seen;
+    }
+    doNotOptimize(sum);
+    return seen;
+}
+
+
+/** \brief Runs \a readers threads calling \a read \a scans times each while one
+ *  writer calls \a write with growing values; sets Mnodes/s read and Kops/s written
+ */
+template<typename Read, typename Write>
+void readMostly(std::size_t readers, std::size_t scans, Read read, Write write,
+                double &readMnodes, double &writeKops)
+{
+    std::atomic<bool> done(false);
+    std::atomic<std::size_t> nodesRead(0);
+    std::size_t writes = 0;
+    std::thread writer([&]()
+    {
+        for (int64_t val = 0; !done.load(std::memory_order_relaxed); ++val, ++writes)
+            write(val);
+    });
+
+    std::vector<std::thread> workers;
+    double sec = measureSec([&]()
+    {
+        for (std::size_t t = 0; t < readers; ++t)
+        {
+            workers.push_back(std::thread([&]()
+            {
+                std::size_t seen = 0;
+                for (std::size_t i = 0; i < scans; ++i)
+                    seen += read();
+                nodesRead += seen;
+            }));
+        }
+        for (std::size_t t = 0; t < readers; ++t)
+            workers[t].join();
+    });
+    done = true;
+    writer.join();
+
+    readMnodes = (double) nodesRead.load() / sec / 1e6;
+    writeKops = (double) writes / sec / 1e3;
+}
+
+
+/** \brief Readers iterating a list while one writer replaces its head by a new
+ *  tail: BidiLinkedList behind a mutex against RcuBidiList, whose readers take
+ *  no lock
+ */
+void benchRcu(std::size_t maxBytes)
+{
+    (void) maxBytes;        // the list stays in cache, synchronization is what is measured
+    const std::size_t LIST_SIZE = 1024;
+    const std::size_t SCANS = 4096;
+
+    std::printf("(%u hardware threads)\n", std::thread::hardware_concurrency());
+    std::printf("%8s %24s %24s   (reads Mnodes/s, writes Kops/s)\n",
+                "readers", "mutex", "rcu");
+
+    for (std::size_t readers = 1; readers <= 8; readers *= 2)
+    {
+        double reads[2], writes[2];
+        std::size_t scans = SCANS / readers;
+        {
+            Int64List lst;
+            for (std::size_t i = 0; i < LIST_SIZE; ++i)
+                lst.pushBack((int64_t) i);
+
+            std::mutex lock;
+            readMostly(readers, scans, [&lst, &lock]()
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                return scanList(lst);
+            }, [&lst, &lock](int64_t val)
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                lst.popFront();
+                lst.pushBack(val);
+            }, reads[0], writes[0]);
+        }
+        {
+            RcuBidiList<int64_t> lst;
+            for (std::size_t i = 0; i < LIST_SIZE; ++i)
+                lst.pushBack((int64_t) i);
+
+            readMostly(readers, scans, [&lst]()
+            {
+                RcuBidiList<int64_t>::ReadGuard guard(lst);
+                return scanList(lst);
+            }, [&lst](int64_t val)
+            {
+                int64_t popped;
+                lst.popFront(popped);
+                lst.pushBack(val);
+            }, reads[1], writes[1]);
+        }
+
+        std::printf("%8zu %12.1f %11.1f %12.1f %11.1f\n", readers,
+                    reads[0], writes[0], reads[1], writes[1]);
+    }
+}
+
+
+/** \brief Event log as BidiLinkedList behind a mutex, whose readers wait on a
+ *  condition variable notified by every append
+ */
+class LockedLog
+{
+public:
+    void appendEl(int64_t val)
+    {
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _lst.appendEl(val);
+        }
+        _appended.notify_all();
+    }
+
+    /** \brief Returns an entry after \a node (the first one for nullptr), waiting for it */
+    Int64List::Node *wait(Int64List::Node *node)
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        for (;;)
+        {
+            Int64List::Node *next = node ? node->getNext() : _lst.getHeadNode();
+            if (next != nullptr)
+                return next;
+            _appended.wait(lock);
+        }
+    }
+
+protected:
+    Int64List _lst;
+    std::mutex _lock;
+    std::condition_variable _appended;
+};
+
+
+/** \brief Runs one writer appending \a entries values and \a readers threads
+ *  consuming all of them by \a consume, which returns their sum; sets appends
+ *  and deliveries per reader in Mentries/s
+ */
+template<typename Append, typename Consume>
+void tailLog(std::size_t readers, std::size_t entries, Append append, Consume consume,
+             double &appendMps, double &readMps)
+{
+    std::vector<std::thread> workers;
+    double appendSec = 0;
+    double sec = measureSec([&]()
+    {
+        for (std::size_t t = 0; t < readers; ++t)
+            workers.push_back(std::thread([&consume, entries]() { doNotOptimize(consume(entries)); }));
+
+        appendSec = measureSec([&]()
+        {
+            for (std::size_t i = 0; i < entries; ++i)
+                append((int64_t) i);
+        });
+        for (std::size_t t = 0; t < readers; ++t)
+            workers[t].join();
+    });
+
+    appendMps = (double) entries / appendSec / 1e6;
+    readMps = (double) entries / sec / 1e6;
+}
+
+
+/** \brief Readers tailing an event log: BidiLinkedList behind a mutex and a
+ *  condition variable against AppendOnlyBidiList with blocking and polling cursors
+ */
+void benchLog(std::size_t maxBytes)
+{
+    std::size_t entries = std::min<std::size_t>(maxBytes / 64, 1u << 20);
+
+    std::printf("(%u hardware threads, %zu entries)\n", std::thread::hardware_concurrency(), entries);
+    std::printf("%8s %20s %20s %20s   (appends / deliveries per reader, Mentries/s)\n",
+                "readers", "mutex+condvar", "append-only wait", "append-only poll");
+
+    for (std::size_t readers = 1; readers <= 8; readers *= 2)
+    {
+        double appends[3], reads[3];
+        {
+            LockedLog log;
+            tailLog(readers, entries, [&log](int64_t val) { log.appendEl(val); }, [&log](std::size_t count)
+            {
+                int64_t sum = 0;
+                Int64List::Node *node = nullptr;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    node = log.wait(node);
+                    sum += node->getValue();
+                }
+                return sum;
+            }, appends[0], reads[0]);
+        }
+        for (int poll = 0; poll < 2; ++poll)
+        {
+            AppendOnlyBidiList<int64_t> log;
+            tailLog(readers, entries, [&log](int64_t val) { log.appendEl(val); }, [&log, poll](std::size_t count)
+            {
+                int64_t sum = 0;
+                AppendOnlyBidiList<int64_t>::Cursor cur(log);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    AppendOnlyBidiList<int64_t>::Node *node;
+                    if (poll)
+                    {
+                        while ((node = cur.poll()) == nullptr)
+                            std::this_thread::yield();
+                    } else
+                        node = cur.wait();
+                    sum += node->getValue();
+                }
+                return sum;
+            }, appends[1 + poll], reads[1 + poll]);
+        }
+
+        std::printf("%8zu %9.2f / %-8.2f %9.2f / %-8.2f %9.2f / %-8.2f\n", readers,
+                    appends[0], reads[0], appends[1], reads[1], appends[2], reads[2]);
+    }
+}
+
+
+/** \brief Handoff of nodes as BidiLinkedList behind a mutex: the consumer takes
+ *  the whole list at once
+ */
+class LockedHandoff
+{
+public:
+    LockedHandoff() : _count(0) {}
+
+    void push(Int64List::Node *node)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _lst.insertNodeAfter(nullptr, node);
+        ++_count;
+    }
+
+    std::size_t popBatch(Int64List::Node *&beg, Int64List::Node *&end)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        beg = _lst.getHeadNode();
+        if (beg == nullptr)
+            return 0;
+
+        end = _lst.getLastNode();
+        _lst.cutNodes(beg, end);
+        std::size_t count = _count;
+        _count = 0;
+        return count;
+    }
+
+protected:
+    Int64List _lst;
+    std::size_t _count;
+    std::mutex _lock;
+};
+
+
+/** \brief Runs \a producers threads pushing \a perProducer preallocated nodes to
+ *  \a queue while this thread pops batches and splices them into a list; returns
+ *  Mnodes/s handed over
+ */
+template<typename Queue>
+double handoff(Queue &queue, std::size_t producers, std::size_t perProducer)
+{
+    std::vector<std::vector<Int64List::Node *> > nodes(producers);
+    for (std::size_t t = 0; t < producers; ++t)
+        for (std::size_t i = 0; i < perProducer; ++i)
+            nodes[t].push_back(new Int64List::Node((int64_t) i));
+
+    Int64List dst;
+    std::vector<std::thread> workers;
+    double sec = measureSec([&]()
+    {
+        for (std::size_t t = 0; t < producers; ++t)
+            workers.push_back(std::thread([&queue, &nodes, t]()
+            {
+                for (std::size_t i = 0; i < nodes[t].size(); ++i)
+                    queue.push(nodes[t][i]);
+            }));
+
+        for (std::size_t total = 0; total < producers * perProducer; )
+        {
+            Int64List::Node *beg;
+            Int64List::Node *end;
+            std::size_t count = queue.popBatch(beg, end);
+            if (count == 0)
+                std::this_thread::yield();
+            else
+                dst.insertNodesAfter(nullptr, beg, end, count);
+            total += count;
+        }
+        for (std::size_t t = 0; t < producers; ++t)
+            workers[t].join();
+    });
+
+    return (double) (producers * perProducer) / sec / 1e6;
+}
+
+
+/** \brief Handing nodes over from producers to a consumer: BidiLinkedList behind
+ *  a mutex against the intrusive BidiMpscQueue
+ */
+void benchMpsc(std::size_t maxBytes)
+{
+    std::size_t total = std::min<std::size_t>(maxBytes / 64, 1u << 20);
+
+    std::printf("(%u hardware threads, %zu nodes)\n", std::thread::hardware_concurrency(), total);
+    std::printf("%10s %14s %14s   (Mnodes/s)\n", "producers", "mutex list", "mpsc queue");
+
+    for (std::size_t producers = 1; producers <= 8; producers *= 2)
+    {
+        double mnodes[2];
+        {
+            LockedHandoff queue;
+            mnodes[0] = handoff(queue, producers, total / producers);
+        }
+        {
+            BidiMpscQueue<int64_t> queue;
+            mnodes[1] = handoff(queue, producers, total / producers);
+        }
+
+        std::printf("%10zu %14.2f %14.2f\n", producers, mnodes[0], mnodes[1]);
+    }
+}
+
+
+/** \brief Runs \a producers threads, each calling `work(t)` once; returns
+ *  Mappends/s given \a perProducer appends by each
+ */
+template<typename Work>
+double produce(std::size_t producers, std::size_t perProducer, Work work)
+{
+    std::vector<std::thread> workers;
+    double sec = measureSec([&]()
+    {
+        for (std::size_t t = 0; t < producers; ++t)
+            workers.push_back(std::thread(work, t));
+        for (std::size_t t = 0; t < producers; ++t)
+            workers[t].join();
+    });
+
+    return (double) (producers * perProducer) / sec / 1e6;
+}
+
+
+/** \brief Producers appending to a shared list: one append per lock against
+ *  private stages spliced in under the lock every 64 and 1024 values
+ */
+void benchStaged(std::size_t maxBytes)
+{
+    std::size_t total = std::min<std::size_t>(maxBytes / 64, 1u << 21);
+
+    std::printf("(%u hardware threads, %zu appends)\n", std::thread::hardware_concurrency(), total);
+    std::printf("%10s %14s %14s %14s   (Mappends/s)\n",
+                "producers", "locked append", "staged 64", "staged 1024");
+
+    for (std::size_t producers = 1; producers <= 8; producers *= 2)
+    {
+        std::size_t perProducer = total / producers;
+        double mappends[3];
+        {
+            Int64List lst;
+            std::mutex lock;
+            mappends[0] = produce(producers, perProducer, [&lst, &lock, perProducer](std::size_t t)
+            {
+                for (std::size_t i = 0; i < perProducer; ++i)
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    lst.appendEl((int64_t) (t * perProducer + i));
+                }
+            });
+        }
+        for (std::size_t k = 1; k < 3; ++k)
+        {
+            StagedBidiList<int64_t> lst;
+            std::size_t flushSize = k == 1 ? 64 : 1024;
+            mappends[k] = produce(producers, perProducer, [&lst, flushSize, perProducer](std::size_t t)
+            {
+                StagedBidiList<int64_t>::Stage stage(lst, flushSize);
+                for (std::size_t i = 0; i < perProducer; ++i)
+                    stage.appendEl((int64_t) (t * perProducer + i));
+            });
+        }
+
+        std::printf("%10zu %14.2f %14.2f %14.2f\n", producers, mappends[0], mappends[1], mappends[2]);
+    }
+}
+
+
+/** \brief Work queue as BidiLinkedList with its own condition variables, one
+ *  value per lock and every waiting thread woken on each change
+ */
+class CondVarQueue
+{
+public:
+    explicit CondVarQueue(std::size_t capacity) : _count(0), _capacity(capacity), _closed(false) {}
+
+    void push(int64_t val)
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        while (_count >= _capacity)
+            _notFull.wait(lock);
+        _lst.pushBack(val);
+        ++_count;
+        _notEmpty.notify_all();
+    }
+
+    bool pop(int64_t &val)
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        while (_count == 0 && !_closed)
+            _notEmpty.wait(lock);
+        if (_count == 0)
+            return false;
+
+        val = _lst.getHeadNode()->getValue();
+        _lst.popFront();
+        --_count;
+        _notFull.notify_all();
+        return true;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _closed = true;
+        _notEmpty.notify_all();
+    }
+
+protected:
+    Int64List _lst;
+    std::size_t _count;
+    std::size_t _capacity;
+    bool _closed;
+    std::mutex _lock;
+    std::condition_variable _notFull;
+    std::condition_variable _notEmpty;
+};
+
+
+/** \brief Runs \a producers threads calling `produce(t)` and as many consumers
+ *  calling `consume()`, which returns a number of values taken, until \a queue is
+ *  closed; returns Mvalues/s given \a total values
+ */
+template<typename Queue, typename Produce, typename Consume>
+double workQueue(Queue &queue, std::size_t producers, std::size_t total, Produce produce, Consume consume)
+{
+    std::atomic<std::size_t> consumed(0);
+    std::vector<std::thread> workers;
+    double sec = measureSec([&]()
+    {
+        for (std::size_t t = 0; t < producers; ++t)
+            workers.push_back(std::thread(produce, t));
+        for (std::size_t t = 0; t < producers; ++t)
+            workers.push_back(std::thread([&consumed, &consume]() { consumed += consume(); }));
+
+        for (std::size_t t = 0; t < producers; ++t)
+            workers[t].join();
+        queue.close();
+        for (std::size_t t = producers; t < workers.size(); ++t)
+            workers[t].join();
+    });
+
+    if (consumed.load() != total)
+        std::printf("lost values: %zu of %zu\n", total - consumed.load(), total);
+    return (double) total / sec / 1e6;
+}
+
+
+/** \brief Producers and as many consumers sharing a work queue of 1024 values: a
+ *  list with its own condition variables against BidiBlockingQueue, moving values
+ *  one by one and in batches of 64
+ */
+void benchBlocking(std::size_t maxBytes)
+{
+    const std::size_t CAPACITY = 1024;
+    const std::size_t BATCH = 64;
+    std::size_t total = std::min<std::size_t>(maxBytes / 64, 1u << 20);
+
+    std::printf("(%u hardware threads, %zu values)\n", std::thread::hardware_concurrency(), total);
+    std::printf("%10s %14s %14s %14s   (Mvalues/s)\n",
+                "threads", "condvar list", "queue 1-by-1", "queue batch");
+
+    for (std::size_t producers = 1; producers <= 8; producers *= 2)
+    {
+        std::size_t perProducer = total / producers;
+        std::size_t moved = perProducer * producers;
+        double mvals[3];
+        {
+            CondVarQueue queue(CAPACITY);
+            mvals[0] = workQueue(queue, producers, moved, [&queue, perProducer](std::size_t)
+            {
+                for (std::size_t i = 0; i < perProducer; ++i)
+                    queue.push((int64_t) i);
+            }, [&queue]()
+            {
+                std::size_t count = 0;
+                for (int64_t val; queue.pop(val); ++count)
+                    doNotOptimize(val);
+                return count;
+            });
+        }
+        {
+            BidiBlockingQueue<int64_t> queue(CAPACITY);
+            mvals[1] = workQueue(queue, producers, moved, [&queue, perProducer](std::size_t)
+            {
+                for (std::size_t i = 0; i < perProducer; ++i)
+                    queue.push((int64_t) i);
+            }, [&queue]()
+            {
+                std::size_t count = 0;
+                for (int64_t val; queue.pop(val); ++count)
+                    doNotOptimize(val);
+                return count;
+            });
+        }
+        {
+            BidiBlockingQueue<int64_t> queue(CAPACITY);
+            mvals[2] = workQueue(queue, producers, moved, [&queue, perProducer](std::size_t)
+            {
+                std::vector<int64_t> batch;
+                for (std::size_t i = 0; i < perProducer; ++i)
+                {
+                    batch.push_back((int64_t) i);
+                    if (batch.size() == BATCH || i == perProducer - 1)
+                    {
+                        queue.pushBatch(batch.begin(), batch.end());
+                        batch.clear();
+                    }
+                }
+            }, [&queue]()
+            {
+                std::size_t count = 0;
+                Int64List out;
+                for (std::size_t got; (got = queue.popBatch(out, 4 * BATCH)) != 0; count += got)
+                {
+                    for (int64_t val : out)
+                        doNotOptimize(val);
+                    out.clear();
+                }
+                return count;
+            });
+        }
+
+        std::printf("%10s %14.2f %14.2f %14.2f\n",
+                    (std::to_string(producers) + "+" + std::to_string(producers)).c_str(),
+                    mvals[0], mvals[1], mvals[2]);
+    }
+}
+
+
+/** \brief Returns pool sizes to measure scaling on: powers of two up to the number
+ *  of hardware threads, and that number itself
+ */
+std::vector<std::size_t> scalingThreadCounts()
+{
+    std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> res;
+    for (std::size_t threads = 1; threads <= hardware; threads *= 2)
+        res.push_back(threads);
+    if (res.back() != hardware)
+        res.push_back(hardware);
+
+    return res;
+}
+
+
+/** \brief Searches of a whole list split by checkpoints among 1 to all hardware
+ *  threads, against a single-threaded findAll()
+ */
+void benchParallel(std::size_t maxBytes)
+{
+    const int64_t DISTINCT = 1000;
+    std::size_t count = maxBytes / sizeof(Int64List::Node);
+
+    ParallelBidiList<int64_t> lst;
+    for (std::size_t i = 0; i < count; ++i)
+        lst.appendEl((int64_t) i % DISTINCT);
+
+    std::printf("(%u hardware threads, %zu nodes, %zu segments)\n",
+                std::thread::hardware_concurrency(), count, lst.getSegmentCount());
+
+    // findAll() walks the list twice, so speedups are of counting
+    int size = 0;
+    double seqFindSec = measureSec([&]()
+    {
+        delete[] lst.findAll(7, size);
+    });
+    double seqCountSec = measureSec([&]()
+    {
+        doNotOptimize(lst.count(7));
+    });
+    std::printf("%10s %14s %14s %10s\n", "threads", "findAll ms", "count ms", "speedup");
+    std::printf("%10s %14.2f %14.2f %10s\n", "sequential", seqFindSec * 1e3, seqCountSec * 1e3, "");
+
+    std::vector<std::size_t> threadCounts = scalingThreadCounts();
+    for (std::size_t t = 0; t < threadCounts.size(); ++t)
+    {
+        std::size_t threads = threadCounts[t];
+        BidiThreadPool pool(threads);
+        lst.setPool(pool);
+        double findSec = measureSec([&]()
+        {
+            delete[] lst.parallelFindAll(7, size);
+        });
+        double countSec = measureSec([&]()
+        {
+            doNotOptimize(lst.parallelCount(7));
+        });
+        std::printf("%10zu %14.2f %14.2f %10.2f\n", threads, findSec * 1e3, countSec * 1e3,
+                    seqCountSec / countSec);
+    }
+    lst.setPool(BidiThreadPool::getDefault());
+}
+
+
+/** \brief Visits, in-place transforms and sums of a whole list on 1 to all
+ *  hardware threads, against a single-threaded forEach() summing values
+ */
+void benchReduce(std::size_t maxBytes)
+{
+    std::size_t count = maxBytes / sizeof(Int64List::Node);
+
+    ParallelBidiList<int64_t> lst;
+    for (std::size_t i = 0; i < count; ++i)
+        lst.appendEl((int64_t) i);
+
+    std::printf("(%u hardware threads, %zu nodes, %zu segments)\n",
+                std::thread::hardware_concurrency(), count, lst.getSegmentCount());
+
+    double seqSec = measureSec([&]()
+    {
+        int64_t sum = 0;
+        lst.forEach([&sum](int64_t &val) { sum += val; });
+        doNotOptimize(sum);
+    });
+    std::printf("%10s %14s %14s %14s %10s\n", "threads", "forEach ms", "transform ms", "reduce ms", "speedup");
+    std::printf("%10s %14.2f %14s %14s %10s\n", "sequential", seqSec * 1e3, "", "", "");
+
+    std::vector<std::size_t> threadCounts = scalingThreadCounts();
+    for (std::size_t t = 0; t < threadCounts.size(); ++t)
+    {
+        std::size_t threads = threadCounts[t];
+        BidiThreadPool pool(threads);
+        lst.setPool(pool);
+        double forEachSec = measureSec([&]()
+        {
+            lst.parallelForEach([](const int64_t &val) { doNotOptimize(val); });
+        });
+        double transformSec = measureSec([&]()
+        {
+            lst.parallelTransform([](const int64_t &val) { return val ^ 1; });
+        });
+        double reduceSec = measureSec([&]()
+        {
+            doNotOptimize(lst.parallelReduce((int64_t) 0,
+                                             [](int64_t acc, const int64_t &val) { return acc + val; },
+                                             [](int64_t a, int64_t b) { return a + b; }));
+        });
+        std::printf("%10zu %14.2f %14.2f %14.2f %10.2f\n", threads, forEachSec * 1e3,
+                    transformSec * 1e3, reduceSec * 1e3, seqSec / reduceSec);
+    }
+    lst.setPool(BidiThreadPool::getDefault());
+}
+
+
+//==============================================================================
+// Entry point
+//==============================================================================
+
+
+/** \brief Signature of a benchmark; \a maxBytes limits the biggest workload */
+typedef void (*BenchFunc)(std::size_t maxBytes);
+
+/** \brief Describes a registered benchmark */
+struct BenchEntry
+{
+    const char *name;
+    BenchFunc func;
+};
+
+/** \brief All the benchmarks in order they are run by default */
+static const BenchEntry BENCHES[] = {
+    { "prefetch", benchPrefetch },
+    { "relinearize", benchRelinearize },
+    { "simd", benchSimd },
+    { "soa", benchSoa },
+    { "small", benchSmallList },
+    { "policy", benchPolicy },
+    { "range", benchRange },
+    { "deque", benchDeque },
+    { "reverse", benchReverse },
+    { "selforg", benchSelfOrg },
+    { "finger", benchFinger },
+    { "skip", benchSkip },
+    { "hashtags", benchHashTags },
+    { "concurrent", benchConcurrent },
+    { "combining", benchCombining },
+    { "staged", benchStaged },
+    { "blocking", benchBlocking },
+    { "parallel", benchParallel },
+    { "reduce", benchReduce },
+    { "lockfree", benchLockFree },
+    { "rcu", benchRcu },
+    { "log", benchLog },
+    { "mpsc", benchMpsc },
+};
+
+
+int main(int argc, char *argv[])
+{
+    const char *name = argc > 1 ? argv[1] : nullptr;
+    std::size_t maxBytes = (argc > 2 ? (std::size_t) std::atol(argv[2]) : 64) << 20;
+
+    bool found = false;
+    for (std::size_t i = 0; i < sizeof(BENCHES) / sizeof(BENCHES[0]); ++i)
+    {
+        if (name && std::strcmp(name, BENCHES[i].name) != 0)
+            continue;
+
+        found = true;
+        std::printf("== %s ==\n", BENCHES[i].name);
+        BENCHES[i].func(maxBytes);
+    }
+
+    if (!found)
+    {
+        std::fprintf(stderr, "unknown benchmark: %s\n", name);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the intrusive multi-producer single-consumer
+/// queue of BidiLinkedList nodes.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_MPSCQUEUE_H_
+#define XI_ENHLINKEDLIST_MPSCQUEUE_H_
+
+#include <atomic>
+#include <cstddef>      // size_t
+
+#include "bidi_linked_list.h"
+
+
+/** \brief Declares a queue handing nodes of a BidiLinkedList over from any number
+ *  of producer threads to one consumer thread
+ *
+ *  The queue is intrusive: it links the very nodes it is given through their next
+ *  links, so a node cut from a list can be pushed and a popped chain can be spliced
+ *  into a list, with no allocation on the way. It is the queue of D. Vyukov: a push
+ *  is one exchange of the back pointer followed by a release store into the former
+ *  back node's next link, so producers never wait for each other or for the
+ *  consumer. The consumer walks next links from the front and owns popped nodes.
+ *
+ *  Between its exchange and its store a producer has made its node the back one,
+ *  but not yet linked it to the queue. A pop reaching such a gap returns as if the
+ *  queue was empty, so the consumer should poll again; the node shows up as soon
+ *  as the producer makes its next step.
+ *
+ *  Nodes are pushed free (with no siblings) and popped free; a popped chain has
+ *  its previous links set. A queue with nodes left deletes them.
+ */
+template<typename T, typename Policy = DefaultBidiListPolicy>
+class BidiMpscQueue
+{
+public:
+    //-----<Types>-----
+    typedef typename BidiLinkedList<T, Policy>::Node Node;
+
+public:
+    /** \brief Default constructor */
+    BidiMpscQueue();
+
+    /** \brief Destructor; deletes nodes left in the queue */
+    ~BidiMpscQueue();
+
+    BidiMpscQueue(const BidiMpscQueue &) = delete;
+    BidiMpscQueue &operator=(const BidiMpscQueue &) = delete;
+
+public:
+    //-----<Producers>-----
+    // called from any number of threads
+
+    /** \brief Pushes a free node \a node to the back; the queue owns it then
+     *
+     *  If \a node is nullptr or has siblings and the policy is checked, an
+     *  exception is thrown.
+     */
+    void push(Node *node);
+
+    /** \brief Pushes a new node carrying \a val */
+    void push(const T &val) { push(new Node(val)); }
+
+    /** \brief Pushes a free chain `[beg, end]` linked by next links at once, so
+     *  that its nodes stay together
+     *
+     *  If \a end is nullptr, the chain is a single node \a beg. Checks are as for
+     *  push().
+     */
+    void pushChain(Node *beg, Node *end);
+
+public:
+    //-----<Consumer>-----
+    // called from one thread at a time
+
+    /** \brief Pops a front node, or returns nullptr if none is linked yet; the
+     *  popped node is free and belongs to a caller
+     */
+    Node *pop();
+
+    /** \brief Pops at most \a maxCount front nodes as a free chain `[beg, end]`
+     *  with both links set
+     *  \return a number of popped nodes; \a beg and \a end are nullptr if none
+     *
+     *  The chain fits BidiLinkedList::insertNodesAfter(node, beg, end, count).
+     */
+    std::size_t popBatch(Node *&beg, Node *&end, std::size_t maxCount = (std::size_t) -1);
+
+    /** \brief Returns whether there is no node to pop */
+    bool isEmpty() const;
+
+protected:
+    /** \brief Reads a next link of \a node published by a producer */
+    static Node *loadNext(const Node *node) { return __atomic_load_n(&node->_next, __ATOMIC_ACQUIRE); }
+
+    /** \brief Links \a next after \a node, publishing it to the consumer */
+    static void storeNext(Node *node, Node *next) { __atomic_store_n(&node->_next, next, __ATOMIC_RELEASE); }
+
+    /** \brief Checks \a beg and \a end make a free chain, see push() */
+    static void checkChain(const Node *beg, const Node *end);
+
+protected:
+    /** \brief Node pushed last; swapped by producers, and by the consumer to push the stub */
+    alignas(64) std::atomic<Node *> _back;
+
+    /** \brief Node to pop next, or the stub; the consumer only touches it */
+    alignas(64) Node *_front;
+
+    /** \brief Dummy node that keeps the queue non-empty inside, so that producers
+     *  and the consumer never race on the same pointer
+     */
+    Node _stub;
+}; // class BidiMpscQueue
+
+
+// declaration of template class template methods
+#include "bidi_mpsc_queue.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_MPSCQUEUE_H_
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the intrusive multi-producer
+/// single-consumer queue declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+
+
+//==============================================================================
+// class BidiMpscQueue<T, Policy>
+//==============================================================================
+
+
+template<typename T, typename Policy>
+BidiMpscQueue<T, Policy>::BidiMpscQueue() : _back(&_stub), _front(&_stub)
+{
+}
+
+
+template<typename T, typename Policy>
+BidiMpscQueue<T, Policy>::~BidiMpscQueue()
+{
+    while (Node *node = pop())
+        delete node;
+}
+
+
+template<typename T, typename Policy>
+void BidiMpscQueue<T, Policy>::checkChain(const Node *beg, const Node *end)
+{
+    if (beg == nullptr || end == nullptr)
+        throw std::invalid_argument("PSH NP");
+
+    // a producer owns a node it pushes, so nobody else is touching its links
+    if (beg->_prev != nullptr || end->_next != nullptr)
+        throw std::invalid_argument("PSH NP");
+}
+
+
+template<typename T, typename Policy>
+void BidiMpscQueue<T, Policy>::push(Node *node)
+{
+    pushChain(node, node);
+}
+
+
+template<typename T, typename Policy>
+void BidiMpscQueue<T, Policy>::pushChain(Node *beg, Node *end)
+{
+    if (end == nullptr)
+        end = beg;
+    if (Policy::CHECKED)
+        checkChain(beg, end);
+
+    // the chain is linked to the queue after it is the back one; until then a pop
+    // stops at the former back node
+    Node *prev = _back.exchange(end, std::memory_order_acq_rel);
+    storeNext(prev, beg);
+}
+
+
+template<typename T, typename Policy>
+typename BidiMpscQueue<T, Policy>::Node *
+BidiMpscQueue<T, Policy>::pop()
+{
+    Node *front = _front;
+    Node *next = loadNext(front);
+    if (front == &_stub)
+    {
+        if (next == nullptr)
+            return nullptr;
+
+        _front = next;
+        front = next;
+        next = loadNext(next);
+    }
+
+    if (next == nullptr)
+    {
+        // a producer is between its exchange and its store
+        if (front != _back.load(std::memory_order_acquire))
+            return nullptr;
+
+        // the front node is the back one, so the stub is pushed behind it to
+        // take its place
+        _stub._next = nullptr;
+        Node *prev = _back.exchange(&_stub, std::memory_order_acq_rel);
+        storeNext(prev, &_stub);
+
+        next = loadNext(front);
+        if (next == nullptr)
+            return nullptr;
+    }
+
+    // no producer writes to a node that has a successor
+    _front = next;
+    front->_next = nullptr;
+    front->_prev = nullptr;
+    return front;
+}
+
+
+template<typename T, typename Policy>
+std::size_t BidiMpscQueue<T, Policy>::popBatch(Node *&beg, Node *&end, std::size_t maxCount)
+{
+    beg = nullptr;
+    end = nullptr;
+    std::size_t count = 0;
+    while (count < maxCount)
+    {
+        Node *node = pop();
+        if (node == nullptr)
+            break;
+
+        if (end != nullptr)
+        {
+            end->_next = node;
+            node->_prev = end;
+        } else
+            beg = node;
+
+        end = node;
+        ++count;
+    }
+
+    return count;
+}
+
+
+template<typename T, typename Policy>
+bool BidiMpscQueue<T, Policy>::isEmpty() const
+{
+    // a real front node has not been popped yet
+    return _front == &_stub && loadNext(&_stub) == nullptr;
+}
@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the bidirectional list template that
+/// stores its first nodes inside the list object.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_SMALLLIST_H_
+#define XI_ENHLINKEDLIST_SMALLLIST_H_
+
+#include <cstdint>
+
+#include "bidi_linked_list.h"
+
+
+/** \brief Declares a BidiLinkedList with an inline buffer of \a N nodes
+ *
+ *  Nodes are created by createNode() (or appendEl()): while the buffer has a free
+ *  slot, a node comes from it, otherwise from the heap. A list of at most \a N
+ *  elements thus makes no allocations at all.
+ *
+ *  Every BidiLinkedList operation works on both kinds of nodes the same way,
+ *  and a buffered node never moves, so `Node*` pointers stay valid. The only
+ *  difference is ownership: a node cut from this list must be freed with
+ *  destroyNode() of this list instead of `delete`. A buffered node may even be
+ *  spliced into another list, as long as it is given back to this one before
+ *  this list is destroyed.
+ *
+ *  The class is not to be used through a pointer to BidiLinkedList, since
+ *  clear() and the destructor of the base class are not virtual.
+ */
+template<typename T, std::size_t N, typename Policy = DefaultBidiListPolicy>
+class BidiSmallList : public BidiLinkedList<T, Policy>
+{
+    static_assert(N > 0 && N <= 64, "the inline buffer is tracked by a 64-bit mask");
+
+public:
+    //-----<Types>-----
+    typedef BidiLinkedList<T, Policy> Base;
+    typedef typename Base::Node Node;
+
+public:
+    /** \brief Default constructor */
+    BidiSmallList() : _usedMask(0) {}
+
+    /** \brief Destructor */
+    ~BidiSmallList() { clear(); }
+
+    BidiSmallList(const BidiSmallList &) = delete;
+    BidiSmallList &operator=(const BidiSmallList &) = delete;
+
+public:
+    /** \brief Creates a free node carrying \a val, from the buffer if possible */
+    Node *createNode(const T &val);
+
+    /** \brief Frees a node created by this list, which must not be in any list */
+    void destroyNode(Node *node);
+
+    /** \brief Returns whether \a node is in the inline buffer of this list */
+    bool isInline(const Node *node) const { return node >= _inline && node < _inline + N; }
+
+    /** \brief Returns a number of buffer slots in use */
+    std::size_t getInlineCount() const { return (std::size_t) __builtin_popcountll(_usedMask); }
+
+    /** \brief Clears the list giving buffered nodes back to the buffer */
+    void clear();
+
+    /** \brief Replaces the content of the list with copies of values of a range
+     *  `[first, last)`, see BidiLinkedList::assign(); nodes left over are given back
+     *  by destroyNode() and missing ones are created by createNode()
+     */
+    template<typename InputIt>
+    void assign(InputIt first, InputIt last);
+
+    /** \brief Appends a given element (to the end) and returns a pointer to a new Node */
+    Node *appendEl(const T &val) { return this->insertNodeAfter(nullptr, createNode(val)); }
+
+    // relinearizing and the node cache would free buffered nodes with delete
+    void relinearize() = delete;
+    bool relinearizeStep(std::size_t budget) = delete;
+    void pushFront(const T &val) = delete;
+    void pushBack(const T &val) = delete;
+    T popFront() = delete;
+    T popBack() = delete;
+    std::size_t popFrontN(T *out, std::size_t n) = delete;
+
+protected:
+    Node _inline[N];            ///< Inline buffer of nodes
+    uint64_t _usedMask;         ///< Bit i is set if _inline[i] is in use
+}; // class BidiSmallList
+
+
+// declaration of template class template methods
+#include "bidi_small_list.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_SMALLLIST_H_
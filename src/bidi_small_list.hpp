@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the bidirectional list
+/// template with an inline buffer declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+
+
+//==============================================================================
+// class BidiSmallList<T, N, Policy>
+//==============================================================================
+
+
+template<typename T, std::size_t N, typename Policy>
+typename BidiSmallList<T, N, Policy>::Node *
+BidiSmallList<T, N, Policy>::createNode(const T &val)
+{
+    uint64_t freeMask = ~_usedMask & (N == 64 ? ~(uint64_t) 0 : (((uint64_t) 1 << N) - 1));
+    if (freeMask == 0)
+        return new Node(val);
+
+    std::size_t slot = (std::size_t) __builtin_ctzll(freeMask);
+    _usedMask |= (uint64_t) 1 << slot;
+    Base::renewNode(&_inline[slot], val);
+    return &_inline[slot];
+}
+
+
+template<typename T, std::size_t N, typename Policy>
+void BidiSmallList<T, N, Policy>::destroyNode(Node *node)
+{
+    if (Policy::CHECKED && !this->checkChain(node, node, "DN NP"))
+        return;
+
+    if (!isInline(node))
+    {
+        delete node;
+        return;
+    }
+
+    // keep no resources of a value in an idle slot
+    node->setValue(T());
+    _usedMask &= ~((uint64_t) 1 << (node - _inline));
+}
+
+
+template<typename T, std::size_t N, typename Policy>
+void BidiSmallList<T, N, Policy>::clear()
+{
+    while (Node *node = this->getHeadNode())
+        destroyNode(this->cutNode(node));
+}
+
+
+template<typename T, std::size_t N, typename Policy>
+template<typename InputIt>
+void BidiSmallList<T, N, Policy>::assign(InputIt first, InputIt last)
+{
+    // reuse existing nodes first
+    Node *node = this->getHeadNode();
+    for (; node != nullptr && first != last; node = this->getNextNode(node), ++first)
+        Base::renewNode(node, *first);
+
+    if (node != nullptr)
+    {
+        // the list is longer than the range: drop the rest from the tail on
+        Node *stop = this->getPrevNode(node);
+        while (this->getLastNode() != stop)
+            destroyNode(this->cutNode(this->getLastNode()));
+    } else
+    {
+        for (; first != last; ++first)
+            appendEl(*first);
+    }
+}
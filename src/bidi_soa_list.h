@@ -0,0 +1,343 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the bidirectional list template with
+/// structure-of-arrays storage.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_SOALIST_H_
+#define XI_ENHLINKEDLIST_SOALIST_H_
+
+#include <cstddef>      // size_t
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "simd_search.h"
+
+
+/** \brief Declares a bidirectional list that stores values and links in separate
+ *  parallel arrays
+ *
+ *  A node is a slot, identified by a Handle, that is an index into both arrays.
+ *  All the values of the list lie in one dense array, so value-only passes
+ *  (sum(), count(), contains(), transform()) stream contiguous memory and, for
+ *  arithmetic `T`, use SimdSearch kernels. Structural operations touch the link
+ *  array only and mirror those of BidiLinkedList, with handles in place of
+ *  `Node*`.
+ *
+ *  Like a `Node*` cut from a BidiLinkedList, a cut node stays allocated (its slot
+ *  is *detached*) until it is inserted back or destroyed with destroyNode().
+ *  Value passes skip slots that are not in the list. While every slot is in the
+ *  list or slots follow list order (see isOrdered()), they run over a prefix of
+ *  the value array without any per-element checks.
+ *
+ *  Iterators walk values in list order, as those of BidiLinkedList do. Since
+ *  values live in a vector, creating a node may move them, so iterators and
+ *  references to values are invalidated by createNode() (and appendEl()), while
+ *  handles stay valid.
+ *
+ *  **Requirements to a `T`** are the same as for BidiLinkedList.
+ */
+template<typename T>
+class BidiSoaList
+{
+public:
+    //-----<Types>-----
+    /** \brief Handle of a node, which is its slot index */
+    typedef uint32_t Handle;
+
+    //-----<Consts>------
+    /** \brief Handle value that refers to no node, like nullptr does for `Node*` */
+    static const Handle NO_NODE = (Handle) -1;
+
+    //-----<Types>-----
+    /** \brief Bidirectional iterator over values in list order; \a Const selects a
+     *  constant one
+     *
+     *  As for BidiLinkedList iterators, decrementing end() gives the last element.
+     */
+    template<bool Const>
+    class Iterator
+    {
+        friend class BidiSoaList;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<Const, const T *, T *>::type pointer;
+        typedef typename std::conditional<Const, const T &, T &>::type reference;
+        typedef typename std::conditional<Const, const BidiSoaList *, BidiSoaList *>::type ListPtr;
+
+    public:
+        Iterator() : _list(nullptr), _node(NO_NODE) {}
+
+        /** \brief Converts an iterator to a constant one */
+        operator Iterator<true>() const { return Iterator<true>(_list, _node); }
+
+        reference operator*() const { return _list->_vals[_node]; }
+        pointer operator->() const { return &_list->_vals[_node]; }
+
+        /** \brief Returns a handle of the current node, NO_NODE for end() */
+        Handle getHandle() const { return _node; }
+
+        Iterator &operator++()
+        {
+            _node = _list->getNext(_node);
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        Iterator &operator--()
+        {
+            _node = _node != NO_NODE ? _list->getPrev(_node) : _list->_tail;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator tmp(*this);
+            --*this;
+            return tmp;
+        }
+
+        bool operator==(const Iterator &obj) const { return _node == obj._node; }
+        bool operator!=(const Iterator &obj) const { return _node != obj._node; }
+
+    protected:
+        Iterator(ListPtr list, Handle node) : _list(list), _node(node) {}
+
+    protected:
+        ListPtr _list;              ///< Owner, needed to reach values and links
+        Handle _node;               ///< Current node; NO_NODE for end()
+    }; // class Iterator
+
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+public:
+    /** \brief Default constructor */
+    BidiSoaList() : _head(NO_NODE), _tail(NO_NODE), _free(NO_NODE), _size(0), _ordered(true) {}
+
+public:
+    /** \brief Allocates a free node carrying \a val; it is to be inserted or destroyed */
+    Handle createNode(const T &val);
+
+    /** \brief Releases a slot of a node that is not in the list
+     *
+     *  If \a node is in the list or is already destroyed, an exception is thrown.
+     */
+    void destroyNode(Handle node);
+
+    /** \brief Clears the list and releases all the slots, detached ones included */
+    void clear();
+
+    /** \brief Appends a given element (to the end) and returns a handle of a new node */
+    Handle appendEl(const T &val) { return insertNodeAfter(NO_NODE, createNode(val)); }
+
+    /** \brief Inserts a free node \a insNode after \a node, see BidiLinkedList::insertNodeAfter() */
+    Handle insertNodeAfter(Handle node, Handle insNode)
+    {
+        insertNodesAfter(node, insNode, insNode);
+        return insNode;
+    }
+
+    /** \brief Inserts a free chain `[beg, end]` after \a node, see BidiLinkedList::insertNodesAfter()
+     *
+     *  Costs O(k) for a chain of k nodes, since their slots are marked as used by the list.
+     */
+    void insertNodesAfter(Handle node, Handle beg, Handle end);
+
+    /** \brief Inserts a free node \a insNode before \a node, see BidiLinkedList::insertNodeBefore() */
+    Handle insertNodeBefore(Handle node, Handle insNode)
+    {
+        insertNodesBefore(node, insNode, insNode);
+        return insNode;
+    }
+
+    /** \brief Inserts a free chain `[beg, end]` before \a node, see BidiLinkedList::insertNodesBefore() */
+    void insertNodesBefore(Handle node, Handle beg, Handle end);
+
+    /** \brief Cuts a chain `[beg, end]` from the list; see BidiLinkedList::cutNodes()
+     *
+     *  If the chain is not a part of the list, an exception is thrown.
+     */
+    void cutNodes(Handle beg, Handle end);
+
+    /** \brief Cuts a given node from the list and returns it */
+    Handle cutNode(Handle node)
+    {
+        cutNodes(node, node);
+        return node;
+    }
+
+public:
+    /** \brief Finds first node carrying \a val in list order, starting from \a startFrom;
+     *  returns NO_NODE if nothing is found
+     */
+    Handle findFirst(Handle startFrom, const T &val) const;
+
+    /** \brief Overloaded version of findFirst(): searching in the entire list
+     *
+     *  While slots follow list order (see isOrdered()), the search is a plain
+     *  array scan.
+     */
+    Handle findFirst(const T &val) const;
+
+    /** \brief Finds all the nodes carrying \a val from \a startFrom on, in list order
+     *
+     *  Returns a newly created array that should be freed by caller, or nullptr if
+     *  nothing is found, like BidiLinkedList::findAll() does.
+     */
+    Handle *findAll(Handle startFrom, const T &val, int &size) const;
+
+    /** \brief Overloaded version of findAll(): searching in the entire list */
+    Handle *findAll(const T &val, int &size) const { return findAll(_head, val, size); }
+
+    /** \brief Cuts first node carrying \a val and returns it, or NO_NODE */
+    Handle cutFirst(const T &val)
+    {
+        Handle res = findFirst(val);
+        return res != NO_NODE ? cutNode(res) : NO_NODE;
+    }
+
+    /** \brief Cuts all the nodes carrying \a val and returns an array of them */
+    Handle *cutAll(Handle startFrom, const T &val, int &size);
+
+    /** \brief Overloaded version of cutAll(): searching in the entire list */
+    Handle *cutAll(const T &val, int &size) { return cutAll(_head, val, size); }
+
+public:
+    //-----<Value-only passes>-----
+
+    /** \brief Returns a number of list nodes carrying \a val */
+    std::size_t count(const T &val) const;
+
+    /** \brief Returns whether any list node carries \a val */
+    bool contains(const T &val) const { return count(val) != 0; }
+
+    /** \brief Returns a sum of all the list values, starting from `T()` */
+    T sum() const;
+
+    /** \brief Replaces every list value `v` with `func(v)` in slot order */
+    template<typename Func>
+    void transform(Func func);
+
+    /** \brief Renumbers slots to follow list order and drops released ones
+     *
+     *  **All the handles obtained before are invalidated.** If there are detached
+     *  nodes, whose handles are held by a caller, an exception is thrown.
+     */
+    void compact();
+
+    /** \brief Returns whether slot `i` holds the `i`-th node of the list for every `i`
+     *  less than the size of the list
+     *
+     *  Appending keeps slots ordered, other insertions and cuts (except cutting
+     *  a tail) break the order until compact() is called.
+     */
+    bool isOrdered() const { return _ordered; }
+
+public:
+    /** \brief Returns a handle of the next node, or NO_NODE */
+    Handle getNext(Handle node) const { return _links[node].next; }
+
+    /** \brief Returns a handle of the previous node, or NO_NODE */
+    Handle getPrev(Handle node) const { return _links[node].prev; }
+
+    /** \brief Returns node's value */
+    const T &getValue(Handle node) const { return _vals[node]; }
+
+    /** \brief Sets a new value carried by the node */
+    void setValue(Handle node, const T &newVal) { _vals[node] = newVal; }
+
+    /** \brief Returns a lists's head */
+    Handle getHeadNode() const { return _head; }
+
+    /** \brief Returns a last node */
+    Handle getLastNode() const { return _tail; }
+
+    /** \brief Returns a number of nodes in the list */
+    std::size_t getSize() const { return _size; }
+
+    iterator begin() { return iterator(this, _head); }
+    iterator end() { return iterator(this, NO_NODE); }
+    const_iterator begin() const { return const_iterator(this, _head); }
+    const_iterator end() const { return const_iterator(this, NO_NODE); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const { return rbegin(); }
+    const_reverse_iterator crend() const { return rend(); }
+
+protected:
+    //-----<Types>-----
+    /** \brief Links of a node, kept apart from its value */
+    struct Links
+    {
+        Handle next;
+        Handle prev;
+    };
+
+    /** \brief States of a slot */
+    enum SlotState
+    {
+        SLOT_LINKED,        ///< the node is in the list
+        SLOT_DETACHED,      ///< the node is allocated, but not in the list
+        SLOT_RELEASED       ///< the slot is in the free list
+    };
+
+protected:
+    /** \brief Checks a chain is free and marks its nodes as linked
+     *  \param appended whether the chain goes to the end of the list
+     */
+    void attachChain(Handle beg, Handle end, bool appended);
+
+    /** \brief Returns whether the first getSize() slots hold exactly the list values,
+     *  so value passes may scan them without checks
+     */
+    bool denseValues() const { return _ordered || _vals.size() == _size; }
+
+    /** \brief Invokes `visit(slot)` for every linked slot in slot order */
+    template<typename Visitor>
+    void forEachLinkedSlot(Visitor visit) const;
+
+protected:
+    std::vector<T> _vals;                   ///< Values of all the slots
+    std::vector<Links> _links;              ///< Links of all the slots
+    std::vector<unsigned char> _states;     ///< SlotState of all the slots
+
+    Handle _head;               ///< First node of the list
+    Handle _tail;               ///< Last node of the list
+    Handle _free;               ///< First released slot; released slots are chained by next links
+    std::size_t _size;          ///< Number of linked nodes
+    bool _ordered;              ///< Whether slots follow list order without gaps
+}; // class BidiSoaList
+
+
+// declaration of template class template methods
+#include "bidi_soa_list.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_SOALIST_H_
@@ -0,0 +1,378 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the bidirectional list
+/// template with structure-of-arrays storage declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+
+
+//==============================================================================
+// class BidiSoaList<T>
+//==============================================================================
+
+
+template<typename T>
+const typename BidiSoaList<T>::Handle BidiSoaList<T>::NO_NODE;
+
+
+template<typename T>
+typename BidiSoaList<T>::Handle
+BidiSoaList<T>::createNode(const T &val)
+{
+    Handle node = _free;
+    if (node != NO_NODE)
+    {
+        _free = _links[node].next;
+        _vals[node] = val;
+    } else
+    {
+        if (_vals.size() >= (std::size_t) NO_NODE)
+            throw std::length_error("SOA FULL");
+
+        node = (Handle) _vals.size();
+        _vals.push_back(val);
+        _links.push_back(Links());
+        _states.push_back(SLOT_RELEASED);
+    }
+
+    _links[node].next = NO_NODE;
+    _links[node].prev = NO_NODE;
+    _states[node] = SLOT_DETACHED;
+    return node;
+}
+
+
+template<typename T>
+void BidiSoaList<T>::destroyNode(Handle node)
+{
+    if (node >= _vals.size() || _states[node] != SLOT_DETACHED)
+        throw std::invalid_argument("DN");
+
+    _vals[node] = T();
+    _links[node].next = _free;
+    _links[node].prev = NO_NODE;
+    _states[node] = SLOT_RELEASED;
+    _free = node;
+}
+
+
+template<typename T>
+void BidiSoaList<T>::clear()
+{
+    _vals.clear();
+    _links.clear();
+    _states.clear();
+    _head = NO_NODE;
+    _tail = NO_NODE;
+    _free = NO_NODE;
+    _size = 0;
+    _ordered = true;
+}
+
+
+template<typename T>
+void BidiSoaList<T>::attachChain(Handle beg, Handle end, bool appended)
+{
+    if (beg >= _vals.size() || end >= _vals.size()
+            || _links[beg].prev != NO_NODE || _links[end].next != NO_NODE)
+        throw std::invalid_argument("INA");
+
+    for (Handle node = beg; ; node = _links[node].next)
+    {
+        if (node == NO_NODE || _states[node] != SLOT_DETACHED)
+            throw std::invalid_argument("INA NP");
+        if (node == end)
+            break;
+    }
+
+    // appending slots _size, _size + 1, ... in chain order keeps slots ordered
+    bool ordered = _ordered && appended;
+    for (Handle node = beg; ; node = _links[node].next)
+    {
+        ordered = ordered && node == _size;
+        _states[node] = SLOT_LINKED;
+        ++_size;
+        if (node == end)
+            break;
+    }
+    _ordered = ordered;
+}
+
+
+template<typename T>
+void BidiSoaList<T>::insertNodesAfter(Handle node, Handle beg, Handle end)
+{
+    if (node == NO_NODE)
+        node = _tail;
+
+    attachChain(beg, end, node == _tail);
+
+    if (node == NO_NODE)
+    {
+        _head = beg;
+        _tail = end;
+        return;
+    }
+
+    Handle after = _links[node].next;
+    _links[end].next = after;
+    _links[beg].prev = node;
+    _links[node].next = beg;
+    if (after != NO_NODE)
+        _links[after].prev = end;
+    else
+        _tail = end;
+}
+
+
+template<typename T>
+void BidiSoaList<T>::insertNodesBefore(Handle node, Handle beg, Handle end)
+{
+    if (node == NO_NODE)
+        node = _head;
+
+    attachChain(beg, end, node == NO_NODE);
+
+    if (node == NO_NODE)
+    {
+        _head = beg;
+        _tail = end;
+        return;
+    }
+
+    Handle before = _links[node].prev;
+    _links[beg].prev = before;
+    _links[end].next = node;
+    _links[node].prev = end;
+    if (before != NO_NODE)
+        _links[before].next = beg;
+    else
+        _head = beg;
+}
+
+
+template<typename T>
+void BidiSoaList<T>::cutNodes(Handle beg, Handle end)
+{
+    if (beg >= _vals.size() || end >= _vals.size())
+        throw std::invalid_argument("CNS");
+
+    // the chain is checked as a whole before anything is changed
+    for (Handle node = beg; ; node = _links[node].next)
+    {
+        if (node == NO_NODE || _states[node] != SLOT_LINKED)
+            throw std::invalid_argument("CNS NP");
+        if (node == end)
+            break;
+    }
+
+    // cutting a tail keeps the rest of slots ordered
+    _ordered = _ordered && end == _tail;
+
+    for (Handle node = beg; ; node = _links[node].next)
+    {
+        _states[node] = SLOT_DETACHED;
+        --_size;
+        if (node == end)
+            break;
+    }
+
+    Handle before = _links[beg].prev;
+    Handle after = _links[end].next;
+    if (before != NO_NODE)
+        _links[before].next = after;
+    else
+        _head = after;
+
+    if (after != NO_NODE)
+        _links[after].prev = before;
+    else
+        _tail = before;
+
+    _links[beg].prev = NO_NODE;
+    _links[end].next = NO_NODE;
+}
+
+
+template<typename T>
+typename BidiSoaList<T>::Handle
+BidiSoaList<T>::findFirst(Handle startFrom, const T &val) const
+{
+    for (Handle node = startFrom; node != NO_NODE; node = _links[node].next)
+    {
+        if (_vals[node] == val)
+            return node;
+    }
+
+    return NO_NODE;
+}
+
+
+template<typename T>
+typename BidiSoaList<T>::Handle
+BidiSoaList<T>::findFirst(const T &val) const
+{
+    if (!_ordered)
+        return findFirst(_head, val);
+
+    std::size_t found = SimdSearch<T>::findFirst(_vals.data(), _size, val);
+    return found == _size ? NO_NODE : (Handle) found;
+}
+
+
+template<typename T>
+typename BidiSoaList<T>::Handle *
+BidiSoaList<T>::findAll(Handle startFrom, const T &val, int &size) const
+{
+    if (startFrom == NO_NODE)
+        return nullptr;
+
+    if (_ordered && startFrom == _head)
+    {
+        size = (int) SimdSearch<T>::count(_vals.data(), _size, val);
+        if (size == 0)
+            return nullptr;
+
+        std::size_t *found = new std::size_t[size];
+        SimdSearch<T>::findAll(_vals.data(), _size, val, found);
+
+        Handle *res = new Handle[size];
+        for (int i = 0; i < size; ++i)
+            res[i] = (Handle) found[i];
+
+        delete[] found;
+        return res;
+    }
+
+    size = 0;
+    for (Handle node = startFrom; node != NO_NODE; node = _links[node].next)
+    {
+        if (_vals[node] == val)
+            ++size;
+    }
+
+    if (size == 0)
+        return nullptr;
+
+    Handle *res = new Handle[size];
+    int i = 0;
+    for (Handle node = startFrom; node != NO_NODE; node = _links[node].next)
+    {
+        if (_vals[node] == val)
+            res[i++] = node;
+    }
+
+    return res;
+}
+
+
+template<typename T>
+typename BidiSoaList<T>::Handle *
+BidiSoaList<T>::cutAll(Handle startFrom, const T &val, int &size)
+{
+    Handle *res = findAll(startFrom, val, size);
+    for (int i = 0; res && i < size; ++i)
+        cutNode(res[i]);
+
+    return res;
+}
+
+
+template<typename T>
+std::size_t BidiSoaList<T>::count(const T &val) const
+{
+    if (denseValues())
+        return SimdSearch<T>::count(_vals.data(), _size, val);
+
+    std::size_t res = 0;
+    forEachLinkedSlot([this, &val, &res](Handle slot)
+    {
+        if (_vals[slot] == val)
+            ++res;
+    });
+    return res;
+}
+
+
+template<typename T>
+T BidiSoaList<T>::sum() const
+{
+    T res = T();
+    if (denseValues())
+    {
+        for (std::size_t i = 0; i < _size; ++i)
+            res += _vals[i];
+        return res;
+    }
+
+    forEachLinkedSlot([this, &res](Handle slot) { res += _vals[slot]; });
+    return res;
+}
+
+
+template<typename T>
+template<typename Func>
+void BidiSoaList<T>::transform(Func func)
+{
+    if (denseValues())
+    {
+        for (std::size_t i = 0; i < _size; ++i)
+            _vals[i] = func(_vals[i]);
+        return;
+    }
+
+    forEachLinkedSlot([this, &func](Handle slot) { _vals[slot] = func(_vals[slot]); });
+}
+
+
+template<typename T>
+template<typename Visitor>
+void BidiSoaList<T>::forEachLinkedSlot(Visitor visit) const
+{
+    for (std::size_t i = 0; i < _states.size(); ++i)
+    {
+        if (_states[i] == SLOT_LINKED)
+            visit((Handle) i);
+    }
+}
+
+
+template<typename T>
+void BidiSoaList<T>::compact()
+{
+    for (std::size_t i = 0; i < _states.size(); ++i)
+    {
+        if (_states[i] == SLOT_DETACHED)
+            throw std::logic_error("COMPACT DETACHED");
+    }
+
+    std::vector<T> vals;
+    vals.reserve(_size);
+    for (Handle node = _head; node != NO_NODE; node = _links[node].next)
+        vals.push_back(_vals[node]);
+
+    std::vector<Links> links(_size);
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+        links[i].prev = i > 0 ? (Handle) (i - 1) : NO_NODE;
+        links[i].next = i + 1 < _size ? (Handle) (i + 1) : NO_NODE;
+    }
+
+    _vals.swap(vals);
+    _links.swap(links);
+    _states.assign(_size, SLOT_LINKED);
+    _head = _size ? 0 : NO_NODE;
+    _tail = _size ? (Handle) (_size - 1) : NO_NODE;
+    _free = NO_NODE;
+    _ordered = true;
+}
@@ -0,0 +1,313 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the fixed-capacity bidirectional list
+/// template that keeps its nodes inside the list object.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_STATICLIST_H_
+#define XI_ENHLINKEDLIST_STATICLIST_H_
+
+#include <cstddef>      // size_t
+#include <iterator>
+#include <type_traits>
+
+
+/** \brief Declares a bidirectional list of at most \a N elements that never
+ *  touches the heap
+ *
+ *  Nodes live in an array inside the list object. A node is taken from the
+ *  array by acquireNode() (or appendEl()) and returned by releaseNode(); in
+ *  between it is inserted, cut and spliced exactly like a BidiLinkedList node,
+ *  with O(1) splicing. Nodes of one list must not be inserted into another one.
+ *
+ *  No method throws: running out of capacity and invalid arguments are reported
+ *  by nullptr or false results. Since nodes point to each other, the list can be
+ *  neither copied nor moved.
+ *
+ *  The constructor is `constexpr` for literal `T`, so a list can be constant
+ *  initialized as a global. C++11 allows no mutations in constant expressions,
+ *  thus other `constexpr` members are the observers only.
+ *
+ *  **Requirements to a `T`** are the same as for BidiLinkedList.
+ */
+template<typename T, std::size_t N>
+class BidiStaticList
+{
+public:
+    //-----<Consts>------
+    /** \brief Determines a value for case when a size has not been still calculated */
+    static const std::size_t NO_SIZE = (std::size_t) -1;
+
+public:
+    //-----<Types>-----
+
+    /** \brief Node of a static list, see BidiLinkedList::Node */
+    class Node
+    {
+        friend class BidiStaticList;
+
+    public:
+        /** \brief Default constructor */
+        constexpr Node() : _val(), _next(nullptr), _prev(nullptr), _acquired(false) {}
+
+    public:
+        /** \brief Returns a pointer to a previous element */
+        Node *getPrev() const { return _prev; }
+
+        /** \brief Returns a pointer to a next element */
+        Node *getNext() const { return _next; }
+
+        /** \brief Returns node's value */
+        T &getValue() { return _val; }
+
+        /** \brief const overloaded verson of getValue() */
+        const T &getValue() const { return _val; }
+
+        /** \brief Sets a new value carried by the node */
+        void setValue(const T &newVal) { _val = newVal; }
+
+    protected:
+        T _val;                 ///< Storage a value
+        Node *_next;            ///< Next element; in the free list, next free node
+        Node *_prev;            ///< Previous element. nullptr, if no one presented
+        bool _acquired;         ///< Whether the node is taken from storage
+    }; // class Node
+
+
+    /** \brief Bidirectional iterator; \a Const selects a constant one
+     *
+     *  As for BidiLinkedList iterators, decrementing end() gives the last element.
+     */
+    template<bool Const>
+    class Iterator
+    {
+        friend class BidiStaticList;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<Const, const T *, T *>::type pointer;
+        typedef typename std::conditional<Const, const T &, T &>::type reference;
+
+    public:
+        Iterator() : _list(nullptr), _node(nullptr) {}
+
+        reference operator*() const { return _node->getValue(); }
+        pointer operator->() const { return &_node->getValue(); }
+
+        Iterator &operator++()
+        {
+            _node = _node->getNext();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        Iterator &operator--()
+        {
+            _node = _node ? _node->getPrev() : _list->_tail;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator tmp(*this);
+            --*this;
+            return tmp;
+        }
+
+        bool operator==(const Iterator &obj) const { return _node == obj._node; }
+        bool operator!=(const Iterator &obj) const { return _node != obj._node; }
+
+    protected:
+        Iterator(const BidiStaticList *list, Node *node) : _list(list), _node(node) {}
+
+    protected:
+        const BidiStaticList *_list;    ///< Owner, needed to step back from end()
+        Node *_node;                    ///< Current node; nullptr for end()
+    }; // class Iterator
+
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+public:
+    /** \brief Default constructor */
+    constexpr BidiStaticList()
+        : _nodes(), _head(nullptr), _tail(nullptr), _free(nullptr), _untouched(0), _used(0),
+          _size(0) {}
+
+    BidiStaticList(const BidiStaticList &) = delete;
+    BidiStaticList &operator=(const BidiStaticList &) = delete;
+
+public:
+    //-----<Storage>-----
+
+    /** \brief Returns a maximum number of nodes */
+    static constexpr std::size_t capacity() { return N; }
+
+    /** \brief Returns a number of nodes taken from storage, linked or not */
+    constexpr std::size_t getUsedCount() const { return _used; }
+
+    /** \brief Takes a free node carrying \a val from storage; returns nullptr if
+     *  the storage is exhausted
+     */
+    Node *acquireNode(const T &val);
+
+    /** \brief Returns a node that is not in the list back to storage
+     *
+     *  Returns false if \a node is not from storage of this list, is still linked
+     *  or has been released already.
+     */
+    bool releaseNode(Node *node);
+
+    /** \brief Releases all the nodes */
+    void clear();
+
+public:
+    //-----<Structure>-----
+
+    /** \brief Appends a given element; returns nullptr if the storage is exhausted */
+    Node *appendEl(const T &val);
+
+    /** \brief Inserts a free node \a insNode after \a node, see BidiLinkedList::insertNodeAfter()
+     *
+     *  Returns nullptr if \a insNode is nullptr or is not a free node acquired from
+     *  this list.
+     */
+    Node *insertNodeAfter(Node *node, Node *insNode)
+    {
+        return insertNodesAfter(node, insNode, insNode) ? insNode : nullptr;
+    }
+
+    /** \brief Inserts a free chain after \a node, see BidiLinkedList::insertNodesAfter()
+     *
+     *  Returns false if the chain is not free or its ends are not acquired from this
+     *  list.
+     */
+    bool insertNodesAfter(Node *node, Node *beg, Node *end);
+
+    /** \brief Inserts a free node \a insNode before \a node, see BidiLinkedList::insertNodeBefore() */
+    Node *insertNodeBefore(Node *node, Node *insNode)
+    {
+        return insertNodesBefore(node, insNode, insNode) ? insNode : nullptr;
+    }
+
+    /** \brief Inserts a free chain before \a node, see BidiLinkedList::insertNodesBefore() */
+    bool insertNodesBefore(Node *node, Node *beg, Node *end);
+
+    /** \brief Cuts a chain from the list, see BidiLinkedList::cutNodes()
+     *
+     *  Returns false if either \a beg or \a end is not a linked node of this list.
+     */
+    bool cutNodes(Node *beg, Node *end);
+
+    /** \brief Cuts a given node from the list and returns it, or nullptr for nullptr */
+    Node *cutNode(Node *node) { return cutNodes(node, node) ? node : nullptr; }
+
+public:
+    //-----<Search>-----
+
+    /** \brief Finds first node carrying \a val starting from \a startFrom, or nullptr */
+    Node *findFirst(Node *startFrom, const T &val) const;
+
+    /** \brief Overloaded version of findFirst(): searching in the entire list */
+    Node *findFirst(const T &val) const { return findFirst(_head, val); }
+
+    /** \brief Writes at most \a maxOut nodes carrying \a val to \a out
+     *  \return a number of nodes written
+     *
+     *  Unlike BidiLinkedList::findAll(), a caller provides the array.
+     */
+    std::size_t findAll(Node *startFrom, const T &val, Node **out, std::size_t maxOut) const;
+
+    /** \brief Cuts at most \a maxOut nodes carrying \a val and writes them to \a out */
+    std::size_t cutAll(Node *startFrom, const T &val, Node **out, std::size_t maxOut);
+
+    /** \brief Looking for a node with value \a val and cuts it from the list */
+    Node *cutFirst(const T &val)
+    {
+        Node *res = findFirst(val);
+        return res ? cutNode(res) : nullptr;
+    }
+
+public:
+    //-----<Access>-----
+
+    /** \brief Returns a lists's head */
+    constexpr Node *getHeadNode() const { return _head; }
+
+    /** \brief Returns a pointer to a last node */
+    constexpr Node *getLastNode() const { return _tail; }
+
+    /** \brief Returns whether the list is empty */
+    constexpr bool isEmpty() const { return _head == nullptr; }
+
+    /** \brief Returns a size of a list, counting it if it was invalidated by a splice */
+    std::size_t getSize();
+
+    iterator begin() { return iterator(this, _head); }
+    iterator end() { return iterator(this, nullptr); }
+    const_iterator begin() const { return const_iterator(this, _head); }
+    const_iterator end() const { return const_iterator(this, nullptr); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
+
+protected:
+    /** \brief Returns whether \a node belongs to storage of this list */
+    bool owns(const Node *node) const { return node >= _nodes && node < _nodes + N; }
+
+    /** \brief Returns whether \a beg and \a end are both acquired from this list and
+     *  linked into it
+     */
+    bool isLinkedChain(const Node *beg, const Node *end) const
+    {
+        return owns(beg) && owns(end) && beg->_acquired && end->_acquired
+            && (beg->_prev != nullptr || beg == _head) && (end->_next != nullptr || end == _tail);
+    }
+
+    /** \brief Returns whether a chain from \a beg to \a end can be inserted: both
+     *  ends are acquired from this list and the chain is linked to nothing
+     */
+    bool isFreeChain(const Node *beg, const Node *end) const
+    {
+        return owns(beg) && owns(end) && beg->_acquired && end->_acquired
+            && beg->_prev == nullptr && end->_next == nullptr && beg != _head;
+    }
+
+protected:
+    Node _nodes[N];             ///< Storage of nodes
+    Node *_head;                ///< Pointer to a first element of a list
+    Node *_tail;                ///< Pointer to the last element of the list
+    Node *_free;                ///< Released nodes, chained by next links
+    std::size_t _untouched;     ///< Nodes [_untouched, N) have never been acquired
+    std::size_t _used;          ///< Number of acquired nodes
+    std::size_t _size;          ///< Cached size of the list or NO_SIZE
+}; // class BidiStaticList
+
+
+// declaration of template class template methods
+#include "bidi_static_list.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_STATICLIST_H_
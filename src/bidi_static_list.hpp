@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the fixed-capacity
+/// bidirectional list template declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+//==============================================================================
+// class BidiStaticList<T, N>
+//==============================================================================
+
+
+template<typename T, std::size_t N>
+typename BidiStaticList<T, N>::Node *
+BidiStaticList<T, N>::acquireNode(const T &val)
+{
+    Node *node = _free;
+    if (node != nullptr)
+        _free = node->_next;
+    else if (_untouched < N)
+        node = &_nodes[_untouched++];
+    else
+        return nullptr;
+
+    node->_val = val;
+    node->_next = nullptr;
+    node->_prev = nullptr;
+    node->_acquired = true;
+    ++_used;
+    return node;
+}
+
+
+template<typename T, std::size_t N>
+bool BidiStaticList<T, N>::releaseNode(Node *node)
+{
+    // a linked node has a neighbour or is the head of a list of one
+    if (!owns(node) || !node->_acquired || node->_prev != nullptr || node->_next != nullptr
+        || node == _head)
+        return false;
+
+    node->_val = T();
+    node->_acquired = false;
+    node->_prev = nullptr;
+    node->_next = _free;
+    _free = node;
+    --_used;
+    return true;
+}
+
+
+template<typename T, std::size_t N>
+void BidiStaticList<T, N>::clear()
+{
+    for (std::size_t i = 0; i < _untouched; ++i)
+        _nodes[i] = Node();
+
+    _head = nullptr;
+    _tail = nullptr;
+    _free = nullptr;
+    _untouched = 0;
+    _used = 0;
+    _size = 0;
+}
+
+
+template<typename T, std::size_t N>
+typename BidiStaticList<T, N>::Node *
+BidiStaticList<T, N>::appendEl(const T &val)
+{
+    Node *node = acquireNode(val);
+    if (node == nullptr)
+        return nullptr;
+
+    return insertNodeAfter(_tail, node);
+}
+
+
+template<typename T, std::size_t N>
+bool BidiStaticList<T, N>::insertNodesAfter(Node *node, Node *beg, Node *end)
+{
+    if (!isFreeChain(beg, end))
+        return false;
+
+    if (node == nullptr)
+        node = _tail;
+
+    if (node == nullptr)
+    {
+        _head = beg;
+        _tail = end;
+    } else
+    {
+        end->_next = node->_next;
+        beg->_prev = node;
+        if (node->_next)
+            node->_next->_prev = end;
+        else
+            _tail = end;
+        node->_next = beg;
+    }
+
+    // a single node keeps the cache valid, a chain has an unknown length
+    if (beg == end && _size != NO_SIZE)
+        ++_size;
+    else
+        _size = NO_SIZE;
+    return true;
+}
+
+
+template<typename T, std::size_t N>
+bool BidiStaticList<T, N>::insertNodesBefore(Node *node, Node *beg, Node *end)
+{
+    if (!isFreeChain(beg, end))
+        return false;
+
+    if (node == nullptr)
+        node = _head;
+
+    if (node == nullptr)
+        return insertNodesAfter(nullptr, beg, end);
+
+    beg->_prev = node->_prev;
+    end->_next = node;
+    if (node->_prev)
+        node->_prev->_next = beg;
+    else
+        _head = beg;
+    node->_prev = end;
+
+    if (beg == end && _size != NO_SIZE)
+        ++_size;
+    else
+        _size = NO_SIZE;
+    return true;
+}
+
+
+template<typename T, std::size_t N>
+bool BidiStaticList<T, N>::cutNodes(Node *beg, Node *end)
+{
+    if (!isLinkedChain(beg, end))
+        return false;
+
+    if (beg->_prev)
+        beg->_prev->_next = end->_next;
+    else
+        _head = end->_next;
+
+    if (end->_next)
+        end->_next->_prev = beg->_prev;
+    else
+        _tail = beg->_prev;
+
+    beg->_prev = nullptr;
+    end->_next = nullptr;
+
+    if (beg == end && _size != NO_SIZE)
+        --_size;
+    else
+        _size = NO_SIZE;
+    return true;
+}
+
+
+template<typename T, std::size_t N>
+typename BidiStaticList<T, N>::Node *
+BidiStaticList<T, N>::findFirst(Node *startFrom, const T &val) const
+{
+    for (Node *node = startFrom; node != nullptr; node = node->_next)
+    {
+        if (node->_val == val)
+            return node;
+    }
+
+    return nullptr;
+}
+
+
+template<typename T, std::size_t N>
+std::size_t BidiStaticList<T, N>::findAll(Node *startFrom, const T &val, Node **out,
+                                          std::size_t maxOut) const
+{
+    std::size_t found = 0;
+    for (Node *node = startFrom; node != nullptr && found < maxOut; node = node->_next)
+    {
+        if (node->_val == val)
+            out[found++] = node;
+    }
+
+    return found;
+}
+
+
+template<typename T, std::size_t N>
+std::size_t BidiStaticList<T, N>::cutAll(Node *startFrom, const T &val, Node **out,
+                                         std::size_t maxOut)
+{
+    std::size_t found = findAll(startFrom, val, out, maxOut);
+    for (std::size_t i = 0; i < found; ++i)
+        cutNode(out[i]);
+
+    return found;
+}
+
+
+template<typename T, std::size_t N>
+std::size_t BidiStaticList<T, N>::getSize()
+{
+    if (_size == NO_SIZE)
+    {
+        _size = 0;
+        for (Node *node = _head; node != nullptr; node = node->_next)
+            ++_size;
+    }
+
+    return _size;
+}
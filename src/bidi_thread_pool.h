@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the thread pool running parallel
+/// operations over bidirectional lists.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_THREADPOOL_H_
+#define XI_ENHLINKEDLIST_THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>      // size_t
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/** \brief Declares a pool of threads that run numbered tasks of one job at a time
+ *
+ *  A job is a function called for every task number `0..tasks-1`. The thread that
+ *  runs a job works on it along with the pool's threads. Task numbers are dealt
+ *  to the threads in equal contiguous ranges; a thread takes tasks from the front
+ *  of its own range and, once it runs out, steals the back half of the range of
+ *  another thread. So neighbouring tasks mostly run on one thread, uneven tasks
+ *  balance out, and a thread that is late to wake up gets its work done by
+ *  others. A pool of one thread has no threads of its own and runs jobs in the
+ *  calling thread.
+ *
+ *  Jobs from several threads are run one after another; a task must not run a job
+ *  on the same pool.
+ */
+class BidiThreadPool
+{
+public:
+    /** \brief Creates a pool running jobs on \a threads threads, the calling one
+     *  included; 0 means one per hardware thread
+     */
+    explicit BidiThreadPool(std::size_t threads = 0);
+
+    /** \brief Destructor; stops the threads */
+    ~BidiThreadPool();
+
+    BidiThreadPool(const BidiThreadPool &) = delete;
+    BidiThreadPool &operator=(const BidiThreadPool &) = delete;
+
+public:
+    /** \brief Calls `func(i)` for every `i` in `[0, tasks)` and returns when all
+     *  the calls have finished
+     *
+     *  If calls throw, the remaining tasks still run, and then one of the
+     *  exceptions is rethrown.
+     */
+    template<typename Func>
+    void run(std::size_t tasks, Func func);
+
+    /** \brief Returns a number of threads running a job, the calling one included */
+    std::size_t getThreadCount() const { return _threads.size() + 1; }
+
+    /** \brief Returns a pool shared by the process, with a thread per hardware thread */
+    static BidiThreadPool &getDefault();
+
+protected:
+    /** \brief Tasks `[begin, end)` left to a thread, packed into one word, so that
+     *  the owner and thieves change it by a compare-and-swap; padded to a cache line,
+     *  as ranges are allocated in a vector
+     */
+    struct Range
+    {
+        std::atomic<uint64_t> bounds;
+        char padding[64 - sizeof(std::atomic<uint64_t>)];
+
+        Range() : bounds(0) {}
+
+        static uint64_t pack(std::size_t begin, std::size_t end) { return (uint64_t) begin << 32 | end; }
+        static std::size_t beginOf(uint64_t bounds) { return (std::size_t) (bounds >> 32); }
+        static std::size_t endOf(uint64_t bounds) { return (std::size_t) (bounds & 0xFFFFFFFFu); }
+    };
+
+    /** \brief Job being run */
+    struct Job
+    {
+        void (*call)(void *, std::size_t);  ///< Calls a functor at `ctx` for a task
+        void *ctx;
+        Range *ranges;                      ///< Tasks of every thread, the caller's first
+        std::size_t rangeCount;
+
+        std::mutex errorLock;
+        std::exception_ptr error;           ///< First exception thrown by a task
+    };
+
+protected:
+    /** \brief Runs a job at `ctx` calling \a call for every task, see run() */
+    void runJob(void (*call)(void *, std::size_t), void *ctx, std::size_t tasks);
+
+    /** \brief Runs tasks of \a job as a thread \a self, its own ones first and then
+     *  stolen ones, until none is left
+     */
+    static void work(Job &job, std::size_t self);
+
+    /** \brief Takes a front task from \a range; returns false if it is empty */
+    static bool takeFront(Range &range, std::size_t &task);
+
+    /** \brief Moves the back half of some other thread's range to the range of
+     *  \a self; returns false if every range is empty
+     */
+    static bool steal(Job &job, std::size_t self);
+
+    /** \brief Body of a pool thread \a self, which is its index in a job's ranges */
+    void threadLoop(std::size_t self);
+
+    template<typename Func>
+    static void invoke(void *ctx, std::size_t task) { (*static_cast<Func *>(ctx))(task); }
+
+protected:
+    std::vector<std::thread> _threads;
+
+    std::vector<Range> _ranges;         ///< Tasks of every thread, reused by jobs
+
+    std::mutex _runLock;                ///< Lets one job run at a time
+    std::mutex _lock;                   ///< Guards the members below
+    std::condition_variable _started;   ///< Signals a new job or stopping
+    std::condition_variable _left;      ///< Signals a thread has left a job
+
+    Job *_job;                          ///< Current job, or nullptr
+    std::size_t _jobNumber;             ///< Number of jobs started so far
+    std::size_t _busy;                  ///< Number of pool threads in the current job
+    bool _stopping;
+}; // class BidiThreadPool
+
+
+// declaration of template class template methods
+#include "bidi_thread_pool.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_THREADPOOL_H_
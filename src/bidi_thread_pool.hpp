@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the thread pool declared in
+/// the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>    // max
+#include <stdexcept>
+
+
+//==============================================================================
+// class BidiThreadPool
+//==============================================================================
+
+
+inline BidiThreadPool::BidiThreadPool(std::size_t threads)
+    : _ranges(threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads)
+    , _job(nullptr), _jobNumber(0), _busy(0), _stopping(false)
+{
+    // the calling thread of a job takes the first range
+    for (std::size_t i = 1; i < _ranges.size(); ++i)
+        _threads.push_back(std::thread(&BidiThreadPool::threadLoop, this, i));
+}
+
+
+inline BidiThreadPool::~BidiThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stopping = true;
+    }
+    _started.notify_all();
+
+    for (std::size_t i = 0; i < _threads.size(); ++i)
+        _threads[i].join();
+}
+
+
+inline BidiThreadPool &BidiThreadPool::getDefault()
+{
+    static BidiThreadPool pool;
+    return pool;
+}
+
+
+template<typename Func>
+void BidiThreadPool::run(std::size_t tasks, Func func)
+{
+    runJob(&invoke<Func>, &func, tasks);
+}
+
+
+inline void BidiThreadPool::runJob(void (*call)(void *, std::size_t), void *ctx, std::size_t tasks)
+{
+    if (tasks > 0xFFFFFFFFu)
+        throw std::invalid_argument("TP TASKS");
+
+    std::lock_guard<std::mutex> runGuard(_runLock);
+
+    // a single task is not worth waking anybody up
+    bool shared = !_threads.empty() && tasks > 1;
+
+    Job job;
+    job.call = call;
+    job.ctx = ctx;
+    job.ranges = &_ranges[0];
+    job.rangeCount = shared ? _ranges.size() : 1;
+    for (std::size_t i = 0; i < job.rangeCount; ++i)
+    {
+        std::size_t begin = tasks * i / job.rangeCount;
+        std::size_t end = tasks * (i + 1) / job.rangeCount;
+        _ranges[i].bounds.store(Range::pack(begin, end), std::memory_order_relaxed);
+    }
+
+    if (shared)
+    {
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _job = &job;
+            ++_jobNumber;
+        }
+        _started.notify_all();
+    }
+
+    work(job, 0);
+
+    if (shared)
+    {
+        // no task is left to take by now, but others may still run stolen ones;
+        // threads that come late see no job
+        std::unique_lock<std::mutex> lock(_lock);
+        _left.wait(lock, [this]() { return _busy == 0; });
+        _job = nullptr;
+    }
+
+    if (job.error)
+        std::rethrow_exception(job.error);
+}
+
+
+inline bool BidiThreadPool::takeFront(Range &range, std::size_t &task)
+{
+    uint64_t bounds = range.bounds.load();
+    for (;;)
+    {
+        std::size_t begin = Range::beginOf(bounds);
+        std::size_t end = Range::endOf(bounds);
+        if (begin >= end)
+            return false;
+        if (range.bounds.compare_exchange_weak(bounds, Range::pack(begin + 1, end)))
+        {
+            task = begin;
+            return true;
+        }
+    }
+}
+
+
+inline bool BidiThreadPool::steal(Job &job, std::size_t self)
+{
+    for (std::size_t i = 1; i < job.rangeCount; ++i)
+    {
+        Range &victim = job.ranges[(self + i) % job.rangeCount];
+        uint64_t bounds = victim.bounds.load();
+        for (;;)
+        {
+            std::size_t begin = Range::beginOf(bounds);
+            std::size_t end = Range::endOf(bounds);
+            if (begin >= end)
+                break;
+
+            // the victim keeps the front half, which it is about to run
+            std::size_t mid = begin + (end - begin) / 2;
+            if (victim.bounds.compare_exchange_weak(bounds, Range::pack(begin, mid)))
+            {
+                // the own range is empty, and nobody else adds to it
+                job.ranges[self].bounds.store(Range::pack(mid, end));
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+inline void BidiThreadPool::work(Job &job, std::size_t self)
+{
+    do
+    {
+        std::size_t task;
+        while (takeFront(job.ranges[self], task))
+        {
+            try
+            {
+                job.call(job.ctx, task);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> guard(job.errorLock);
+                if (!job.error)
+                    job.error = std::current_exception();
+            }
+        }
+    } while (steal(job, self));
+}
+
+
+inline void BidiThreadPool::threadLoop(std::size_t self)
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    std::size_t seen = 0;
+    for (;;)
+    {
+        _started.wait(lock, [this, seen]() { return _stopping || _jobNumber != seen; });
+        if (_stopping)
+            return;
+
+        seen = _jobNumber;
+        Job *job = _job;
+        if (job == nullptr)
+            continue;
+
+        ++_busy;
+        lock.unlock();
+        work(*job, self);
+        lock.lock();
+        if (--_busy == 0)
+            _left.notify_all();
+    }
+}
@@ -0,0 +1,237 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the thread-safe bidirectional list
+/// template with per-node locks.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_CONCURRENTLIST_H_
+#define XI_ENHLINKEDLIST_CONCURRENTLIST_H_
+
+#include <atomic>
+#include <cstddef>      // size_t
+#include <mutex>
+
+
+/** \brief Declares a bidirectional list whose methods may be called from many
+ *  threads at once
+ *
+ *  Every node has its own mutex, and the list is bounded by two sentinel nodes,
+ *  so every real node has both neighbours. Searches walk the list hand over hand:
+ *  the lock of a next node is taken before the lock of a current one is released.
+ *  An insertion locks the two nodes it goes between, a cut locks the cut node and
+ *  its two neighbours; thus operations on disjoint parts of the list run in parallel.
+ *
+ *  Locks are only waited for in list order, from the head to the tail. A method
+ *  that has to lock a predecessor of a node it holds tries to, and on failure
+ *  releases everything and starts over, so there are no deadlocks.
+ *
+ *  A cut node belongs to a caller, as with BidiLinkedList, but methods lock the
+ *  nodes they are given, so **a cut node must not be deleted while any other
+ *  thread may still pass it to the list**, e.g. one that has got it from
+ *  findFirst() or findAll(). The list does not defer deletion; a caller that
+ *  cannot tell when that is over must keep cut nodes until the list is quiescent.
+ *  A node that has been cut but not deleted is not an error as an argument:
+ *  methods return nullptr then. A traversal itself never stays at a cut node.
+ *
+ *  clear() and the destructor delete the nodes they cut, so they must not run
+ *  while other threads hold nodes of the list.
+ *
+ *  **Requirements to a `T`** are the same as for BidiLinkedList.
+ */
+template<typename T>
+class ConcurrentBidiList
+{
+public:
+    //-----<Types>-----
+
+    /** \brief Node of a concurrent list; its value is guarded by its lock */
+    class Node
+    {
+        friend class ConcurrentBidiList;
+
+    public:
+        /** \brief Default constructor */
+        Node() : _next(nullptr), _prev(nullptr), _linked(false) {}
+
+        /** \brief Inititalization with a node element */
+        Node(const T &el) : _val(el), _next(nullptr), _prev(nullptr), _linked(false) {}
+
+        Node(const Node &) = delete;
+        Node &operator=(const Node &) = delete;
+
+    public:
+        /** \brief Returns a copy of node's value */
+        T getValue() const
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            return _val;
+        }
+
+        /** \brief Sets a new value carried by the node */
+        void setValue(const T &newVal)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _val = newVal;
+        }
+
+    protected:
+        T _val;                     ///< Storage a value
+        Node *_next;                ///< Next node; a sentinel at the end
+        Node *_prev;                ///< Previous node; a sentinel at the beginning
+        bool _linked;               ///< Whether the node is in the list
+        mutable std::mutex _lock;   ///< Guards the links and the value
+    }; // class Node
+
+public:
+    /** \brief Default constructor */
+    ConcurrentBidiList();
+
+    /** \brief Destructor; must not run concurrently with other methods */
+    ~ConcurrentBidiList();
+
+    ConcurrentBidiList(const ConcurrentBidiList &) = delete;
+    ConcurrentBidiList &operator=(const ConcurrentBidiList &) = delete;
+
+public:
+    //-----<Structure>-----
+
+    /** \brief Appends a given element (to the end) and returns a new node */
+    Node *appendEl(const T &val) { return insertNodeAfter(nullptr, new Node(val)); }
+
+    /** \brief Inserts a free node \a insNode after \a node
+     *
+     *  If \a node is nullptr, \a insNode is appended. Returns \a insNode, or nullptr
+     *  if \a node has been cut (it must not have been deleted); \a insNode stays
+     *  free then. If \a insNode is nullptr or is not free, an exception is thrown.
+     */
+    Node *insertNodeAfter(Node *node, Node *insNode);
+
+    /** \brief Inserts a free node \a insNode before \a node, nullptr to prepend it;
+     *  see insertNodeAfter()
+     */
+    Node *insertNodeBefore(Node *node, Node *insNode);
+
+    /** \brief Cuts a given node from the list and returns it, or returns nullptr if
+     *  it is already cut, but not deleted
+     *
+     *  If \a node is nullptr, an exception is thrown.
+     */
+    Node *cutNode(Node *node);
+
+    /** \brief Cuts and deletes all the nodes; no other thread may hold any of them */
+    void clear();
+
+public:
+    //-----<Search>-----
+
+    /** \brief Finds first node carrying \a val after \a startFrom, or from the head if
+     *  \a startFrom is nullptr; returns nullptr if nothing is found or \a startFrom
+     *  has been cut
+     *
+     *  Unlike BidiLinkedList::findFirst(), \a startFrom itself is not examined, so
+     *  that a search can be continued from a found node.
+     */
+    Node *findFirst(Node *startFrom, const T &val);
+
+    /** \brief Overloaded version of findFirst(): searching in the entire list */
+    Node *findFirst(const T &val) { return findFirst(nullptr, val); }
+
+    /** \brief Finds all the nodes carrying \a val, see BidiLinkedList::findAll()
+     *
+     *  Nodes are collected in one pass, so the result is a consistent snapshot for
+     *  the part of the list behind the pass only.
+     */
+    Node **findAll(const T &val, int &size);
+
+    /** \brief Returns whether any node carries a given value \a val */
+    bool contains(const T &val) { return findFirst(val) != nullptr; }
+
+    /** \brief Cuts first node carrying \a val and returns it, or nullptr */
+    Node *cutFirst(const T &val);
+
+    /** \brief Cuts all the nodes carrying \a val in one pass and returns an array
+     *  of them, see BidiLinkedList::cutAll()
+     */
+    Node **cutAll(const T &val, int &size);
+
+    /** \brief Applies \a func to the value of every node from the head on
+     *
+     *  \a func is invoked as `func(T&)` under the lock of the node.
+     */
+    template<typename Func>
+    void forEach(Func func);
+
+public:
+    //-----<Access>-----
+
+    /** \brief Returns a first node, or nullptr for an empty list */
+    Node *getHeadNode() const;
+
+    /** \brief Returns a last node, or nullptr for an empty list */
+    Node *getLastNode() const;
+
+    /** \brief Returns a node after \a node, or nullptr if \a node is the last one or
+     *  has been cut
+     */
+    Node *getNextNode(const Node *node) const;
+
+    /** \brief Returns a node before \a node, see getNextNode() */
+    Node *getPrevNode(const Node *node) const;
+
+    /** \brief Returns a number of nodes in the list */
+    std::size_t getSize() const { return _size.load(std::memory_order_relaxed); }
+
+    /** \brief Returns whether the list is empty */
+    bool isEmpty() const { return getSize() == 0; }
+
+protected:
+    /** \brief Checks \a insNode is a free node, throwing an exception with \a code otherwise */
+    static void checkFree(const Node *insNode, const char *code);
+
+    /** \brief Links \a insNode between locked \a prev and \a next */
+    void link(Node *prev, Node *insNode, Node *next);
+
+    /** \brief Unlinks \a node from locked \a prev and \a next */
+    void unlink(Node *prev, Node *node, Node *next);
+
+    /** \brief Locks \a node and its predecessor, which are returned by \a prev
+     *
+     *  Returns false, with nothing locked, if \a node is no longer in the list.
+     */
+    bool lockWithPrev(Node *node, Node *&prev);
+
+    /** \brief Walks the list hand over hand from the node after \a startFrom and
+     *  calls `visit(node)` for locked nodes until it returns true
+     *
+     *  Returns that node, unlocked, or nullptr.
+     */
+    template<typename Visitor>
+    Node *traverse(Node *startFrom, Visitor visit);
+
+    /** \brief Cuts nodes for which `match(node)` is true, at most \a maxCount of them,
+     *  in one pass; calls `collect(node)` for every cut node
+     */
+    template<typename Pred, typename Collector>
+    void cutIf(Pred match, std::size_t maxCount, Collector collect);
+
+protected:
+    Node _headSentinel;                 ///< Node before the first one
+    Node _tailSentinel;                 ///< Node after the last one
+    std::atomic<std::size_t> _size;     ///< Number of nodes
+}; // class ConcurrentBidiList
+
+
+// declaration of template class template methods
+#include "concurrent_bidi_list.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_CONCURRENTLIST_H_
@@ -0,0 +1,356 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the thread-safe bidirectional
+/// list template declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+
+//==============================================================================
+// class ConcurrentBidiList<T>
+//==============================================================================
+
+
+template<typename T>
+ConcurrentBidiList<T>::ConcurrentBidiList() : _size(0)
+{
+    _headSentinel._next = &_tailSentinel;
+    _tailSentinel._prev = &_headSentinel;
+    _headSentinel._linked = true;
+    _tailSentinel._linked = true;
+}
+
+
+template<typename T>
+ConcurrentBidiList<T>::~ConcurrentBidiList()
+{
+    clear();
+}
+
+
+template<typename T>
+void ConcurrentBidiList<T>::clear()
+{
+    cutIf([](const Node *) { return true; }, (std::size_t) -1, [](Node *node) { delete node; });
+}
+
+
+template<typename T>
+void ConcurrentBidiList<T>::checkFree(const Node *insNode, const char *code)
+{
+    if (insNode == nullptr)
+        throw std::invalid_argument(code);
+
+    // a free node belongs to a caller, so nobody else is touching it
+    if (insNode->_linked || insNode->_next != nullptr || insNode->_prev != nullptr)
+        throw std::invalid_argument(code);
+}
+
+
+template<typename T>
+void ConcurrentBidiList<T>::link(Node *prev, Node *insNode, Node *next)
+{
+    insNode->_prev = prev;
+    insNode->_next = next;
+    insNode->_linked = true;
+    prev->_next = insNode;
+    next->_prev = insNode;
+    _size.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+template<typename T>
+void ConcurrentBidiList<T>::unlink(Node *prev, Node *node, Node *next)
+{
+    prev->_next = next;
+    next->_prev = prev;
+    node->_prev = nullptr;
+    node->_next = nullptr;
+    node->_linked = false;
+    _size.fetch_sub(1, std::memory_order_relaxed);
+}
+
+
+template<typename T>
+bool ConcurrentBidiList<T>::lockWithPrev(Node *node, Node *&prev)
+{
+    for (;;)
+    {
+        node->_lock.lock();
+        if (!node->_linked)
+        {
+            node->_lock.unlock();
+            return false;
+        }
+
+        // while the node is locked its predecessor can be neither cut nor
+        // replaced, but it is locked against the list order, hence only tried
+        prev = node->_prev;
+        if (prev->_lock.try_lock())
+            return true;
+
+        node->_lock.unlock();
+        std::this_thread::yield();
+    }
+}
+
+
+template<typename T>
+typename ConcurrentBidiList<T>::Node *
+ConcurrentBidiList<T>::insertNodeAfter(Node *node, Node *insNode)
+{
+    checkFree(insNode, "INA NP");
+    if (node == nullptr)
+        return insertNodeBefore(&_tailSentinel, insNode);
+
+    node->_lock.lock();
+    if (!node->_linked)
+    {
+        node->_lock.unlock();
+        return nullptr;
+    }
+
+    Node *next = node->_next;
+    next->_lock.lock();
+    link(node, insNode, next);
+    next->_lock.unlock();
+    node->_lock.unlock();
+
+    return insNode;
+}
+
+
+template<typename T>
+typename ConcurrentBidiList<T>::Node *
+ConcurrentBidiList<T>::insertNodeBefore(Node *node, Node *insNode)
+{
+    checkFree(insNode, "INB NP");
+    if (node == nullptr)
+        return insertNodeAfter(&_headSentinel, insNode);
+
+    Node *prev;
+    if (!lockWithPrev(node, prev))
+        return nullptr;
+
+    link(prev, insNode, node);
+    node->_lock.unlock();
+    prev->_lock.unlock();
+
+    return insNode;
+}
+
+
+template<typename T>
+typename ConcurrentBidiList<T>::Node *
+ConcurrentBidiList<T>::cutNode(Node *node)
+{
+    if (node == nullptr)
+        throw std::invalid_argument("CNS NP");
+
+    Node *prev;
+    if (!lockWithPrev(node, prev))
+        return nullptr;
+
+    Node *next = node->_next;
+    next->_lock.lock();
+    unlink(prev, node, next);
+    next->_lock.unlock();
+    node->_lock.unlock();
+    prev->_lock.unlock();
+
+    return node;
+}
+
+
+template<typename T>
+template<typename Visitor>
+typename ConcurrentBidiList<T>::Node *
+ConcurrentBidiList<T>::traverse(Node *startFrom, Visitor visit)
+{
+    Node *cur = startFrom ? startFrom : &_headSentinel;
+    cur->_lock.lock();
+    if (!cur->_linked)
+    {
+        cur->_lock.unlock();
+        return nullptr;
+    }
+
+    for (;;)
+    {
+        Node *next = cur->_next;
+        if (next == &_tailSentinel)
+        {
+            cur->_lock.unlock();
+            return nullptr;
+        }
+
+        next->_lock.lock();
+        cur->_lock.unlock();
+        cur = next;
+
+        if (visit(cur))
+        {
+            cur->_lock.unlock();
+            return cur;
+        }
+    }
+}
+
+
+template<typename T>
+typename ConcurrentBidiList<T>::Node *
+ConcurrentBidiList<T>::findFirst(Node *startFrom, const T &val)
+{
+    return traverse(startFrom, [&val](Node *node) { return node->_val == val; });
+}
+
+
+template<typename T>
+typename ConcurrentBidiList<T>::Node **
+ConcurrentBidiList<T>::findAll(const T &val, int &size)
+{
+    std::vector<Node *> found;
+    traverse(nullptr, [&val, &found](Node *node)
+    {
+        if (node->_val == val)
+            found.push_back(node);
+        return false;
+    });
+
+    size = (int) found.size();
+    if (found.empty())
+        return nullptr;
+
+    Node **res = new Node *[found.size()];
+    for (std::size_t i = 0; i < found.size(); ++i)
+        res[i] = found[i];
+
+    return res;
+}
+
+
+template<typename T>
+template<typename Func>
+void ConcurrentBidiList<T>::forEach(Func func)
+{
+    traverse(nullptr, [&func](Node *node) { func(node->_val); return false; });
+}
+
+
+template<typename T>
+template<typename Pred, typename Collector>
+void ConcurrentBidiList<T>::cutIf(Pred match, std::size_t maxCount, Collector collect)
+{
+    // a pair of locked nodes moves along the list
+    Node *prev = &_headSentinel;
+    prev->_lock.lock();
+    Node *cur = prev->_next;
+    cur->_lock.lock();
+
+    std::size_t count = 0;
+    while (cur != &_tailSentinel && count < maxCount)
+    {
+        if (match(cur))
+        {
+            Node *next = cur->_next;
+            next->_lock.lock();
+            unlink(prev, cur, next);
+            cur->_lock.unlock();
+            collect(cur);
+            ++count;
+            cur = next;
+        } else
+        {
+            prev->_lock.unlock();
+            prev = cur;
+            cur = cur->_next;
+            cur->_lock.lock();
+        }
+    }
+
+    cur->_lock.unlock();
+    prev->_lock.unlock();
+}
+
+
+template<typename T>
+typename ConcurrentBidiList<T>::Node *
+ConcurrentBidiList<T>::cutFirst(const T &val)
+{
+    Node *res = nullptr;
+    cutIf([&val](const Node *node) { return node->_val == val; }, 1,
+          [&res](Node *node) { res = node; });
+    return res;
+}
+
+
+template<typename T>
+typename ConcurrentBidiList<T>::Node **
+ConcurrentBidiList<T>::cutAll(const T &val, int &size)
+{
+    std::vector<Node *> cut;
+    cutIf([&val](const Node *node) { return node->_val == val; }, (std::size_t) -1,
+          [&cut](Node *node) { cut.push_back(node); });
+
+    size = (int) cut.size();
+    if (cut.empty())
+        return nullptr;
+
+    Node **res = new Node *[cut.size()];
+    for (std::size_t i = 0; i < cut.size(); ++i)
+        res[i] = cut[i];
+
+    return res;
+}
+
+
+template<typename T>
+typename ConcurrentBidiList<T>::Node *
+ConcurrentBidiList<T>::getHeadNode() const
+{
+    std::lock_guard<std::mutex> guard(_headSentinel._lock);
+    Node *res = _headSentinel._next;
+    return res == &_tailSentinel ? nullptr : res;
+}
+
+
+template<typename T>
+typename ConcurrentBidiList<T>::Node *
+ConcurrentBidiList<T>::getLastNode() const
+{
+    std::lock_guard<std::mutex> guard(_tailSentinel._lock);
+    Node *res = _tailSentinel._prev;
+    return res == &_headSentinel ? nullptr : res;
+}
+
+
+template<typename T>
+typename ConcurrentBidiList<T>::Node *
+ConcurrentBidiList<T>::getNextNode(const Node *node) const
+{
+    std::lock_guard<std::mutex> guard(node->_lock);
+    Node *res = node->_next;
+    return res == &_tailSentinel ? nullptr : res;
+}
+
+
+template<typename T>
+typename ConcurrentBidiList<T>::Node *
+ConcurrentBidiList<T>::getPrevNode(const Node *node) const
+{
+    std::lock_guard<std::mutex> guard(node->_lock);
+    Node *res = node->_prev;
+    return res == &_headSentinel ? nullptr : res;
+}
@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the epoch-based reclamation of memory
+/// shared by lock-free readers.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_EPOCHRECLAIMER_H_
+#define XI_ENHLINKEDLIST_EPOCHRECLAIMER_H_
+
+#include <atomic>
+#include <cstddef>      // size_t
+#include <cstdint>
+#include <vector>
+
+
+/** \brief Defers freeing of objects unlinked from a shared structure until no
+ *  reader can still hold them
+ *
+ *  A reader wraps every access to the structure in a Guard, which publishes the
+ *  current *epoch* in a reader slot. A writer unlinks an object and passes it to
+ *  retire(); the object is stamped with the epoch and is freed by reclaim() once
+ *  every guard that was active at the stamp has ended (a *grace period*).
+ *
+ *  Entering and leaving a guard costs a few atomic operations on a slot that is
+ *  private to the thread as long as there are fewer threads than slots, so
+ *  readers scale. Guards may be nested. At most MAX_GUARDS guards exist at once;
+ *  more wait for a free slot.
+ *
+ *  retire() takes no lock: it pushes a record onto a lock-free stack, with a CAS,
+ *  so it only waits for the allocator. reclaim() is run by one thread at a time;
+ *  a thread that finds another one reclaiming returns at once instead of waiting,
+ *  and its objects are left for the next reclaim(). Only synchronize() blocks.
+ */
+class EpochReclaimer
+{
+public:
+    //-----<Consts>------
+    /** \brief Number of reader slots */
+    static const std::size_t MAX_GUARDS = 128;
+
+    /** \brief Number of retire() calls between implicit reclaim() calls */
+    static const std::size_t RECLAIM_PERIOD = 64;
+
+public:
+    //-----<Types>-----
+
+    /** \brief Scope of a reader: objects retired meanwhile are not freed */
+    class Guard
+    {
+    public:
+        explicit Guard(EpochReclaimer &owner);
+        ~Guard();
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+    protected:
+        EpochReclaimer &_owner;
+        std::size_t _slot;          ///< Index of the slot taken
+    }; // class Guard
+
+public:
+    EpochReclaimer() : _epoch(1), _incoming(nullptr), _pending(0), _retireCount(0),
+                       _reclaiming(false), _lastMinActive(0) {}
+
+    /** \brief Frees every retired object; no guard may be active */
+    ~EpochReclaimer();
+
+    EpochReclaimer(const EpochReclaimer &) = delete;
+    EpochReclaimer &operator=(const EpochReclaimer &) = delete;
+
+public:
+    /** \brief Passes \a obj, which is no longer reachable by new readers, to be
+     *  deleted after \a gracePeriods grace periods
+     *
+     *  One grace period is enough for objects that can only be reached through
+     *  the structure; see LockFreeBidiList for a case of two.
+     */
+    template<typename Obj>
+    void retire(Obj *obj, unsigned gracePeriods = 1)
+    {
+        retire(obj, &deleteObject<Obj>, gracePeriods);
+    }
+
+    /** \brief Frees retired objects whose grace periods have passed; returns at
+     *  once if another thread is doing so
+     */
+    void reclaim() { tryReclaim(); }
+
+    /** \brief Waits until every guard that is active now has ended, then reclaims
+     *
+     *  Must not be called inside a guard of this reclaimer.
+     */
+    void synchronize();
+
+    /** \brief Returns a number of retired objects that are not freed yet */
+    std::size_t getPendingCount() const { return _pending.load(); }
+
+protected:
+    //-----<Types>-----
+    /** \brief Reader slot, which takes a cache line of its own */
+    struct alignas(64) Slot
+    {
+        std::atomic<bool> owned;        ///< Whether a guard uses the slot
+        std::atomic<uint64_t> epoch;    ///< Epoch the guard started at; 0 if none
+
+        Slot() : owned(false), epoch(0) {}
+    };
+
+    /** \brief Object waiting for the end of its grace periods */
+    struct Retired
+    {
+        void *obj;
+        void (*deleter)(void *);
+        uint64_t stamp;                 ///< Epoch the current grace period started at
+        unsigned periodsLeft;
+        Retired *next;                  ///< Next record of the stack or of the backlog
+    };
+
+protected:
+    /** \brief Type-erased retire() */
+    void retire(void *obj, void (*deleter)(void *), unsigned gracePeriods);
+
+    /** \brief Frees expired objects unless another thread is reclaiming; returns
+     *  whether it has run
+     */
+    bool tryReclaim();
+
+    /** \brief Returns the smallest epoch of active guards, or UINT64_MAX */
+    uint64_t minActiveEpoch() const;
+
+    template<typename Obj>
+    static void deleteObject(void *obj) { delete static_cast<Obj *>(obj); }
+
+protected:
+    Slot _slots[MAX_GUARDS];            ///< Reader slots
+    std::atomic<uint64_t> _epoch;       ///< Current epoch, advanced by retirements
+
+    std::atomic<Retired *> _incoming;   ///< Stack of records retired since the last reclaim()
+    std::atomic<std::size_t> _pending;  ///< Number of objects not freed yet
+    std::atomic<std::size_t> _retireCount;  ///< Number of retire() calls so far
+    std::atomic<bool> _reclaiming;      ///< Whether a thread runs reclaim(); guards the members below
+
+    std::vector<Retired *> _backlog;    ///< Records taken from the stack and not expired yet
+    uint64_t _lastMinActive;            ///< Smallest epoch of guards seen by the last reclaim()
+}; // class EpochReclaimer
+
+
+// declaration of class methods
+#include "epoch_reclaimer.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_EPOCHRECLAIMER_H_
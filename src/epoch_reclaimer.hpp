@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the epoch-based reclamation
+/// declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <functional>   // hash
+#include <limits>
+#include <thread>
+
+
+
+//==============================================================================
+// class EpochReclaimer::Guard
+//==============================================================================
+
+
+inline EpochReclaimer::Guard::Guard(EpochReclaimer &owner) : _owner(owner)
+{
+    // threads start from different slots, so that each one usually keeps its own
+    std::size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % MAX_GUARDS;
+    for (std::size_t i = 0; ; ++i)
+    {
+        _slot = (start + i) % MAX_GUARDS;
+        Slot &slot = _owner._slots[_slot];
+        if (!slot.owned.load(std::memory_order_relaxed) &&
+            !slot.owned.exchange(true, std::memory_order_acquire))
+            break;
+
+        if (i % MAX_GUARDS == MAX_GUARDS - 1)
+            std::this_thread::yield();
+    }
+
+    // the store must be visible before any read of the structure, hence seq_cst
+    _owner._slots[_slot].epoch.store(_owner._epoch.load());
+}
+
+
+inline EpochReclaimer::Guard::~Guard()
+{
+    Slot &slot = _owner._slots[_slot];
+    slot.epoch.store(0, std::memory_order_release);
+    slot.owned.store(false, std::memory_order_release);
+}
+
+
+
+//==============================================================================
+// class EpochReclaimer
+//==============================================================================
+
+
+inline EpochReclaimer::~EpochReclaimer()
+{
+    for (Retired *item = _incoming.load(); item != nullptr; )
+    {
+        Retired *next = item->next;
+        _backlog.push_back(item);
+        item = next;
+    }
+
+    for (std::size_t i = 0; i < _backlog.size(); ++i)
+    {
+        _backlog[i]->deleter(_backlog[i]->obj);
+        delete _backlog[i];
+    }
+}
+
+
+inline void EpochReclaimer::retire(void *obj, void (*deleter)(void *), unsigned gracePeriods)
+{
+    // the object is unlinked already, so readers that start later cannot get it
+    Retired *item = new Retired();
+    item->obj = obj;
+    item->deleter = deleter;
+    item->stamp = _epoch.fetch_add(1);
+    item->periodsLeft = gracePeriods ? gracePeriods : 1;
+
+    ++_pending;
+    item->next = _incoming.load(std::memory_order_relaxed);
+    while (!_incoming.compare_exchange_weak(item->next, item, std::memory_order_release,
+                                            std::memory_order_relaxed))
+        ;
+
+    if ((_retireCount.fetch_add(1, std::memory_order_relaxed) + 1) % RECLAIM_PERIOD == 0)
+        tryReclaim();
+}
+
+
+inline uint64_t EpochReclaimer::minActiveEpoch() const
+{
+    uint64_t res = std::numeric_limits<uint64_t>::max();
+    for (std::size_t i = 0; i < MAX_GUARDS; ++i)
+    {
+        uint64_t epoch = _slots[i].epoch.load();
+        if (epoch != 0 && epoch < res)
+            res = epoch;
+    }
+
+    return res;
+}
+
+
+inline bool EpochReclaimer::tryReclaim()
+{
+    if (_reclaiming.load(std::memory_order_relaxed) ||
+        _reclaiming.exchange(true, std::memory_order_acquire))
+        return false;
+
+    // records are pushed onto the stack in reverse, which does not matter here
+    for (Retired *item = _incoming.exchange(nullptr, std::memory_order_acquire); item != nullptr; )
+    {
+        Retired *next = item->next;
+        _backlog.push_back(item);
+        item = next;
+    }
+
+    std::vector<Retired *> expired;
+    uint64_t minActive = minActiveEpoch();
+
+    // objects retired since are stamped at or after the oldest guard, so while
+    // it is stuck, e.g. its thread is preempted, nothing expires and rescanning
+    // a growing backlog would only burn time
+    if (minActive != _lastMinActive || minActive == std::numeric_limits<uint64_t>::max())
+    {
+        _lastMinActive = minActive;
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < _backlog.size(); ++i)
+        {
+            Retired *item = _backlog[i];
+
+            // every guard that could have got the object has ended
+            if (item->stamp < minActive && --item->periodsLeft == 0)
+            {
+                expired.push_back(item);
+                continue;
+            }
+            if (item->stamp < minActive)
+                item->stamp = _epoch.fetch_add(1);
+
+            _backlog[kept++] = item;
+        }
+        _backlog.resize(kept);
+    }
+
+    _reclaiming.store(false, std::memory_order_release);
+
+    // deleters run after the flag is dropped, so that they may retire objects themselves
+    for (std::size_t i = 0; i < expired.size(); ++i)
+    {
+        expired[i]->deleter(expired[i]->obj);
+        delete expired[i];
+        --_pending;
+    }
+
+    return true;
+}
+
+
+inline void EpochReclaimer::synchronize()
+{
+    uint64_t epoch = _epoch.fetch_add(1);
+    for (std::size_t i = 0; i < MAX_GUARDS; ++i)
+    {
+        for (;;)
+        {
+            uint64_t active = _slots[i].epoch.load();
+            if (active == 0 || active > epoch)
+                break;
+            std::this_thread::yield();
+        }
+    }
+
+    // the objects of other threads must expire too, so wait for a running reclaim()
+    while (!tryReclaim())
+        std::this_thread::yield();
+}
@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the flat-combining wrapper that makes a
+/// BidiLinkedList usable from many threads.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_FLATCOMBININGLIST_H_
+#define XI_ENHLINKEDLIST_FLATCOMBININGLIST_H_
+
+#include <atomic>
+#include <cstddef>      // size_t
+#include <exception>
+
+#include "bidi_linked_list.h"
+
+
+/** \brief Declares a BidiLinkedList whose methods may be called from many threads
+ *  at once, applied by flat combining
+ *
+ *  A calling thread does not lock the list: it publishes its operation in a record
+ *  of its own and waits. Whichever waiting thread first gets the combiner role
+ *  applies every published operation in one go against the sequential list and
+ *  marks them done. So the list stays in one thread's cache, and a contended lock
+ *  is taken once per batch instead of once per operation.
+ *
+ *  Appends met one after another in a pass are merged: their values are built
+ *  into one chain and spliced by a single BidiLinkedList::insertRangeAfter().
+ *
+ *  Node pointers follow the rules of BidiLinkedList: a node argument must belong
+ *  to the list, and a cut node belongs to a caller. An exception thrown by the
+ *  list is rethrown in the thread that has called the method.
+ */
+template<typename T, typename Policy = DefaultBidiListPolicy>
+class FlatCombiningBidiList
+{
+public:
+    //-----<Types>-----
+    typedef BidiLinkedList<T, Policy> List;
+    typedef typename List::Node Node;
+
+public:
+    //-----<Consts>------
+    /** \brief Number of publication records; more threads wait for a free one */
+    static const std::size_t MAX_RECORDS = 64;
+
+    /** \brief Number of passes over the records a combiner makes at most */
+    static const std::size_t COMBINE_PASSES = 3;
+
+public:
+    /** \brief Default constructor */
+    FlatCombiningBidiList() : _used(0), _combining(false) {}
+
+    FlatCombiningBidiList(const FlatCombiningBidiList &) = delete;
+    FlatCombiningBidiList &operator=(const FlatCombiningBidiList &) = delete;
+
+public:
+    //-----<Operations>-----
+    // see the methods of BidiLinkedList of the same names
+
+    Node *appendEl(const T &val);
+    Node *insertNodeAfter(Node *node, Node *insNode);
+    Node *insertNodeBefore(Node *node, Node *insNode);
+    Node *cutNode(Node *node);
+    Node *cutFirst(const T &val);
+    Node *findFirst(const T &val);
+    std::size_t count(const T &val);
+    std::size_t getSize();
+
+    /** \brief Applies \a func to the list as one operation; invoked as `func(List&)`
+     *
+     *  \a func runs in a combiner thread and must not call methods of this wrapper.
+     */
+    template<typename Func>
+    void apply(Func func);
+
+protected:
+    //-----<Types>-----
+    /** \brief Kinds of published operations */
+    enum Op
+    {
+        OP_APPEND,
+        OP_INSERT_AFTER,
+        OP_INSERT_BEFORE,
+        OP_CUT_NODE,
+        OP_CUT_FIRST,
+        OP_FIND_FIRST,
+        OP_COUNT,
+        OP_SIZE,
+        OP_APPLY
+    };
+
+    /** \brief States of a publication record */
+    enum State
+    {
+        REC_IDLE = 0,           ///< nothing published
+        REC_PENDING,            ///< an operation waits for a combiner
+        REC_DONE                ///< a result is ready
+    };
+
+    /** \brief Operation of a calling thread with its arguments and results; lives
+     *  on the caller's stack while the operation is pending
+     */
+    struct Call
+    {
+        Op op;
+        const T *val = nullptr;
+        Node *node = nullptr;
+        Node *insNode = nullptr;
+        void (*func)(void *, List &) = nullptr;     ///< OP_APPLY: calls a functor at `ctx`
+        void *ctx = nullptr;
+
+        Node *resNode = nullptr;
+        std::size_t resCount = 0;
+        std::exception_ptr error;
+
+        explicit Call(Op op_) : op(op_) {}
+    };
+
+    /** \brief Publication record of a thread, which takes a cache line of its own */
+    struct alignas(64) Record
+    {
+        std::atomic<bool> owned;        ///< Whether a thread uses the record
+        std::atomic<int> state;         ///< See State
+        Call *call;                     ///< Published operation
+
+        Record() : owned(false), state(REC_IDLE), call(nullptr) {}
+    };
+
+    /** \brief Input iterator over values of appends batched by a combiner */
+    struct BatchIt
+    {
+        Record *const *rec;
+
+        const T &operator*() const { return *(*rec)->call->val; }
+        BatchIt &operator++() { ++rec; return *this; }
+        bool operator!=(const BatchIt &other) const { return rec != other.rec; }
+    };
+
+protected:
+    /** \brief Publishes \a call, waits for it to be applied, combining operations
+     *  if no other thread does; rethrows an error of the operation
+     */
+    void run(Call &call);
+
+    /** \brief Takes a free record for a calling thread */
+    Record &acquireRecord();
+
+    /** \brief Applies pending operations; called by a thread holding the combiner role */
+    void combine();
+
+    /** \brief Applies one operation other than an append */
+    void execute(Call &call);
+
+    /** \brief Splices the appends batched so far and marks them done */
+    void flushAppends();
+
+    /** \brief Runs an operation on nodes and returns its resulting node */
+    Node *runOnNodes(Op op, Node *node, Node *insNode);
+
+    template<typename Func>
+    static void invoke(void *ctx, List &lst) { (*static_cast<Func *>(ctx))(lst); }
+
+protected:
+    Record _records[MAX_RECORDS];       ///< Publication records
+    std::atomic<std::size_t> _used;     ///< Number of records ever taken, from the first one
+    alignas(64) std::atomic<bool> _combining;   ///< Whether a thread is the combiner
+
+    // the members below are touched by a combiner only
+    List _lst;                          ///< The list
+    Record *_batch[MAX_RECORDS];        ///< Appends batched in a pass
+    std::size_t _batchSize = 0;         ///< Number of appends batched
+}; // class FlatCombiningBidiList
+
+
+// declaration of template class template methods
+#include "flat_combining_bidi_list.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_FLATCOMBININGLIST_H_
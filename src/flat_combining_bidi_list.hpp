@@ -0,0 +1,284 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the flat-combining wrapper
+/// declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <thread>
+
+
+
+//==============================================================================
+// class FlatCombiningBidiList<T, Policy>
+//==============================================================================
+
+
+template<typename T, typename Policy>
+typename FlatCombiningBidiList<T, Policy>::Record &
+FlatCombiningBidiList<T, Policy>::acquireRecord()
+{
+    // the lowest free record is taken, so that a combiner scans only as many
+    // records as there have been threads at once
+    for (std::size_t i = 0; ; ++i)
+    {
+        std::size_t idx = i % MAX_RECORDS;
+        Record &rec = _records[idx];
+        if (!rec.owned.load(std::memory_order_relaxed) &&
+            !rec.owned.exchange(true, std::memory_order_acquire))
+        {
+            std::size_t used = _used.load(std::memory_order_relaxed);
+            while (used <= idx && !_used.compare_exchange_weak(used, idx + 1, std::memory_order_release))
+                ;
+            return rec;
+        }
+
+        if (idx == MAX_RECORDS - 1)
+            std::this_thread::yield();
+    }
+}
+
+
+template<typename T, typename Policy>
+void FlatCombiningBidiList<T, Policy>::run(Call &call)
+{
+    Record &rec = acquireRecord();
+    rec.call = &call;
+    rec.state.store(REC_PENDING, std::memory_order_release);
+
+    while (rec.state.load(std::memory_order_acquire) != REC_DONE)
+    {
+        // the record is pending when a combining starts, so one pass serves it
+        if (!_combining.load(std::memory_order_relaxed) &&
+            !_combining.exchange(true, std::memory_order_acquire))
+        {
+            combine();
+            _combining.store(false, std::memory_order_release);
+        }
+        else
+            std::this_thread::yield();
+    }
+
+    rec.state.store(REC_IDLE, std::memory_order_relaxed);
+    rec.owned.store(false, std::memory_order_release);
+
+    if (call.error)
+        std::rethrow_exception(call.error);
+}
+
+
+template<typename T, typename Policy>
+void FlatCombiningBidiList<T, Policy>::combine()
+{
+    // later passes pick up operations published while the earlier ones ran
+    for (std::size_t pass = 0; pass < COMBINE_PASSES; ++pass)
+    {
+        std::size_t served = 0;
+        std::size_t used = _used.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < used; ++i)
+        {
+            Record &rec = _records[i];
+            if (rec.state.load(std::memory_order_acquire) != REC_PENDING)
+                continue;
+
+            ++served;
+            if (rec.call->op == OP_APPEND)
+            {
+                _batch[_batchSize++] = &rec;
+                continue;
+            }
+
+            // appends published before the operation must be applied before it
+            flushAppends();
+            execute(*rec.call);
+            rec.state.store(REC_DONE, std::memory_order_release);
+        }
+        flushAppends();
+
+        if (served == 0)
+            break;
+    }
+}
+
+
+template<typename T, typename Policy>
+void FlatCombiningBidiList<T, Policy>::execute(Call &call)
+{
+    try
+    {
+        switch (call.op)
+        {
+        case OP_INSERT_AFTER:
+            call.resNode = _lst.insertNodeAfter(call.node, call.insNode);
+            break;
+        case OP_INSERT_BEFORE:
+            call.resNode = _lst.insertNodeBefore(call.node, call.insNode);
+            break;
+        case OP_CUT_NODE:
+            call.resNode = _lst.cutNode(call.node);
+            break;
+        case OP_CUT_FIRST:
+            call.resNode = _lst.cutFirst(*call.val);
+            break;
+        case OP_FIND_FIRST:
+            call.resNode = _lst.findFirst(*call.val);
+            break;
+        case OP_COUNT:
+            call.resCount = _lst.count(*call.val);
+            break;
+        case OP_SIZE:
+            call.resCount = _lst.getSize();
+            break;
+        case OP_APPLY:
+            call.func(call.ctx, _lst);
+            break;
+        case OP_APPEND:
+            call.resNode = _lst.appendEl(*call.val);
+            break;
+        }
+    }
+    catch (...)
+    {
+        call.error = std::current_exception();
+    }
+}
+
+
+template<typename T, typename Policy>
+void FlatCombiningBidiList<T, Policy>::flushAppends()
+{
+    if (_batchSize == 0)
+        return;
+
+    // one splice links all the batched values; nodes go in the order of records
+    BatchIt first = { _batch };
+    BatchIt last = { _batch + _batchSize };
+    std::exception_ptr error;
+    Node *node = nullptr;
+    try
+    {
+        node = _lst.insertRangeAfter(nullptr, first, last);
+    }
+    catch (...)
+    {
+        // the list stays unchanged, so every batched append fails
+        error = std::current_exception();
+    }
+
+    for (std::size_t i = 0; i < _batchSize; ++i)
+    {
+        Call &call = *_batch[i]->call;
+        call.resNode = node;
+        call.error = error;
+        if (node != nullptr)
+            node = node->getNext();
+        _batch[i]->state.store(REC_DONE, std::memory_order_release);
+    }
+    _batchSize = 0;
+}
+
+
+template<typename T, typename Policy>
+typename FlatCombiningBidiList<T, Policy>::Node *
+FlatCombiningBidiList<T, Policy>::runOnNodes(Op op, Node *node, Node *insNode)
+{
+    Call call(op);
+    call.node = node;
+    call.insNode = insNode;
+    run(call);
+    return call.resNode;
+}
+
+
+template<typename T, typename Policy>
+typename FlatCombiningBidiList<T, Policy>::Node *
+FlatCombiningBidiList<T, Policy>::appendEl(const T &val)
+{
+    Call call(OP_APPEND);
+    call.val = &val;
+    run(call);
+    return call.resNode;
+}
+
+
+template<typename T, typename Policy>
+typename FlatCombiningBidiList<T, Policy>::Node *
+FlatCombiningBidiList<T, Policy>::insertNodeAfter(Node *node, Node *insNode)
+{
+    return runOnNodes(OP_INSERT_AFTER, node, insNode);
+}
+
+
+template<typename T, typename Policy>
+typename FlatCombiningBidiList<T, Policy>::Node *
+FlatCombiningBidiList<T, Policy>::insertNodeBefore(Node *node, Node *insNode)
+{
+    return runOnNodes(OP_INSERT_BEFORE, node, insNode);
+}
+
+
+template<typename T, typename Policy>
+typename FlatCombiningBidiList<T, Policy>::Node *
+FlatCombiningBidiList<T, Policy>::cutNode(Node *node)
+{
+    return runOnNodes(OP_CUT_NODE, node, nullptr);
+}
+
+
+template<typename T, typename Policy>
+typename FlatCombiningBidiList<T, Policy>::Node *
+FlatCombiningBidiList<T, Policy>::cutFirst(const T &val)
+{
+    Call call(OP_CUT_FIRST);
+    call.val = &val;
+    run(call);
+    return call.resNode;
+}
+
+
+template<typename T, typename Policy>
+typename FlatCombiningBidiList<T, Policy>::Node *
+FlatCombiningBidiList<T, Policy>::findFirst(const T &val)
+{
+    Call call(OP_FIND_FIRST);
+    call.val = &val;
+    run(call);
+    return call.resNode;
+}
+
+
+template<typename T, typename Policy>
+std::size_t FlatCombiningBidiList<T, Policy>::count(const T &val)
+{
+    Call call(OP_COUNT);
+    call.val = &val;
+    run(call);
+    return call.resCount;
+}
+
+
+template<typename T, typename Policy>
+std::size_t FlatCombiningBidiList<T, Policy>::getSize()
+{
+    Call call(OP_SIZE);
+    run(call);
+    return call.resCount;
+}
+
+
+template<typename T, typename Policy>
+template<typename Func>
+void FlatCombiningBidiList<T, Policy>::apply(Func func)
+{
+    Call call(OP_APPLY);
+    call.func = &invoke<Func>;
+    call.ctx = &func;
+    run(call);
+}
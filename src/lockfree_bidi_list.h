@@ -0,0 +1,251 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the lock-free bidirectional list template.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_LOCKFREELIST_H_
+#define XI_ENHLINKEDLIST_LOCKFREELIST_H_
+
+#include <atomic>
+#include <cstddef>      // size_t
+#include <cstdint>
+
+#include "epoch_reclaimer.h"
+
+
+/** \brief Declares a bidirectional list whose methods never block each other
+ *
+ *  Next links form a Harris list: a node is deleted by setting a mark bit in its
+ *  own next link, which freezes it, and is then unlinked by a CAS on the next link
+ *  of its predecessor, by the deleting thread or by any other one passing by.
+ *  Insertions are CASes on a next link too. These CASes are the linearization
+ *  points, so the list is as consistent as a single-threaded one in forward
+ *  order.
+ *
+ *  Previous links are *hints*: they are updated after the CASes and checked
+ *  against the next link of the hinted node before use. A wrong hint only makes
+ *  a search for a predecessor start from the head. Thus insertNodeBefore(),
+ *  pushBack() and popBack() are O(1) while threads do not race on the same spot.
+ *
+ *  Memory is reclaimed by an EpochReclaimer. Every method enters a guard itself;
+ *  a caller that keeps a `Node*` returned by the list (findFirst(), getHeadNode()
+ *  and so on) must hold a ReadGuard for as long as it uses the node. Deleted nodes
+ *  belong to the list, so cuts return values or flags rather than nodes. A node
+ *  may be stale in a hint for up to one grace period after its deletion, so nodes
+ *  are freed after two of them. Retiring a node takes no lock, nor does the
+ *  reclaim() it triggers now and then wait for another thread's one.
+ *
+ *  Values are read without synchronization and cannot be changed after
+ *  insertion. **Requirements to a `T`** are the same as for BidiLinkedList.
+ */
+template<typename T>
+class LockFreeBidiList
+{
+public:
+    //-----<Types>-----
+
+    /** \brief Node of a lock-free list */
+    class Node
+    {
+        friend class LockFreeBidiList;
+
+    public:
+        /** \brief Default constructor */
+        Node() : _next(0), _prev(nullptr) {}
+
+        /** \brief Inititalization with a node element */
+        Node(const T &el) : _val(el), _next(0), _prev(nullptr) {}
+
+        Node(const Node &) = delete;
+        Node &operator=(const Node &) = delete;
+
+    public:
+        /** \brief Returns node's value */
+        const T &getValue() const { return _val; }
+
+        /** \brief Returns whether the node has been deleted from a list */
+        bool isDeleted() const { return isMarked(_next.load()); }
+
+    protected:
+        T _val;                         ///< Storage a value
+        std::atomic<uintptr_t> _next;   ///< Next node; the lowest bit marks deletion
+        std::atomic<Node *> _prev;      ///< Hint to a previous node
+    }; // class Node
+
+    /** \brief Scope in which nodes returned by the list stay allocated */
+    class ReadGuard : public EpochReclaimer::Guard
+    {
+    public:
+        explicit ReadGuard(LockFreeBidiList &lst) : EpochReclaimer::Guard(lst._reclaimer) {}
+    };
+
+public:
+    /** \brief Default constructor */
+    LockFreeBidiList();
+
+    /** \brief Destructor; must not run concurrently with other methods */
+    ~LockFreeBidiList();
+
+    LockFreeBidiList(const LockFreeBidiList &) = delete;
+    LockFreeBidiList &operator=(const LockFreeBidiList &) = delete;
+
+public:
+    //-----<Structure>-----
+
+    /** \brief Inserts a free node \a insNode after \a node, which must belong to the list
+     *
+     *  If \a node is nullptr, \a insNode is appended. Returns \a insNode, or nullptr
+     *  if \a node has been deleted; \a insNode stays with a caller then. The list
+     *  owns inserted nodes. If \a insNode is nullptr, an exception is thrown.
+     */
+    Node *insertNodeAfter(Node *node, Node *insNode);
+
+    /** \brief Inserts a free node \a insNode before \a node, nullptr to prepend it;
+     *  see insertNodeAfter()
+     */
+    Node *insertNodeBefore(Node *node, Node *insNode);
+
+    /** \brief Appends a given element (to the end) and returns a new node */
+    Node *pushBack(const T &val) { return insertNode(&_tail, new Node(val), false); }
+
+    /** \brief Prepends a given element and returns a new node */
+    Node *pushFront(const T &val) { return insertNode(&_head, new Node(val), true); }
+
+    /** \brief Deletes \a node, which must belong to the list
+     *
+     *  Returns false if the node has already been deleted by someone else. If
+     *  \a node is nullptr, an exception is thrown.
+     */
+    bool cutNode(Node *node);
+
+    /** \brief Deletes a first node and writes its value to \a val; returns false if
+     *  the list is empty
+     */
+    bool popFront(T &val);
+
+    /** \brief Deletes a last node and writes its value to \a val; returns false if
+     *  the list is empty
+     */
+    bool popBack(T &val);
+
+    /** \brief Deletes all the nodes */
+    void clear();
+
+public:
+    //-----<Search>-----
+
+    /** \brief Finds first node carrying \a val, or returns nullptr; see ReadGuard */
+    Node *findFirst(const T &val);
+
+    /** \brief Returns whether any node carries a given value \a val */
+    bool contains(const T &val);
+
+    /** \brief Returns a number of nodes carrying a given value \a val */
+    std::size_t count(const T &val);
+
+    /** \brief Deletes a first node carrying \a val; returns false if there is none */
+    bool cutFirst(const T &val);
+
+    /** \brief Deletes all the nodes carrying \a val and returns their number */
+    std::size_t cutAll(const T &val);
+
+public:
+    //-----<Access>-----
+
+    /** \brief Returns a first node, or nullptr for an empty list; see ReadGuard */
+    Node *getHeadNode() { return getNextNode(&_head); }
+
+    /** \brief Returns a last node, or nullptr for an empty list; see ReadGuard */
+    Node *getLastNode() { return getPrevNode(&_tail); }
+
+    /** \brief Returns a node after \a node that is not deleted, or nullptr
+     *
+     *  A deleted \a node still leads on to the rest of the list.
+     */
+    Node *getNextNode(Node *node)
+    {
+        EpochReclaimer::Guard guard(_reclaimer);
+        return nextLive(node);
+    }
+
+    /** \brief Returns a node before \a node that is not deleted, or nullptr if
+     *  there is none or \a node is deleted
+     */
+    Node *getPrevNode(Node *node)
+    {
+        EpochReclaimer::Guard guard(_reclaimer);
+        return prevLive(node);
+    }
+
+    /** \brief Returns a number of nodes; exact while there are no concurrent updates */
+    std::size_t getSize() const { return _size.load(std::memory_order_relaxed); }
+
+    /** \brief Returns whether the list is empty */
+    bool isEmpty() { return getHeadNode() == nullptr; }
+
+    /** \brief Returns the reclaimer of deleted nodes */
+    EpochReclaimer &getReclaimer() { return _reclaimer; }
+
+protected:
+    //-----<Consts>------
+    /** \brief Grace periods a deleted node waits, see the class description */
+    static const unsigned NODE_GRACE_PERIODS = 2;
+
+protected:
+    static bool isMarked(uintptr_t link) { return (link & 1) != 0; }
+    static Node *ptrOf(uintptr_t link) { return reinterpret_cast<Node *>(link & ~(uintptr_t) 1); }
+    static uintptr_t linkOf(Node *node) { return reinterpret_cast<uintptr_t>(node); }
+
+    /** \brief Inserts \a insNode after \a node if \a after is set, or before it;
+     *  a caller holds no guard
+     */
+    Node *insertNode(Node *node, Node *insNode, bool after);
+
+    /** \brief Returns a node whose next link points to \a node and is not marked,
+     *  or nullptr if \a node is not reachable; unlinks deleted nodes on the way
+     */
+    Node *findPrev(Node *node);
+
+    /** \brief Implements getNextNode(); a caller holds a guard */
+    Node *nextLive(Node *node);
+
+    /** \brief Implements getPrevNode(); a caller holds a guard */
+    Node *prevLive(Node *node);
+
+    /** \brief Unlinks a marked \a node following \a prev; returns false if \a prev
+     *  does not point to it anymore
+     */
+    bool unlinkAfter(Node *prev, Node *node);
+
+    /** \brief Marks \a node as deleted and unlinks it; returns false if it has
+     *  already been marked
+     */
+    bool deleteNode(Node *node);
+
+    /** \brief Stores \a prev as a hint of \a node, falling back to the head if it
+     *  turns out to be wrong
+     */
+    void setHint(Node *node, Node *prev);
+
+protected:
+    Node _head;                         ///< Sentinel before the first node
+    Node _tail;                         ///< Sentinel after the last node
+    std::atomic<std::size_t> _size;     ///< Number of nodes
+    EpochReclaimer _reclaimer;          ///< Frees deleted nodes
+}; // class LockFreeBidiList
+
+
+// declaration of template class template methods
+#include "lockfree_bidi_list.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_LOCKFREELIST_H_
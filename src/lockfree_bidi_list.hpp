@@ -0,0 +1,349 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the lock-free bidirectional
+/// list template declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+
+
+//==============================================================================
+// class LockFreeBidiList<T>
+//==============================================================================
+
+
+template<typename T>
+LockFreeBidiList<T>::LockFreeBidiList() : _size(0)
+{
+    _head._next.store(linkOf(&_tail));
+    _tail._prev.store(&_head);
+}
+
+
+template<typename T>
+LockFreeBidiList<T>::~LockFreeBidiList()
+{
+    // nodes still linked, marked or not; unlinked ones are owned by the reclaimer
+    Node *node = ptrOf(_head._next.load());
+    while (node != &_tail)
+    {
+        Node *next = ptrOf(node->_next.load());
+        delete node;
+        node = next;
+    }
+}
+
+
+template<typename T>
+void LockFreeBidiList<T>::setHint(Node *node, Node *prev)
+{
+    node->_prev.store(prev);
+
+    // a hint is only kept while it is right, so that no hint outlives a deleted
+    // node by more than a grace period
+    if (prev->_next.load() != linkOf(node))
+        node->_prev.compare_exchange_strong(prev, &_head);
+}
+
+
+template<typename T>
+typename LockFreeBidiList<T>::Node *
+LockFreeBidiList<T>::findPrev(Node *node)
+{
+    Node *hint = node->_prev.load();
+    if (hint != nullptr && hint->_next.load() == linkOf(node))
+        return hint;
+
+    for (;;)
+    {
+        Node *prev = &_head;
+        uintptr_t link = prev->_next.load();
+        for (;;)
+        {
+            // prev has been deleted meanwhile
+            if (isMarked(link))
+                break;
+
+            Node *cur = ptrOf(link);
+            if (cur == node)
+                return prev;
+            if (cur == &_tail)
+                return nullptr;
+
+            uintptr_t curLink = cur->_next.load();
+            if (isMarked(curLink))
+            {
+                // help a deleting thread
+                unlinkAfter(prev, cur);
+                link = prev->_next.load();
+                continue;
+            }
+
+            prev = cur;
+            link = curLink;
+        }
+    }
+}
+
+
+template<typename T>
+bool LockFreeBidiList<T>::unlinkAfter(Node *prev, Node *node)
+{
+    // the next link of a marked node never changes
+    Node *succ = ptrOf(node->_next.load());
+    uintptr_t expected = linkOf(node);
+    if (!prev->_next.compare_exchange_strong(expected, linkOf(succ)))
+        return false;
+
+    setHint(succ, prev);
+    _reclaimer.retire(node, NODE_GRACE_PERIODS);
+    return true;
+}
+
+
+template<typename T>
+bool LockFreeBidiList<T>::deleteNode(Node *node)
+{
+    uintptr_t link = node->_next.load();
+    do
+    {
+        if (isMarked(link))
+            return false;
+    } while (!node->_next.compare_exchange_weak(link, link | 1));
+
+    _size.fetch_sub(1, std::memory_order_relaxed);
+
+    // if the predecessor is not found, someone has unlinked the node already
+    for (;;)
+    {
+        Node *prev = findPrev(node);
+        if (prev == nullptr || unlinkAfter(prev, node))
+            return true;
+    }
+}
+
+
+template<typename T>
+typename LockFreeBidiList<T>::Node *
+LockFreeBidiList<T>::insertNode(Node *node, Node *insNode, bool after)
+{
+    EpochReclaimer::Guard guard(_reclaimer);
+    for (;;)
+    {
+        Node *prev;
+        uintptr_t link;
+        if (after)
+        {
+            prev = node;
+            link = prev->_next.load();
+            if (isMarked(link))
+                return nullptr;
+        } else
+        {
+            if (isMarked(node->_next.load()))
+                return nullptr;
+            prev = findPrev(node);
+            if (prev == nullptr)
+                return nullptr;
+            link = linkOf(node);
+        }
+
+        insNode->_next.store(link);
+        insNode->_prev.store(prev);
+        if (prev->_next.compare_exchange_strong(link, linkOf(insNode)))
+        {
+            _size.fetch_add(1, std::memory_order_relaxed);
+            setHint(ptrOf(insNode->_next.load()), insNode);
+            return insNode;
+        }
+    }
+}
+
+
+template<typename T>
+typename LockFreeBidiList<T>::Node *
+LockFreeBidiList<T>::insertNodeAfter(Node *node, Node *insNode)
+{
+    if (insNode == nullptr)
+        throw std::invalid_argument("INA NP");
+
+    return node ? insertNode(node, insNode, true) : insertNode(&_tail, insNode, false);
+}
+
+
+template<typename T>
+typename LockFreeBidiList<T>::Node *
+LockFreeBidiList<T>::insertNodeBefore(Node *node, Node *insNode)
+{
+    if (insNode == nullptr)
+        throw std::invalid_argument("INB NP");
+
+    return node ? insertNode(node, insNode, false) : insertNode(&_head, insNode, true);
+}
+
+
+template<typename T>
+bool LockFreeBidiList<T>::cutNode(Node *node)
+{
+    if (node == nullptr)
+        throw std::invalid_argument("CNS NP");
+
+    EpochReclaimer::Guard guard(_reclaimer);
+    return deleteNode(node);
+}
+
+
+template<typename T>
+typename LockFreeBidiList<T>::Node *
+LockFreeBidiList<T>::nextLive(Node *node)
+{
+    for (Node *cur = ptrOf(node->_next.load()); cur != &_tail; )
+    {
+        uintptr_t link = cur->_next.load();
+        if (!isMarked(link))
+            return cur;
+        cur = ptrOf(link);
+    }
+
+    return nullptr;
+}
+
+
+template<typename T>
+typename LockFreeBidiList<T>::Node *
+LockFreeBidiList<T>::prevLive(Node *node)
+{
+    // a found predecessor points to the node by an unmarked link, so it is alive;
+    // the node itself may be marked, but not unlinked yet, and then it has none
+    Node *prev = findPrev(node);
+    if (prev == nullptr || prev == &_head || isMarked(node->_next.load()))
+        return nullptr;
+
+    return prev;
+}
+
+
+template<typename T>
+bool LockFreeBidiList<T>::popFront(T &val)
+{
+    EpochReclaimer::Guard guard(_reclaimer);
+    for (;;)
+    {
+        Node *first = nextLive(&_head);
+        if (first == nullptr)
+            return false;
+
+        // the node stays allocated until the guard ends
+        if (deleteNode(first))
+        {
+            val = first->_val;
+            return true;
+        }
+    }
+}
+
+
+template<typename T>
+bool LockFreeBidiList<T>::popBack(T &val)
+{
+    EpochReclaimer::Guard guard(_reclaimer);
+    for (;;)
+    {
+        Node *last = prevLive(&_tail);
+        if (last == nullptr)
+            return false;
+
+        if (deleteNode(last))
+        {
+            val = last->_val;
+            return true;
+        }
+    }
+}
+
+
+template<typename T>
+void LockFreeBidiList<T>::clear()
+{
+    EpochReclaimer::Guard guard(_reclaimer);
+    while (Node *first = nextLive(&_head))
+        deleteNode(first);
+}
+
+
+template<typename T>
+typename LockFreeBidiList<T>::Node *
+LockFreeBidiList<T>::findFirst(const T &val)
+{
+    EpochReclaimer::Guard guard(_reclaimer);
+    for (Node *node = nextLive(&_head); node != nullptr; node = nextLive(node))
+    {
+        if (node->_val == val)
+            return node;
+    }
+
+    return nullptr;
+}
+
+
+template<typename T>
+bool LockFreeBidiList<T>::contains(const T &val)
+{
+    EpochReclaimer::Guard guard(_reclaimer);
+    return findFirst(val) != nullptr;
+}
+
+
+template<typename T>
+std::size_t LockFreeBidiList<T>::count(const T &val)
+{
+    EpochReclaimer::Guard guard(_reclaimer);
+    std::size_t res = 0;
+    for (Node *node = nextLive(&_head); node != nullptr; node = nextLive(node))
+    {
+        if (node->_val == val)
+            ++res;
+    }
+
+    return res;
+}
+
+
+template<typename T>
+bool LockFreeBidiList<T>::cutFirst(const T &val)
+{
+    EpochReclaimer::Guard guard(_reclaimer);
+    for (;;)
+    {
+        Node *node = findFirst(val);
+        if (node == nullptr)
+            return false;
+        if (deleteNode(node))
+            return true;
+    }
+}
+
+
+template<typename T>
+std::size_t LockFreeBidiList<T>::cutAll(const T &val)
+{
+    EpochReclaimer::Guard guard(_reclaimer);
+    std::size_t res = 0;
+    for (Node *node = nextLive(&_head); node != nullptr; node = nextLive(node))
+    {
+        // a marked node still leads on to the rest of the list
+        if (node->_val == val && deleteNode(node))
+            ++res;
+    }
+
+    return res;
+}
@@ -0,0 +1,227 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the bidirectional list template whose
+/// scans run in parallel over segments between checkpoints.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_PARALLELLIST_H_
+#define XI_ENHLINKEDLIST_PARALLELLIST_H_
+
+#include <cstddef>      // size_t
+#include <vector>
+
+#include "bidi_linked_list.h"
+#include "bidi_thread_pool.h"
+
+
+/** \brief Declares a BidiLinkedList that keeps checkpoints, so that a scan of the
+ *  whole list can be split among threads of a BidiThreadPool
+ *
+ *  A checkpoint is remembered every `checkpointStep` nodes from the head; the
+ *  checkpoints split the list into segments of about that many nodes in
+ *  O(segments), and every segment is scanned by a task of its own. Results are
+ *  merged in list order. Searches, visits, in-place transforms and reductions
+ *  are run this way.
+ *
+ *  Appends keep checkpoints up to date as they go, as do cuts at the ends of the
+ *  list. Other insertions only make segments longer, until they have added half
+ *  of the list, and then checkpoints are dropped. Cuts elsewhere drop them at once,
+ *  since a cut node could be a checkpoint. Dropped checkpoints are rebuilt by one
+ *  pass over the list before the next parallel operation.
+ *
+ *  Methods that move nodes around, such as relinearize() or reverse(), are not
+ *  available, nor are self-organizing and reversible policies. The list is
+ *  changed by one thread at a time, as BidiLinkedList is; only parallel
+ *  operations use other threads, and only while they run.
+ */
+template<typename T, typename Policy = DefaultBidiListPolicy>
+class ParallelBidiList : protected BidiLinkedList<T, Policy>
+{
+    typedef BidiLinkedList<T, Policy> Base;
+
+    static_assert(Policy::SELF_ORGANIZATION == BIDI_SELF_ORG_NONE, "searches would move nodes past checkpoints");
+    static_assert(!Policy::REVERSIBLE, "reversing would turn segments around");
+
+public:
+    //-----<Types>-----
+    typedef typename Base::Node Node;
+    typedef typename Base::iterator iterator;
+    typedef typename Base::const_iterator const_iterator;
+    typedef typename Base::reverse_iterator reverse_iterator;
+    typedef typename Base::const_reverse_iterator const_reverse_iterator;
+
+public:
+    //-----<Consts>------
+    /** \brief Default number of nodes between checkpoints */
+    static const std::size_t DEFAULT_CHECKPOINT_STEP = 65536;
+
+public:
+    /** \brief Creates a list remembering every \a checkpointStep-th node, which runs
+     *  parallel operations on \a pool
+     */
+    explicit ParallelBidiList(std::size_t checkpointStep = DEFAULT_CHECKPOINT_STEP,
+                              BidiThreadPool &pool = BidiThreadPool::getDefault());
+
+    ParallelBidiList(const ParallelBidiList &) = delete;
+    ParallelBidiList &operator=(const ParallelBidiList &) = delete;
+
+public:
+    //-----<Access and sequential search>-----
+
+    using Base::begin;
+    using Base::end;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::crbegin;
+    using Base::crend;
+
+    using Base::getHeadNode;
+    using Base::getLastNode;
+    using Base::getNextNode;
+    using Base::getPrevNode;
+    using Base::getSize;
+
+    using Base::findFirst;
+    using Base::findAll;
+    using Base::count;
+    using Base::contains;
+    using Base::forEach;
+
+public:
+    //-----<Modifiers>-----
+    // see the methods of BidiLinkedList of the same names
+
+    Node *appendEl(const T &val);
+    void pushBack(const T &val) { appendEl(val); }
+    void pushFront(const T &val);
+    Node *insertNodeAfter(Node *node, Node *insNode);
+    Node *insertNodeBefore(Node *node, Node *insNode);
+
+    template<typename InputIt>
+    Node *appendRange(InputIt first, InputIt last);
+
+    void cutNodes(Node *beg, Node *end);
+    Node *cutNode(Node *node);
+    Node *cutFirst(const T &val);
+    T popFront();
+    T popBack();
+    void clear();
+
+public:
+    //-----<Parallel operations>-----
+
+    /** \brief Returns a number of nodes carrying \a val, see count() */
+    std::size_t parallelCount(const T &val);
+
+    /** \brief Finds all nodes carrying \a val, see findAll(): the array is in list
+     *  order and must be freed by a caller
+     */
+    Node **parallelFindAll(const T &val, int &size);
+
+    /** \brief Cuts all nodes carrying \a val and returns an array of them, as
+     *  parallelFindAll() does
+     *
+     *  Nodes are searched for in parallel and then cut by the calling thread, which
+     *  takes O(1) per node.
+     */
+    Node **parallelCutAll(const T &val, int &size);
+
+    /** \brief Calls `func(const T&)` for the value of every node; calls for one
+     *  segment are made in list order, those for different ones concurrently
+     */
+    template<typename Func>
+    void parallelForEach(Func func);
+
+    /** \brief Replaces the value of every node by `func(const T&)` of it, through
+     *  Node::setValue()
+     */
+    template<typename Func>
+    void parallelTransform(Func func);
+
+    /** \brief Folds values of the list: every segment is folded from \a identity by
+     *  `reduce(R, const T&)` in list order, then results of segments are folded by
+     *  `combine(R, R)` from \a identity in list order as well
+     *
+     *  The order of operations does not depend on threads, so neither does the
+     *  result, even if the operations are not associative, as floating point ones
+     *  are; only the checkpoints, that is the history of the list, change it.
+     */
+    template<typename R, typename Reduce, typename Combine>
+    R parallelReduce(const R &identity, Reduce reduce, Combine combine);
+
+    /** \brief Returns a number of segments parallel operations split the list into */
+    std::size_t getSegmentCount();
+
+    /** \brief Returns a number of nodes between checkpoints */
+    std::size_t getCheckpointStep() const { return _step; }
+
+    /** \brief Returns the pool running parallel operations */
+    BidiThreadPool &getPool() const { return *_pool; }
+
+    /** \brief Makes parallel operations run on \a pool */
+    void setPool(BidiThreadPool &pool) { _pool = &pool; }
+
+protected:
+    /** \brief Updates checkpoints for nodes from \a beg to the tail, just appended */
+    void noteAppended(Node *beg);
+
+    /** \brief Updates checkpoints for \a node, just inserted */
+    void noteInserted(Node *node);
+
+    /** \brief Updates checkpoints for a chain `[beg, end]` about to be cut */
+    void noteCut(Node *beg, Node *end);
+
+    /** \brief Drops checkpoints until the next parallel operation */
+    void dropCheckpoints() { _valid = false; }
+
+    /** \brief Rebuilds dropped checkpoints */
+    void ensureCheckpoints();
+
+    /** \brief Calls `visit(seg, beg, stop)` on the pool for every segment `seg`,
+     *  which runs from \a beg to the node before \a stop
+     */
+    template<typename Visit>
+    void forSegments(Visit visit);
+
+    /** \brief Calls `func(node)` for every node of a segment from \a beg to the node
+     *  before \a stop
+     */
+    template<typename Func>
+    void forNodes(Node *beg, Node *stop, Func func) const;
+
+    /** \brief Collects nodes carrying \a val by segments; returns their total number
+     *  and sets \a hasCheckpoint if a checkpoint is among them
+     */
+    std::size_t collect(const T &val, std::vector<std::vector<Node *> > &found, bool &hasCheckpoint);
+
+    /** \brief Copies nodes collected by collect() into a new array in order */
+    static Node **flatten(const std::vector<std::vector<Node *> > &found, std::size_t total);
+
+protected:
+    BidiThreadPool *_pool;
+    std::size_t _step;                  ///< Number of nodes between checkpoints
+
+    /** \brief Every #_step-th node from the head, the head included, while #_valid */
+    std::vector<Node *> _checkpoints;
+    std::size_t _lastRun;               ///< Number of nodes from the last checkpoint on
+    std::size_t _inserted;              ///< Nodes inserted in the middle since a rebuild
+    bool _valid;                        ///< Whether checkpoints are up to date
+}; // class ParallelBidiList
+
+
+// declaration of template class template methods
+#include "parallel_bidi_list.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_PARALLELLIST_H_
@@ -0,0 +1,467 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the parallel bidirectional
+/// list template declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+
+
+//==============================================================================
+// class ParallelBidiList<T, Policy>
+//==============================================================================
+
+
+template<typename T, typename Policy>
+ParallelBidiList<T, Policy>::ParallelBidiList(std::size_t checkpointStep, BidiThreadPool &pool)
+    : _pool(&pool)
+    , _step(checkpointStep)
+    , _lastRun(0)
+    , _inserted(0)
+    , _valid(true)
+{
+    if (checkpointStep == 0)
+        throw std::invalid_argument("PL STEP");
+}
+
+
+//-----<Checkpoints>-----
+
+
+template<typename T, typename Policy>
+void ParallelBidiList<T, Policy>::noteAppended(Node *beg)
+{
+    if (!_valid)
+        return;
+
+    for (Node *node = beg; node != nullptr; node = node->getNext())
+    {
+        if (_checkpoints.empty() || _lastRun == _step)
+        {
+            _checkpoints.push_back(node);
+            _lastRun = 1;
+        } else
+            ++_lastRun;
+    }
+}
+
+
+template<typename T, typename Policy>
+void ParallelBidiList<T, Policy>::noteInserted(Node *node)
+{
+    if (!_valid)
+        return;
+
+    if (node->getNext() == nullptr)
+    {
+        noteAppended(node);
+        return;
+    }
+
+    // the node joins some segment; the head must stay the first checkpoint
+    if (node->getPrev() == nullptr)
+        _checkpoints.front() = node;
+    if (++_inserted * 2 > _checkpoints.size() * _step)
+        dropCheckpoints();
+}
+
+
+template<typename T, typename Policy>
+void ParallelBidiList<T, Policy>::noteCut(Node *beg, Node *end)
+{
+    if (!_valid)
+        return;
+
+    bool atHead = beg->getPrev() == nullptr;
+    bool atTail = end->getNext() == nullptr;
+    if (atHead && atTail)
+    {
+        _checkpoints.clear();
+        _lastRun = 0;
+        _inserted = 0;
+    } else if (atHead && beg == end)
+    {
+        // the next node takes the place of the head, unless it is a checkpoint already
+        Node *next = beg->getNext();
+        if (_checkpoints.size() > 1 && _checkpoints[1] == next)
+            _checkpoints.erase(_checkpoints.begin());
+        else
+        {
+            _checkpoints.front() = next;
+            if (_checkpoints.size() == 1)
+                --_lastRun;
+        }
+    } else if (atTail && beg == end)
+    {
+        // the segment before the last one is taken as full
+        if (_checkpoints.back() == end)
+        {
+            _checkpoints.pop_back();
+            _lastRun = _step;
+        } else if (_lastRun > 1)
+            --_lastRun;
+    } else
+        dropCheckpoints();
+}
+
+
+template<typename T, typename Policy>
+void ParallelBidiList<T, Policy>::ensureCheckpoints()
+{
+    if (_valid)
+        return;
+
+    _checkpoints.clear();
+    std::size_t i = 0;
+    this->traverse(getHeadNode(), [this, &i](Node *node)
+    {
+        if (i++ % _step == 0)
+            _checkpoints.push_back(node);
+        return false;
+    });
+
+    _lastRun = i == 0 ? 0 : (i - 1) % _step + 1;
+    _inserted = 0;
+    _valid = true;
+}
+
+
+template<typename T, typename Policy>
+std::size_t ParallelBidiList<T, Policy>::getSegmentCount()
+{
+    ensureCheckpoints();
+    return _checkpoints.size();
+}
+
+
+//-----<Modifiers>-----
+
+
+template<typename T, typename Policy>
+typename ParallelBidiList<T, Policy>::Node *
+ParallelBidiList<T, Policy>::appendEl(const T &val)
+{
+    Node *node = Base::appendEl(val);
+    noteAppended(node);
+    return node;
+}
+
+
+template<typename T, typename Policy>
+void ParallelBidiList<T, Policy>::pushFront(const T &val)
+{
+    Base::pushFront(val);
+    noteInserted(getHeadNode());
+}
+
+
+template<typename T, typename Policy>
+typename ParallelBidiList<T, Policy>::Node *
+ParallelBidiList<T, Policy>::insertNodeAfter(Node *node, Node *insNode)
+{
+    Node *res = Base::insertNodeAfter(node, insNode);
+    if (res != nullptr)
+        noteInserted(res);
+
+    return res;
+}
+
+
+template<typename T, typename Policy>
+typename ParallelBidiList<T, Policy>::Node *
+ParallelBidiList<T, Policy>::insertNodeBefore(Node *node, Node *insNode)
+{
+    Node *res = Base::insertNodeBefore(node, insNode);
+    if (res != nullptr)
+        noteInserted(res);
+
+    return res;
+}
+
+
+template<typename T, typename Policy>
+template<typename InputIt>
+typename ParallelBidiList<T, Policy>::Node *
+ParallelBidiList<T, Policy>::appendRange(InputIt first, InputIt last)
+{
+    Node *beg = Base::appendRange(first, last);
+    if (beg != nullptr)
+        noteAppended(beg);
+
+    return beg;
+}
+
+
+template<typename T, typename Policy>
+void ParallelBidiList<T, Policy>::cutNodes(Node *beg, Node *end)
+{
+    if (beg != nullptr && end != nullptr)
+        noteCut(beg, end);
+
+    Base::cutNodes(beg, end);
+}
+
+
+template<typename T, typename Policy>
+typename ParallelBidiList<T, Policy>::Node *
+ParallelBidiList<T, Policy>::cutNode(Node *node)
+{
+    cutNodes(node, node);
+    return node;
+}
+
+
+template<typename T, typename Policy>
+typename ParallelBidiList<T, Policy>::Node *
+ParallelBidiList<T, Policy>::cutFirst(const T &val)
+{
+    std::size_t tag = Node::tagOf(val);
+    Node *res = this->traverse(getHeadNode(), [&val, tag](Node *node) { return Base::carries(node, val, tag); });
+    if (res)
+        return cutNode(res);
+
+    return nullptr;
+}
+
+
+template<typename T, typename Policy>
+T ParallelBidiList<T, Policy>::popFront()
+{
+    Node *head = getHeadNode();
+    if (head != nullptr)
+        noteCut(head, head);
+
+    return Base::popFront();
+}
+
+
+template<typename T, typename Policy>
+T ParallelBidiList<T, Policy>::popBack()
+{
+    Node *last = getLastNode();
+    if (last != nullptr)
+        noteCut(last, last);
+
+    return Base::popBack();
+}
+
+
+template<typename T, typename Policy>
+void ParallelBidiList<T, Policy>::clear()
+{
+    Base::clear();
+    _checkpoints.clear();
+    _lastRun = 0;
+    _inserted = 0;
+    _valid = true;
+}
+
+
+//-----<Parallel operations>-----
+
+
+template<typename T, typename Policy>
+template<typename Visit>
+void ParallelBidiList<T, Policy>::forSegments(Visit visit)
+{
+    ensureCheckpoints();
+    const std::vector<Node *> &checkpoints = _checkpoints;
+    std::size_t segs = checkpoints.size();
+    _pool->run(segs, [&checkpoints, &visit, segs](std::size_t seg)
+    {
+        visit(seg, checkpoints[seg], seg + 1 < segs ? checkpoints[seg + 1] : nullptr);
+    });
+}
+
+
+template<typename T, typename Policy>
+template<typename Func>
+void ParallelBidiList<T, Policy>::forNodes(Node *beg, Node *stop, Func func) const
+{
+    this->traverse(beg, [stop, &func](Node *node)
+    {
+        if (node == stop)
+            return true;
+        func(node);
+        return false;
+    });
+}
+
+
+template<typename T, typename Policy>
+template<typename Func>
+void ParallelBidiList<T, Policy>::parallelForEach(Func func)
+{
+    forSegments([this, &func](std::size_t, Node *beg, Node *stop)
+    {
+        forNodes(beg, stop, [&func](Node *node) { func(const_cast<const Node *>(node)->getValue()); });
+    });
+}
+
+
+template<typename T, typename Policy>
+template<typename Func>
+void ParallelBidiList<T, Policy>::parallelTransform(Func func)
+{
+    forSegments([this, &func](std::size_t, Node *beg, Node *stop)
+    {
+        forNodes(beg, stop, [&func](Node *node) { node->setValue(func(const_cast<const Node *>(node)->getValue())); });
+    });
+}
+
+
+template<typename T, typename Policy>
+template<typename R, typename Reduce, typename Combine>
+R ParallelBidiList<T, Policy>::parallelReduce(const R &identity, Reduce reduce, Combine combine)
+{
+    ensureCheckpoints();
+    std::vector<R> parts(_checkpoints.size(), identity);
+    forSegments([this, &reduce, &parts](std::size_t seg, Node *beg, Node *stop)
+    {
+        R acc = parts[seg];
+        forNodes(beg, stop, [&reduce, &acc](Node *node) { acc = reduce(acc, const_cast<const Node *>(node)->getValue()); });
+        parts[seg] = acc;
+    });
+
+    R res = identity;
+    for (std::size_t i = 0; i < parts.size(); ++i)
+        res = combine(res, parts[i]);
+
+    return res;
+}
+
+
+template<typename T, typename Policy>
+std::size_t ParallelBidiList<T, Policy>::parallelCount(const T &val)
+{
+    ensureCheckpoints();
+    std::vector<std::size_t> counts(_checkpoints.size(), 0);
+    std::size_t tag = Node::tagOf(val);
+    forSegments([this, &val, tag, &counts](std::size_t seg, Node *beg, Node *stop)
+    {
+        std::size_t res = 0;
+        this->traverse(beg, [&val, tag, stop, &res](Node *node)
+        {
+            if (node == stop)
+                return true;
+            if (Base::carries(node, val, tag))
+                ++res;
+            return false;
+        });
+        counts[seg] = res;
+    });
+
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < counts.size(); ++i)
+        total += counts[i];
+
+    return total;
+}
+
+
+template<typename T, typename Policy>
+std::size_t ParallelBidiList<T, Policy>::collect(const T &val, std::vector<std::vector<Node *> > &found,
+                                                 bool &hasCheckpoint)
+{
+    ensureCheckpoints();
+    found.assign(_checkpoints.size(), std::vector<Node *>());
+    std::vector<char> atCheckpoint(_checkpoints.size(), 0);
+
+    std::size_t tag = Node::tagOf(val);
+    forSegments([this, &val, tag, &found, &atCheckpoint](std::size_t seg, Node *beg, Node *stop)
+    {
+        std::vector<Node *> &res = found[seg];
+        this->traverse(beg, [&val, tag, stop, &res](Node *node)
+        {
+            if (node == stop)
+                return true;
+            if (Base::carries(node, val, tag))
+                res.push_back(node);
+            return false;
+        });
+        atCheckpoint[seg] = !res.empty() && res.front() == beg;
+    });
+
+    std::size_t total = 0;
+    hasCheckpoint = false;
+    for (std::size_t i = 0; i < found.size(); ++i)
+    {
+        total += found[i].size();
+        hasCheckpoint = hasCheckpoint || atCheckpoint[i];
+    }
+
+    return total;
+}
+
+
+template<typename T, typename Policy>
+typename ParallelBidiList<T, Policy>::Node **
+ParallelBidiList<T, Policy>::flatten(const std::vector<std::vector<Node *> > &found, std::size_t total)
+{
+    if (total == 0)
+        return nullptr;
+
+    Node **res = new Node *[total];
+    std::size_t i = 0;
+    for (std::size_t seg = 0; seg < found.size(); ++seg)
+        for (std::size_t j = 0; j < found[seg].size(); ++j)
+            res[i++] = found[seg][j];
+
+    return res;
+}
+
+
+template<typename T, typename Policy>
+typename ParallelBidiList<T, Policy>::Node **
+ParallelBidiList<T, Policy>::parallelFindAll(const T &val, int &size)
+{
+    std::vector<std::vector<Node *> > found;
+    bool hasCheckpoint;
+    std::size_t total = collect(val, found, hasCheckpoint);
+
+    size = (int) total;
+    return flatten(found, total);
+}
+
+
+template<typename T, typename Policy>
+typename ParallelBidiList<T, Policy>::Node **
+ParallelBidiList<T, Policy>::parallelCutAll(const T &val, int &size)
+{
+    std::vector<std::vector<Node *> > found;
+    bool hasCheckpoint;
+    std::size_t total = collect(val, found, hasCheckpoint);
+
+    size = (int) total;
+    if (total == 0)
+        return nullptr;
+
+    // single cuts invalidate a calculated size, which is known to drop by the total
+    bool sizeKnown = Policy::TRACK_SIZE && this->_size != Base::NO_SIZE;
+    std::size_t oldSize = this->_size;
+    for (std::size_t seg = 0; seg < found.size(); ++seg)
+        for (std::size_t j = 0; j < found[seg].size(); ++j)
+            Base::cutNodes(found[seg][j], found[seg][j]);
+    if (sizeKnown)
+        this->_size = oldSize - total;
+
+    // cut nodes that are not checkpoints only make segments shorter
+    if (hasCheckpoint)
+        dropCheckpoints();
+    else
+    {
+        std::size_t lastCut = found.back().size();
+        _lastRun = _lastRun > lastCut ? _lastRun - lastCut : 1;
+    }
+
+    return flatten(found, total);
+}
@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the bidirectional list template read
+/// without locks while one writer changes it.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_RCULIST_H_
+#define XI_ENHLINKEDLIST_RCULIST_H_
+
+#include <cstddef>      // size_t
+
+#include "bidi_linked_list.h"
+#include "epoch_reclaimer.h"
+
+
+/** \brief Policy of an RcuBidiList: atomic links and no node cache, since a cut
+ *  node may only be freed by the reclaimer
+ */
+struct RcuBidiListPolicy : DefaultBidiListPolicy
+{
+    static const bool RCU_READERS = true;
+    static const std::size_t NODE_CACHE_SIZE = 0;
+};
+
+
+/** \brief Declares a BidiLinkedList whose readers take no locks (read-copy-update)
+ *
+ *  Any number of readers traverse the list by the usual iterators and access
+ *  methods inside a ReadGuard, which costs a few atomic operations on a slot of
+ *  their own and never waits. Meanwhile *one* writer at a time changes the list;
+ *  writers are serialized by a caller, e.g. by a mutex that readers never take.
+ *
+ *  A writer publishes links with release stores after a node is initialized,
+ *  so a reader that gets to a node sees its value. Cut nodes keep their outer
+ *  links and are passed to an EpochReclaimer, which frees them once every guard
+ *  that could have reached them has ended. Hence a reader may see a cut node
+ *  or miss an inserted one, but never a freed or half-linked node.
+ *
+ *  An end iterator ends an iteration wherever the list ends by then, so it may
+ *  be taken once, as a range-based `for` does; this also saves an atomic load of
+ *  the tail per step.
+ *
+ *  Values must not be changed once nodes are inserted; replace a node instead.
+ *  Methods that move nodes around, such as relinearize() or reverse(), are not
+ *  available. **Requirements to a `T`** are the same as for BidiLinkedList.
+ */
+template<typename T, typename Policy = RcuBidiListPolicy>
+class RcuBidiList : protected BidiLinkedList<T, Policy>
+{
+    static_assert(Policy::RCU_READERS, "an RCU list needs atomic links");
+    static_assert(Policy::NODE_CACHE_SIZE == 0, "a cut node may not be reused before readers are gone");
+    static_assert(Policy::SELF_ORGANIZATION == BIDI_SELF_ORG_NONE, "readers would race with moved nodes");
+
+    typedef BidiLinkedList<T, Policy> Base;
+
+public:
+    //-----<Types>-----
+    typedef typename Base::Node Node;
+    typedef typename Base::iterator iterator;
+    typedef typename Base::const_iterator const_iterator;
+    typedef typename Base::reverse_iterator reverse_iterator;
+    typedef typename Base::const_reverse_iterator const_reverse_iterator;
+
+    /** \brief Scope in which a reader may use nodes, iterators included */
+    class ReadGuard : public EpochReclaimer::Guard
+    {
+    public:
+        explicit ReadGuard(RcuBidiList &lst) : EpochReclaimer::Guard(lst._reclaimer) {}
+    };
+
+public:
+    /** \brief Default constructor */
+    RcuBidiList() {}
+
+    /** \brief Destructor; must not run concurrently with other methods */
+    ~RcuBidiList() {}
+
+    RcuBidiList(const RcuBidiList &) = delete;
+    RcuBidiList &operator=(const RcuBidiList &) = delete;
+
+public:
+    //-----<Readers>-----
+    // called inside a ReadGuard from any number of threads
+
+    using Base::begin;
+    using Base::end;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::crbegin;
+    using Base::crend;
+
+    using Base::getHeadNode;
+    using Base::getLastNode;
+    using Base::getNextNode;
+    using Base::getPrevNode;
+
+    /** \brief Finds first node carrying \a val, or returns nullptr
+     *
+     *  Unlike BidiLinkedList::findFirst(), leaves no finger behind.
+     */
+    Node *findFirst(const T &val) const;
+
+    /** \brief Returns whether any node carries a given value \a val */
+    bool contains(const T &val) const { return findFirst(val) != nullptr; }
+
+    /** \brief Returns a number of nodes carrying a given value \a val */
+    std::size_t count(const T &val) const;
+
+    /** \brief Applies \a func to the value of every node; invoked as `func(const T&)` */
+    template<typename Func>
+    void forEach(Func func) const;
+
+public:
+    //-----<Writer>-----
+    // called by one thread at a time, concurrently with readers
+
+    using Base::appendEl;
+    using Base::pushBack;
+    using Base::pushFront;
+    using Base::insertNodeAfter;
+    using Base::insertNodeBefore;
+    using Base::insertNodesAfter;
+    using Base::insertNodesBefore;
+    using Base::insertRangeAfter;
+    using Base::appendRange;
+    using Base::getSize;
+
+    /** \brief Cuts a chain `[beg, end]` of the list and retires its nodes
+     *
+     *  The nodes belong to the reclaimer then: a caller must not use them after
+     *  its own guard, if any, has ended. If either \a beg or \a end is nullptr, an
+     *  exception is thrown.
+     */
+    void cutNodes(Node *beg, Node *end);
+
+    /** \brief Cuts \a node and retires it, see cutNodes() */
+    void cutNode(Node *node) { cutNodes(node, node); }
+
+    /** \brief Cuts and retires a first node carrying \a val; returns false if there is none */
+    bool cutFirst(const T &val);
+
+    /** \brief Cuts and retires all the nodes carrying \a val and returns their number */
+    std::size_t cutAll(const T &val);
+
+    /** \brief Cuts and retires a first node writing its value to \a val; returns
+     *  false if the list is empty
+     */
+    bool popFront(T &val);
+
+    /** \brief Cuts and retires a last node writing its value to \a val; returns
+     *  false if the list is empty
+     */
+    bool popBack(T &val);
+
+    /** \brief Cuts and retires all the nodes */
+    void clear();
+
+public:
+    //-----<Reclamation>-----
+
+    /** \brief Waits until every reader that is inside a guard now has left it and
+     *  frees retired nodes; must not be called inside a guard
+     */
+    void synchronize() { _reclaimer.synchronize(); }
+
+    /** \brief Returns the reclaimer of cut nodes */
+    EpochReclaimer &getReclaimer() { return _reclaimer; }
+
+protected:
+    /** \brief Passes nodes `[beg, end]`, which are cut already, to the reclaimer */
+    void retireChain(Node *beg, Node *end);
+
+protected:
+    // destroyed before the base, so retired nodes go first and linked ones after
+    EpochReclaimer _reclaimer;          ///< Frees cut nodes
+}; // class RcuBidiList
+
+
+// declaration of template class template methods
+#include "rcu_bidi_list.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_RCULIST_H_
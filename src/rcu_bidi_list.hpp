@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the bidirectional list
+/// template read without locks, declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+//==============================================================================
+// class RcuBidiList<T, Policy>
+//==============================================================================
+
+
+template<typename T, typename Policy>
+typename RcuBidiList<T, Policy>::Node *
+RcuBidiList<T, Policy>::findFirst(const T &val) const
+{
+    std::size_t tag = Node::tagOf(val);
+    return this->traverse(getHeadNode(), [&val, tag](Node *node) { return Base::carries(node, val, tag); });
+}
+
+
+template<typename T, typename Policy>
+std::size_t RcuBidiList<T, Policy>::count(const T &val) const
+{
+    std::size_t res = 0;
+    std::size_t tag = Node::tagOf(val);
+    this->traverse(getHeadNode(), [&val, tag, &res](Node *node)
+    {
+        if (Base::carries(node, val, tag))
+            ++res;
+        return false;
+    });
+
+    return res;
+}
+
+
+template<typename T, typename Policy>
+template<typename Func>
+void RcuBidiList<T, Policy>::forEach(Func func) const
+{
+    this->traverse(getHeadNode(), [&func](Node *node)
+    {
+        const T &val = node->getValue();
+        func(val);
+        return false;
+    });
+}
+
+
+template<typename T, typename Policy>
+void RcuBidiList<T, Policy>::retireChain(Node *beg, Node *end)
+{
+    for (Node *node = beg; ; )
+    {
+        // a retired node may be freed at once if no reader is inside a guard
+        Node *next = node->getNext();
+        bool last = node == end;
+        _reclaimer.retire(node);
+        if (last)
+            break;
+        node = next;
+    }
+}
+
+
+template<typename T, typename Policy>
+void RcuBidiList<T, Policy>::cutNodes(Node *beg, Node *end)
+{
+    Base::cutNodes(beg, end);
+
+    // a failed check has been reported by the base, if it does not throw
+    if (beg != nullptr && end != nullptr)
+        retireChain(beg, end);
+}
+
+
+template<typename T, typename Policy>
+bool RcuBidiList<T, Policy>::cutFirst(const T &val)
+{
+    Node *node = findFirst(val);
+    if (node == nullptr)
+        return false;
+
+    cutNode(node);
+    return true;
+}
+
+
+template<typename T, typename Policy>
+std::size_t RcuBidiList<T, Policy>::cutAll(const T &val)
+{
+    // nodes cut on the way stay allocated while the traversal may still touch them
+    ReadGuard guard(*this);
+    std::size_t res = 0;
+    std::size_t tag = Node::tagOf(val);
+    this->traverse(getHeadNode(), [this, &val, tag, &res](Node *node)
+    {
+        if (Base::carries(node, val, tag))
+        {
+            cutNode(node);
+            ++res;
+        }
+        return false;
+    });
+
+    return res;
+}
+
+
+template<typename T, typename Policy>
+bool RcuBidiList<T, Policy>::popFront(T &val)
+{
+    Node *node = getHeadNode();
+    if (node == nullptr)
+        return false;
+
+    val = node->getValue();
+    cutNode(node);
+    return true;
+}
+
+
+template<typename T, typename Policy>
+bool RcuBidiList<T, Policy>::popBack(T &val)
+{
+    Node *node = getLastNode();
+    if (node == nullptr)
+        return false;
+
+    val = node->getValue();
+    cutNode(node);
+    return true;
+}
+
+
+template<typename T, typename Policy>
+void RcuBidiList<T, Policy>::clear()
+{
+    Node *head = getHeadNode();
+    if (head != nullptr)
+        cutNodes(head, getLastNode());
+}
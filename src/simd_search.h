@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of vectorized search kernels over contiguous
+/// arrays of arithmetic elements.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_SIMDSEARCH_H_
+#define XI_ENHLINKEDLIST_SIMDSEARCH_H_
+
+#include <cstddef>      // size_t
+#include <cstdint>
+
+// vector kernels are only built by GCC-compatible compilers for x86
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define XI_SIMD_X86
+#endif
+
+
+/** \brief Instruction set levels search kernels can run on */
+enum SimdLevel
+{
+    SIMD_SCALAR = 0,
+    SIMD_SSE42,
+    SIMD_AVX2,
+    SIMD_AVX512
+};
+
+/** \brief Returns the best level supported by the running processor */
+inline SimdLevel simdDetectLevel();
+
+/** \brief Returns a level kernels currently dispatch to */
+inline SimdLevel simdGetLevel();
+
+/** \brief Forces kernels to a given level, which is clamped to the detected one
+ *
+ *  Intended for tests and benchmarks; not thread-safe against running searches.
+ */
+inline void simdSetLevel(SimdLevel level);
+
+
+/** \brief Element-wise search over a contiguous array of `T`
+ *
+ *  The primary template is a plain scalar loop and works for any `T` with
+ *  `operator==`. Specializations for 32- and 64-bit integers, `float` and
+ *  `double` dispatch at run time to SSE4.2, AVX2 or AVX-512 kernels.
+ *  Floating point elements compare like `operator==` does: NaN matches nothing
+ *  and `-0.0` matches `0.0`.
+ */
+template<typename T>
+struct SimdSearch
+{
+    /** \brief Whether the specialization has vector kernels */
+    static const bool VECTORIZED = false;
+
+    /** \brief Returns an index of the first element equal to \a val, or \a n */
+    static std::size_t findFirst(const T *data, std::size_t n, const T &val);
+
+    /** \brief Returns a number of elements equal to \a val */
+    static std::size_t count(const T *data, std::size_t n, const T &val);
+
+    /** \brief Writes indices of all the elements equal to \a val to \a out, which must
+     *  have room for count() indices, and returns their number
+     */
+    static std::size_t findAll(const T *data, std::size_t n, const T &val, std::size_t *out);
+
+    /** \brief Returns whether any element is equal to \a val */
+    static bool contains(const T *data, std::size_t n, const T &val)
+    {
+        return findFirst(data, n, val) != n;
+    }
+};
+
+
+/** \brief Common part of vectorized specializations; `Bits` is a same-sized
+ *  integer type or the floating point type itself
+ */
+template<typename T, typename Bits>
+struct SimdSearchVector
+{
+    static const bool VECTORIZED = true;
+
+    static std::size_t findFirst(const T *data, std::size_t n, const T &val);
+    static std::size_t count(const T *data, std::size_t n, const T &val);
+    static std::size_t findAll(const T *data, std::size_t n, const T &val, std::size_t *out);
+
+    static bool contains(const T *data, std::size_t n, const T &val)
+    {
+        return findFirst(data, n, val) != n;
+    }
+};
+
+// integers are compared bitwise, so signedness does not matter
+template<> struct SimdSearch<int32_t> : SimdSearchVector<int32_t, int32_t> {};
+template<> struct SimdSearch<uint32_t> : SimdSearchVector<uint32_t, int32_t> {};
+template<> struct SimdSearch<int64_t> : SimdSearchVector<int64_t, int64_t> {};
+template<> struct SimdSearch<uint64_t> : SimdSearchVector<uint64_t, int64_t> {};
+template<> struct SimdSearch<float> : SimdSearchVector<float, float> {};
+template<> struct SimdSearch<double> : SimdSearchVector<double, double> {};
+
+
+// declaration of template class template methods
+#include "simd_search.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_SIMDSEARCH_H_
@@ -0,0 +1,468 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of vectorized search kernels
+/// declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>      // memcpy
+
+#ifdef XI_SIMD_X86
+#include <immintrin.h>
+
+/** \brief Lets a function use a given instruction set regardless of compiler flags */
+#define XI_SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+
+
+//==============================================================================
+// Dispatching
+//==============================================================================
+
+
+inline SimdLevel simdDetectLevel()
+{
+#ifdef XI_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return SIMD_AVX2;
+    if (__builtin_cpu_supports("sse4.2"))
+        return SIMD_SSE42;
+#endif
+    return SIMD_SCALAR;
+}
+
+
+/** \brief Returns a storage of the current level, detected on first use */
+inline SimdLevel &simdLevelRef()
+{
+    static SimdLevel level = simdDetectLevel();
+    return level;
+}
+
+
+inline SimdLevel simdGetLevel()
+{
+    return simdLevelRef();
+}
+
+
+inline void simdSetLevel(SimdLevel level)
+{
+    SimdLevel best = simdDetectLevel();
+    simdLevelRef() = level < best ? level : best;
+}
+
+
+//==============================================================================
+// Mask consumers shared by all the kernels
+//==============================================================================
+
+
+/** \brief Stops on the first match */
+struct SimdFirstSink
+{
+    SimdFirstSink() : found(0), done(false) {}
+
+    bool operator()(std::size_t base, unsigned mask)
+    {
+        found = base + (std::size_t) __builtin_ctz(mask);
+        done = true;
+        return true;
+    }
+
+    std::size_t found;
+    bool done;
+};
+
+
+/** \brief Counts matches */
+struct SimdCountSink
+{
+    SimdCountSink() : found(0), done(false) {}
+
+    bool operator()(std::size_t, unsigned mask)
+    {
+        found += (std::size_t) __builtin_popcount(mask);
+        return false;
+    }
+
+    std::size_t found;
+    bool done;
+};
+
+
+/** \brief Collects indices of matches */
+struct SimdAllSink
+{
+    SimdAllSink(std::size_t *o) : out(o), found(0), done(false) {}
+
+    bool operator()(std::size_t base, unsigned mask)
+    {
+        while (mask)
+        {
+            out[found++] = base + (std::size_t) __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+        return false;
+    }
+
+    std::size_t *out;
+    std::size_t found;
+    bool done;
+};
+
+
+#ifdef XI_SIMD_X86
+
+//==============================================================================
+// Per instruction set comparisons: splat() broadcasts a value, eqMask() compares
+// a vector loaded from memory and returns one bit per lane
+//==============================================================================
+
+
+template<typename Bits> struct SimdSse42;
+
+template<> struct SimdSse42<int32_t>
+{
+    typedef __m128i Vec;
+    static const std::size_t LANES = 4;
+    XI_SIMD_TARGET("sse4.2") static Vec splat(int32_t v) { return _mm_set1_epi32(v); }
+    XI_SIMD_TARGET("sse4.2") static unsigned eqMask(const int32_t *p, Vec v)
+    {
+        Vec eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) p), v);
+        return (unsigned) _mm_movemask_ps(_mm_castsi128_ps(eq));
+    }
+};
+
+template<> struct SimdSse42<int64_t>
+{
+    typedef __m128i Vec;
+    static const std::size_t LANES = 2;
+    XI_SIMD_TARGET("sse4.2") static Vec splat(int64_t v) { return _mm_set1_epi64x(v); }
+    XI_SIMD_TARGET("sse4.2") static unsigned eqMask(const int64_t *p, Vec v)
+    {
+        Vec eq = _mm_cmpeq_epi64(_mm_loadu_si128((const __m128i *) p), v);
+        return (unsigned) _mm_movemask_pd(_mm_castsi128_pd(eq));
+    }
+};
+
+template<> struct SimdSse42<float>
+{
+    typedef __m128 Vec;
+    static const std::size_t LANES = 4;
+    XI_SIMD_TARGET("sse4.2") static Vec splat(float v) { return _mm_set1_ps(v); }
+    XI_SIMD_TARGET("sse4.2") static unsigned eqMask(const float *p, Vec v)
+    {
+        return (unsigned) _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p), v));
+    }
+};
+
+template<> struct SimdSse42<double>
+{
+    typedef __m128d Vec;
+    static const std::size_t LANES = 2;
+    XI_SIMD_TARGET("sse4.2") static Vec splat(double v) { return _mm_set1_pd(v); }
+    XI_SIMD_TARGET("sse4.2") static unsigned eqMask(const double *p, Vec v)
+    {
+        return (unsigned) _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p), v));
+    }
+};
+
+
+template<typename Bits> struct SimdAvx2;
+
+template<> struct SimdAvx2<int32_t>
+{
+    typedef __m256i Vec;
+    static const std::size_t LANES = 8;
+    XI_SIMD_TARGET("avx2") static Vec splat(int32_t v) { return _mm256_set1_epi32(v); }
+    XI_SIMD_TARGET("avx2") static unsigned eqMask(const int32_t *p, Vec v)
+    {
+        Vec eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) p), v);
+        return (unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+    }
+};
+
+template<> struct SimdAvx2<int64_t>
+{
+    typedef __m256i Vec;
+    static const std::size_t LANES = 4;
+    XI_SIMD_TARGET("avx2") static Vec splat(int64_t v) { return _mm256_set1_epi64x(v); }
+    XI_SIMD_TARGET("avx2") static unsigned eqMask(const int64_t *p, Vec v)
+    {
+        Vec eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *) p), v);
+        return (unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+    }
+};
+
+template<> struct SimdAvx2<float>
+{
+    typedef __m256 Vec;
+    static const std::size_t LANES = 8;
+    XI_SIMD_TARGET("avx2") static Vec splat(float v) { return _mm256_set1_ps(v); }
+    XI_SIMD_TARGET("avx2") static unsigned eqMask(const float *p, Vec v)
+    {
+        return (unsigned) _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p), v, _CMP_EQ_OQ));
+    }
+};
+
+template<> struct SimdAvx2<double>
+{
+    typedef __m256d Vec;
+    static const std::size_t LANES = 4;
+    XI_SIMD_TARGET("avx2") static Vec splat(double v) { return _mm256_set1_pd(v); }
+    XI_SIMD_TARGET("avx2") static unsigned eqMask(const double *p, Vec v)
+    {
+        return (unsigned) _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p), v, _CMP_EQ_OQ));
+    }
+};
+
+
+template<typename Bits> struct SimdAvx512;
+
+template<> struct SimdAvx512<int32_t>
+{
+    typedef __m512i Vec;
+    static const std::size_t LANES = 16;
+    XI_SIMD_TARGET("avx512f") static Vec splat(int32_t v) { return _mm512_set1_epi32(v); }
+    XI_SIMD_TARGET("avx512f") static unsigned eqMask(const int32_t *p, Vec v)
+    {
+        return (unsigned) _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(p), v);
+    }
+};
+
+template<> struct SimdAvx512<int64_t>
+{
+    typedef __m512i Vec;
+    static const std::size_t LANES = 8;
+    XI_SIMD_TARGET("avx512f") static Vec splat(int64_t v) { return _mm512_set1_epi64(v); }
+    XI_SIMD_TARGET("avx512f") static unsigned eqMask(const int64_t *p, Vec v)
+    {
+        return (unsigned) _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(p), v);
+    }
+};
+
+template<> struct SimdAvx512<float>
+{
+    typedef __m512 Vec;
+    static const std::size_t LANES = 16;
+    XI_SIMD_TARGET("avx512f") static Vec splat(float v) { return _mm512_set1_ps(v); }
+    XI_SIMD_TARGET("avx512f") static unsigned eqMask(const float *p, Vec v)
+    {
+        return (unsigned) _mm512_cmp_ps_mask(_mm512_loadu_ps(p), v, _CMP_EQ_OQ);
+    }
+};
+
+template<> struct SimdAvx512<double>
+{
+    typedef __m512d Vec;
+    static const std::size_t LANES = 8;
+    XI_SIMD_TARGET("avx512f") static Vec splat(double v) { return _mm512_set1_pd(v); }
+    XI_SIMD_TARGET("avx512f") static unsigned eqMask(const double *p, Vec v)
+    {
+        return (unsigned) _mm512_cmp_pd_mask(_mm512_loadu_pd(p), v, _CMP_EQ_OQ);
+    }
+};
+
+
+//==============================================================================
+// Kernels: feed a sink with masks of whole vectors and return an index the
+// scalar tail starts from. Every kernel has to carry its own target attribute,
+// hence three copies.
+//==============================================================================
+
+
+template<typename Bits, typename Sink>
+XI_SIMD_TARGET("sse4.2")
+std::size_t simdScanSse42(const Bits *data, std::size_t n, Bits val, Sink &sink)
+{
+    typedef SimdSse42<Bits> Isa;
+    typename Isa::Vec v = Isa::splat(val);
+    std::size_t i = 0;
+    for (; i + Isa::LANES <= n; i += Isa::LANES)
+    {
+        unsigned mask = Isa::eqMask(data + i, v);
+        if (mask && sink(i, mask))
+            break;
+    }
+    return i;
+}
+
+
+template<typename Bits, typename Sink>
+XI_SIMD_TARGET("avx2")
+std::size_t simdScanAvx2(const Bits *data, std::size_t n, Bits val, Sink &sink)
+{
+    typedef SimdAvx2<Bits> Isa;
+    typename Isa::Vec v = Isa::splat(val);
+    std::size_t i = 0;
+    for (; i + Isa::LANES <= n; i += Isa::LANES)
+    {
+        unsigned mask = Isa::eqMask(data + i, v);
+        if (mask && sink(i, mask))
+            break;
+    }
+    return i;
+}
+
+
+template<typename Bits, typename Sink>
+XI_SIMD_TARGET("avx512f")
+std::size_t simdScanAvx512(const Bits *data, std::size_t n, Bits val, Sink &sink)
+{
+    typedef SimdAvx512<Bits> Isa;
+    typename Isa::Vec v = Isa::splat(val);
+    std::size_t i = 0;
+    for (; i + Isa::LANES <= n; i += Isa::LANES)
+    {
+        unsigned mask = Isa::eqMask(data + i, v);
+        if (mask && sink(i, mask))
+            break;
+    }
+    return i;
+}
+
+#endif // XI_SIMD_X86
+
+
+/** \brief Runs a kernel of the current level; returns 0 if there is none */
+template<typename Bits, typename Sink>
+std::size_t simdScan(const Bits *data, std::size_t n, Bits val, Sink &sink)
+{
+#ifdef XI_SIMD_X86
+    switch (simdGetLevel())
+    {
+    case SIMD_AVX512:
+        return simdScanAvx512(data, n, val, sink);
+    case SIMD_AVX2:
+        return simdScanAvx2(data, n, val, sink);
+    case SIMD_SSE42:
+        return simdScanSse42(data, n, val, sink);
+    default:
+        break;
+    }
+#endif
+    return 0;
+}
+
+
+//==============================================================================
+// struct SimdSearch<T>
+//==============================================================================
+
+
+template<typename T>
+const bool SimdSearch<T>::VECTORIZED;
+
+
+template<typename T>
+std::size_t SimdSearch<T>::findFirst(const T *data, std::size_t n, const T &val)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (data[i] == val)
+            return i;
+    }
+    return n;
+}
+
+
+template<typename T>
+std::size_t SimdSearch<T>::count(const T *data, std::size_t n, const T &val)
+{
+    std::size_t res = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (data[i] == val)
+            ++res;
+    }
+    return res;
+}
+
+
+template<typename T>
+std::size_t SimdSearch<T>::findAll(const T *data, std::size_t n, const T &val, std::size_t *out)
+{
+    std::size_t res = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (data[i] == val)
+            out[res++] = i;
+    }
+    return res;
+}
+
+
+//==============================================================================
+// struct SimdSearchVector<T, Bits>
+//==============================================================================
+
+
+template<typename T, typename Bits>
+const bool SimdSearchVector<T, Bits>::VECTORIZED;
+
+
+template<typename T, typename Bits>
+std::size_t SimdSearchVector<T, Bits>::findFirst(const T *data, std::size_t n, const T &val)
+{
+    Bits bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+
+    SimdFirstSink sink;
+    std::size_t i = simdScan(reinterpret_cast<const Bits *>(data), n, bits, sink);
+    if (sink.done)
+        return sink.found;
+
+    for (; i < n; ++i)
+    {
+        if (data[i] == val)
+            return i;
+    }
+    return n;
+}
+
+
+template<typename T, typename Bits>
+std::size_t SimdSearchVector<T, Bits>::count(const T *data, std::size_t n, const T &val)
+{
+    Bits bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+
+    SimdCountSink sink;
+    std::size_t i = simdScan(reinterpret_cast<const Bits *>(data), n, bits, sink);
+    for (; i < n; ++i)
+    {
+        if (data[i] == val)
+            ++sink.found;
+    }
+    return sink.found;
+}
+
+
+template<typename T, typename Bits>
+std::size_t SimdSearchVector<T, Bits>::findAll(const T *data, std::size_t n, const T &val,
+                                               std::size_t *out)
+{
+    Bits bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+
+    SimdAllSink sink(out);
+    std::size_t i = simdScan(reinterpret_cast<const Bits *>(data), n, bits, sink);
+    for (; i < n; ++i)
+    {
+        if (data[i] == val)
+            out[sink.found++] = i;
+    }
+    return sink.found;
+}
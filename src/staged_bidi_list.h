@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains interface part of the shared bidirectional list fed by
+/// thread-private staging chains.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef XI_ENHLINKEDLIST_STAGEDLIST_H_
+#define XI_ENHLINKEDLIST_STAGEDLIST_H_
+
+#include <cstddef>      // size_t
+#include <mutex>
+
+#include "bidi_linked_list.h"
+
+
+/** \brief Declares a BidiLinkedList shared by threads behind a mutex, which
+ *  producers append to in batches through private stages
+ *
+ *  A producer appends to a Stage of its own with no locking: the stage collects
+ *  nodes in a private list. A flush cuts the whole private chain in O(1) and links
+ *  it to the end of the shared list by one BidiLinkedList::insertNodesAfter() with
+ *  the known number of nodes, so the lock is held for O(1) per batch however long
+ *  it is, and the size of the shared list stays calculated.
+ *
+ *  Values of one stage go to the shared list in the order they have been staged;
+ *  chains of different stages follow each other in the order of flushes. Staged
+ *  values are not seen in the shared list until they are flushed.
+ *
+ *  The policy should track the tail (Policy::TRACK_TAIL), otherwise finding the
+ *  end of a chain and of the shared list takes O(n).
+ */
+template<typename T, typename Policy = DefaultBidiListPolicy>
+class StagedBidiList
+{
+public:
+    //-----<Types>-----
+    typedef BidiLinkedList<T, Policy> List;
+    typedef typename List::Node Node;
+
+    /** \brief Private buffer of a producer thread; used by one thread at a time */
+    class Stage
+    {
+    public:
+        /** \brief Creates a stage of \a owner flushing itself every \a flushSize
+         *  appends; 0 means only explicit flushes and the destructor flush it
+         */
+        explicit Stage(StagedBidiList &owner, std::size_t flushSize = 0)
+            : _owner(&owner), _count(0), _flushSize(flushSize) {}
+
+        /** \brief Destructor; flushes staged values */
+        ~Stage() { flush(); }
+
+        Stage(const Stage &) = delete;
+        Stage &operator=(const Stage &) = delete;
+
+        /** \brief Stages a given element; the node joins the shared list on a flush */
+        Node *appendEl(const T &val);
+
+        /** \brief Stages copies of values of a range `[first, last)` */
+        template<typename InputIt>
+        void appendRange(InputIt first, InputIt last);
+
+        /** \brief Moves staged nodes to the end of the shared list at once
+         *  \return a number of nodes moved
+         */
+        std::size_t flush();
+
+        /** \brief Returns a number of values staged and not flushed yet */
+        std::size_t getStagedCount() const { return _count; }
+
+    protected:
+        /** \brief Flushes the stage if it has reached its flush size */
+        void flushIfFull();
+
+    protected:
+        StagedBidiList *_owner;
+        List _staged;                   ///< Nodes staged so far
+        std::size_t _count;             ///< Number of nodes in #_staged
+        std::size_t _flushSize;         ///< Number of nodes to flush at, or 0
+    }; // class Stage
+
+public:
+    /** \brief Default constructor */
+    StagedBidiList() {}
+
+    StagedBidiList(const StagedBidiList &) = delete;
+    StagedBidiList &operator=(const StagedBidiList &) = delete;
+
+public:
+    //-----<Shared list>-----
+    // each method takes the lock once
+
+    /** \brief Appends a given element right away, bypassing stages */
+    Node *appendEl(const T &val);
+
+    /** \brief Cuts first node carrying \a val, see BidiLinkedList::cutFirst() */
+    Node *cutFirst(const T &val);
+
+    /** \brief Returns a number of nodes carrying \a val */
+    std::size_t count(const T &val);
+
+    /** \brief Returns a number of nodes in the shared list */
+    std::size_t getSize();
+
+    /** \brief Applies \a func to the shared list under the lock; invoked as `func(List&)` */
+    template<typename Func>
+    void apply(Func func);
+
+protected:
+    /** \brief Links a free chain `[beg, end]` of \a count nodes to the end */
+    void spliceChain(Node *beg, Node *end, std::size_t count);
+
+protected:
+    List _lst;                          ///< Shared list
+    std::mutex _lock;                   ///< Guards #_lst
+}; // class StagedBidiList
+
+
+// declaration of template class template methods
+#include "staged_bidi_list.hpp"
+
+
+#endif // XI_ENHLINKEDLIST_STAGEDLIST_H_
@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Contains pseudo-implementation part of the staged shared list
+/// declared in the file's h-counterpart
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+//==============================================================================
+// class StagedBidiList<T, Policy>::Stage
+//==============================================================================
+
+
+template<typename T, typename Policy>
+typename StagedBidiList<T, Policy>::Node *
+StagedBidiList<T, Policy>::Stage::appendEl(const T &val)
+{
+    Node *node = _staged.appendEl(val);
+    ++_count;
+    flushIfFull();
+    return node;
+}
+
+
+template<typename T, typename Policy>
+template<typename InputIt>
+void StagedBidiList<T, Policy>::Stage::appendRange(InputIt first, InputIt last)
+{
+    // the new nodes are counted by the walk, as the range may be single-pass
+    for (Node *node = _staged.appendRange(first, last); node != nullptr; node = node->getNext())
+        ++_count;
+    flushIfFull();
+}
+
+
+template<typename T, typename Policy>
+void StagedBidiList<T, Policy>::Stage::flushIfFull()
+{
+    if (_flushSize != 0 && _count >= _flushSize)
+        flush();
+}
+
+
+template<typename T, typename Policy>
+std::size_t StagedBidiList<T, Policy>::Stage::flush()
+{
+    Node *beg = _staged.getHeadNode();
+    if (beg == nullptr)
+        return 0;
+
+    // the chain leaves the private list as it is, so no lock is needed yet
+    Node *end = _staged.getLastNode();
+    _staged.cutNodes(beg, end);
+
+    std::size_t count = _count;
+    _count = 0;
+    _owner->spliceChain(beg, end, count);
+    return count;
+}
+
+
+
+//==============================================================================
+// class StagedBidiList<T, Policy>
+//==============================================================================
+
+
+template<typename T, typename Policy>
+void StagedBidiList<T, Policy>::spliceChain(Node *beg, Node *end, std::size_t count)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _lst.insertNodesAfter(nullptr, beg, end, count);
+}
+
+
+template<typename T, typename Policy>
+typename StagedBidiList<T, Policy>::Node *
+StagedBidiList<T, Policy>::appendEl(const T &val)
+{
+    // the node is made before the lock is taken
+    Node *node = new Node(val);
+    spliceChain(node, node, 1);
+    return node;
+}
+
+
+template<typename T, typename Policy>
+typename StagedBidiList<T, Policy>::Node *
+StagedBidiList<T, Policy>::cutFirst(const T &val)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _lst.cutFirst(val);
+}
+
+
+template<typename T, typename Policy>
+std::size_t StagedBidiList<T, Policy>::count(const T &val)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _lst.count(val);
+}
+
+
+template<typename T, typename Policy>
+std::size_t StagedBidiList<T, Policy>::getSize()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _lst.getSize();
+}
+
+
+template<typename T, typename Policy>
+template<typename Func>
+void StagedBidiList<T, Policy>::apply(Func func)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    func(_lst);
+}
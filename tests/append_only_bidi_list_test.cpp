@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for AppendOnlyBidiList class.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "append_only_bidi_list.h"
+
+/** \brief Type alias for a log of integers */
+typedef AppendOnlyBidiList<int> IntLog;
+
+
+TEST(AppendOnlyList, appendAndPoll)
+{
+    IntLog log;
+    IntLog::Cursor cur(log);
+    EXPECT_EQ(cur.poll(), nullptr);
+    EXPECT_EQ(cur.peek(), nullptr);
+
+    log.appendEl(1);
+    log.pushBack(2);
+    EXPECT_EQ(cur.peek()->getValue(), 1);
+    EXPECT_EQ(cur.poll()->getValue(), 1);
+    EXPECT_EQ(cur.poll()->getValue(), 2);
+    EXPECT_EQ(cur.poll(), nullptr);
+    EXPECT_EQ(cur.getNode()->getValue(), 2);
+
+    int vals[] = { 3, 4, 5 };
+    EXPECT_EQ(log.appendRange(vals, vals + 3)->getValue(), 3);
+    EXPECT_EQ(log.appendRange(vals, vals), nullptr);
+    EXPECT_EQ(log.getSize(), 5);
+    EXPECT_EQ(cur.poll()->getValue(), 3);
+
+    std::vector<int> all;
+    for (int val : log)
+        all.push_back(val);
+    EXPECT_EQ(all, std::vector<int>({ 1, 2, 3, 4, 5 }));
+    EXPECT_EQ(log.count(4), 1);
+    EXPECT_EQ(log.findFirst(5), log.getLastNode());
+
+    // a cursor may start anywhere
+    IntLog::Cursor mid(log, log.findFirst(4));
+    EXPECT_EQ(mid.poll()->getValue(), 5);
+}
+
+
+TEST(AppendOnlyList, waitTimeoutAndClose)
+{
+    IntLog log;
+    IntLog::Cursor cur(log);
+    EXPECT_EQ(cur.waitFor(std::chrono::milliseconds(5)), nullptr);
+
+    log.appendEl(7);
+    EXPECT_EQ(cur.waitFor(std::chrono::milliseconds(5))->getValue(), 7);
+
+    std::thread waiter([&cur]() { EXPECT_EQ(cur.wait(), nullptr); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    log.close();
+    waiter.join();
+
+    EXPECT_TRUE(log.isClosed());
+    EXPECT_EQ(cur.wait(), nullptr);
+}
+
+
+TEST(AppendOnlyList, tailingReaders)
+{
+    const int READERS = 4;
+    const int ENTRIES = 20000;
+
+    IntLog log;
+    std::atomic<int> errors(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < READERS; ++t)
+        readers.push_back(std::thread([&log, &errors, t]()
+        {
+            // half of the readers block, the others poll
+            IntLog::Cursor cur(log);
+            int expected = 0;
+            for (;;)
+            {
+                IntLog::Node *node = t % 2 ? cur.wait() : cur.poll();
+                if (node == nullptr)
+                {
+                    if (t % 2 || (log.isClosed() && cur.peek() == nullptr))
+                        break;
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (node->getValue() != expected++)
+                    ++errors;
+            }
+            if (expected != ENTRIES)
+                ++errors;
+        }));
+
+    for (int i = 0; i < ENTRIES; ++i)
+        log.appendEl(i);
+    log.close();
+    for (std::size_t t = 0; t < readers.size(); ++t)
+        readers[t].join();
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(log.getSize(), ENTRIES);
+}
@@ -0,0 +1,304 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for AugmentedBidiList class.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "augmented_bidi_list.h"
+
+/** \brief Type aliases for lists of 64-bit integers */
+typedef AugmentedBidiList<int64_t, SumMonoid<int64_t> > SumList;
+typedef AugmentedBidiList<int64_t, MinMonoid<int64_t> > MinList;
+typedef AugmentedBidiList<int64_t, MaxMonoid<int64_t> > MaxList;
+
+
+TEST(AugmentedList, simpleCreate)
+{
+    SumList lst;
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+    EXPECT_EQ(nullptr, lst.getLastNode());
+    EXPECT_EQ(0, lst.getSize());
+    EXPECT_EQ(0, lst.aggregate());
+}
+
+
+TEST(AugmentedList, rangeSum)
+{
+    SumList lst;
+    std::vector<SumList::Node *> nodes;
+    for (int64_t i = 1; i <= 1000; ++i)
+        nodes.push_back(lst.appendEl(i));
+
+    EXPECT_EQ(1000, lst.getSize());
+    EXPECT_EQ(500500, lst.aggregate());
+    EXPECT_EQ(500500, lst.aggregate(nodes.front(), nodes.back()));
+    EXPECT_EQ(5, lst.aggregate(nodes[4], nodes[4]));
+    // 10 + ... + 900
+    EXPECT_EQ(405405, lst.aggregate(nodes[9], nodes[899]));
+}
+
+
+TEST(AugmentedList, setValueUpdatesSummaries)
+{
+    MinList minLst;
+    MaxList maxLst;
+    std::vector<MinList::Node *> minNodes;
+    std::vector<MaxList::Node *> maxNodes;
+    for (int64_t i = 0; i < 200; ++i)
+    {
+        minNodes.push_back(minLst.appendEl(i + 100));
+        maxNodes.push_back(maxLst.appendEl(i + 100));
+    }
+
+    EXPECT_EQ(100, minLst.aggregate());
+    EXPECT_EQ(299, maxLst.aggregate());
+
+    minNodes[150]->setValue(-7);
+    maxNodes[150]->setValue(1000);
+    EXPECT_EQ(-7, minLst.aggregate());
+    EXPECT_EQ(-7, minLst.aggregate(minNodes[100], minNodes[199]));
+    EXPECT_EQ(200, minLst.aggregate(minNodes[100], minNodes[149]));
+    EXPECT_EQ(1000, maxLst.aggregate(maxNodes[140], maxNodes[160]));
+    EXPECT_EQ(249, maxLst.aggregate(maxNodes[0], maxNodes[149]));
+}
+
+
+TEST(AugmentedList, insertAndCut)
+{
+    SumList lst;
+    SumList::Node *nd1 = lst.appendEl(1);
+    SumList::Node *nd3 = lst.appendEl(3);
+    SumList::Node *nd2 = lst.insertNodeAfter(nd1, new SumList::Node(2));
+    SumList::Node *nd0 = lst.insertNodeBefore(nullptr, new SumList::Node(10));
+
+    EXPECT_EQ(nd0, lst.getHeadNode());
+    EXPECT_EQ(nd3, lst.getLastNode());
+    EXPECT_EQ(nd2, nd1->getNext());
+    EXPECT_EQ(16, lst.aggregate());
+    EXPECT_EQ(5, lst.aggregate(nd2, nd3));
+
+    lst.cutNodes(nd1, nd2);
+    EXPECT_EQ(2, lst.getSize());
+    EXPECT_EQ(13, lst.aggregate());
+    EXPECT_EQ(nd3, nd0->getNext());
+    EXPECT_EQ(nullptr, nd1->getPrev());
+    EXPECT_EQ(nullptr, nd2->getNext());
+
+    // a cut chain keeps its links and may be deleted by a caller
+    delete nd1;
+    delete nd2;
+
+    delete lst.cutNode(nd0);
+    delete lst.cutNode(nd3);
+    EXPECT_EQ(0, lst.getSize());
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+    EXPECT_EQ(0, lst.aggregate());
+}
+
+
+TEST(AugmentedList, randomizedAgainstScan)
+{
+    SumList lst;
+    std::vector<SumList::Node *> nodes;
+    std::srand(42);
+
+    for (int step = 0; step < 3000; ++step)
+    {
+        int op = std::rand() % 4;
+        if (op < 2 || nodes.empty())
+        {
+            SumList::Node *at = nodes.empty() ? nullptr : nodes[std::rand() % nodes.size()];
+            SumList::Node *nd = new SumList::Node(std::rand() % 100);
+            if (op == 0)
+                lst.insertNodeAfter(at, nd);
+            else
+                lst.insertNodeBefore(at, nd);
+            nodes.push_back(nd);
+        } else if (op == 2)
+        {
+            std::size_t i = std::rand() % nodes.size();
+            delete lst.cutNode(nodes[i]);
+            nodes.erase(nodes.begin() + i);
+        } else
+            nodes[std::rand() % nodes.size()]->setValue(std::rand() % 100);
+    }
+
+    ASSERT_EQ(nodes.size(), lst.getSize());
+
+    // compare every 37th subrange with a plain scan
+    std::vector<SumList::Node *> order;
+    for (SumList::Node *nd = lst.getHeadNode(); nd; nd = nd->getNext())
+        order.push_back(nd);
+    ASSERT_EQ(nodes.size(), order.size());
+
+    for (std::size_t b = 0; b < order.size(); b += 37)
+    {
+        int64_t expected = 0;
+        for (std::size_t e = b; e < order.size(); ++e)
+        {
+            expected += order[e]->getValue();
+            if ((e - b) % 41 == 0)
+            {
+                EXPECT_EQ(expected, lst.aggregate(order[b], order[e]));
+            }
+        }
+    }
+}
+
+
+/** \brief Type aliases for lists with filter monoids */
+typedef AugmentedBidiList<int64_t, BloomMonoid<int64_t> > BloomList;
+typedef AugmentedBidiList<int64_t, ZoneMapMonoid<int64_t> > ZoneList;
+
+
+/** \brief Checks findAll() of \a lst against a plain scan for values `[0, maxVal)` */
+template<typename List>
+void checkFindAllAgainstScan(List &lst, int64_t maxVal)
+{
+    for (int64_t v = 0; v < maxVal; ++v)
+    {
+        std::vector<typename List::Node *> expected;
+        for (typename List::Node *nd = lst.getHeadNode(); nd; nd = nd->getNext())
+            if (nd->getValue() == v)
+                expected.push_back(nd);
+
+        int size;
+        typename List::Node **found = lst.findAll(v, size);
+        ASSERT_EQ(expected.size(), (std::size_t) size);
+        for (int i = 0; i < size; ++i)
+            EXPECT_EQ(expected[i], found[i]);
+        delete[] found;
+
+        EXPECT_EQ(expected.empty() ? nullptr : expected[0], lst.findFirst(v));
+    }
+}
+
+
+TEST(AugmentedList, filterMonoids)
+{
+    EXPECT_FALSE((IsFilterMonoid<SumMonoid<int64_t>, int64_t>::value));
+    EXPECT_TRUE((IsFilterMonoid<BloomMonoid<int64_t>, int64_t>::value));
+    EXPECT_TRUE((IsFilterMonoid<ZoneMapMonoid<int64_t>, int64_t>::value));
+
+    typedef BloomMonoid<int64_t> Bloom;
+    Bloom::Summary s = Bloom::combine(Bloom::lift(3), Bloom::lift(42));
+    EXPECT_TRUE(Bloom::mayContain(s, 3));
+    EXPECT_TRUE(Bloom::mayContain(s, 42));
+    EXPECT_FALSE(Bloom::mayContain(Bloom::identity(), 3));
+
+    typedef ZoneMapMonoid<int64_t> Zone;
+    Zone::Summary z = Zone::combine(Zone::lift(10), Zone::lift(20));
+    EXPECT_TRUE(Zone::mayContain(z, 15));
+    EXPECT_FALSE(Zone::mayContain(z, 9));
+    EXPECT_FALSE(Zone::mayContain(z, 21));
+    EXPECT_FALSE(Zone::mayContain(Zone::identity(), 0));
+}
+
+
+TEST(AugmentedList, bloomSkipsChunks)
+{
+    BloomList lst;
+    for (int64_t i = 0; i < 5000; ++i)
+        lst.appendEl(i * 2);
+
+    // a negative search visits a small part of the list
+    lst.resetSearchStats();
+    EXPECT_EQ(nullptr, lst.findFirst(3));
+    EXPECT_EQ(nullptr, lst.findFirst(10001));
+    EXPECT_EQ(2, lst.getSearchStats().searches);
+    EXPECT_LT(lst.getSearchStats().nodesVisited, 1000);
+    EXPECT_GT(lst.getSearchStats().chunksSkipped, 0);
+
+    BloomList::Node *nd = lst.findFirst(4242);
+    ASSERT_NE(nullptr, nd);
+    EXPECT_EQ(4242, nd->getValue());
+    EXPECT_EQ(nullptr, lst.findFirst(nd->getNext(), 4242));
+
+    checkFindAllAgainstScan(lst, 300);
+}
+
+
+TEST(AugmentedList, zoneMapSkipsChunks)
+{
+    ZoneList lst;
+    for (int64_t i = 0; i < 5000; ++i)
+        lst.appendEl(i / 7);
+
+    lst.resetSearchStats();
+    EXPECT_EQ(nullptr, lst.findFirst(-1));
+    EXPECT_EQ(nullptr, lst.findFirst(100000));
+    ZoneList::Node *nd = lst.findFirst(500);
+    ASSERT_NE(nullptr, nd);
+    EXPECT_EQ(nd->getPrev()->getValue(), 499);
+    EXPECT_LT(lst.getSearchStats().nodesVisited, 100);
+
+    int size;
+    ZoneList::Node **found = lst.findAll(500, size);
+    ASSERT_EQ(7, size);
+    EXPECT_EQ(nd, found[0]);
+    delete[] found;
+}
+
+
+TEST(AugmentedList, filtersRebuiltAfterCuts)
+{
+    BloomList lst;
+    std::vector<BloomList::Node *> nodes;
+    for (int64_t i = 0; i < 3000; ++i)
+        nodes.push_back(lst.appendEl(i % 100));
+
+    // cut every node carrying 7 and some others; stale filters must not hide anything
+    int size;
+    BloomList::Node **cut = lst.cutAll(7, size);
+    ASSERT_EQ(30, size);
+    for (int i = 0; i < size; ++i)
+    {
+        EXPECT_EQ(7, cut[i]->getValue());
+        delete cut[i];
+    }
+    delete[] cut;
+    EXPECT_EQ(2970, lst.getSize());
+    EXPECT_EQ(nullptr, lst.findFirst(7));
+
+    for (std::size_t i = 1; i < nodes.size(); i += 13)
+        if (i % 100 != 7)
+            delete lst.cutNode(nodes[i]);
+
+    checkFindAllAgainstScan(lst, 100);
+
+    // values set after cuts are found as well
+    lst.getHeadNode()->setValue(1000);
+    lst.getLastNode()->setValue(1001);
+    EXPECT_EQ(lst.getHeadNode(), lst.findFirst(1000));
+    EXPECT_EQ(lst.getLastNode(), lst.findFirst(1001));
+}
+
+
+TEST(AugmentedList, linearSearchStats)
+{
+    SumList lst;
+    for (int64_t i = 0; i < 100; ++i)
+        lst.appendEl(i);
+
+    EXPECT_EQ(nullptr, lst.findFirst(-1));
+    EXPECT_EQ(1, lst.getSearchStats().searches);
+    EXPECT_EQ(100, lst.getSearchStats().nodesVisited);
+    EXPECT_EQ(0, lst.getSearchStats().chunksSkipped);
+
+    lst.resetSearchStats();
+    EXPECT_EQ(0, lst.getSearchStats().searches);
+}
@@ -0,0 +1,214 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for BidiBlockingQueue class.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "bidi_blocking_queue.h"
+
+/** \brief Type alias for a blocking queue of integers */
+typedef BidiBlockingQueue<int> IntBlockingQueue;
+
+
+/** \brief Collects values of a list in order */
+static std::vector<int> listValues(IntBlockingQueue::List &lst)
+{
+    std::vector<int> vals;
+    for (int val : lst)
+        vals.push_back(val);
+    return vals;
+}
+
+
+TEST(BlockingQueue, pushAndPop)
+{
+    EXPECT_THROW(IntBlockingQueue(0), std::invalid_argument);
+
+    IntBlockingQueue queue(8);
+    EXPECT_TRUE(queue.push(1));
+    int vals[] = { 2, 3, 4, 5 };
+    EXPECT_TRUE(queue.pushBatch(vals, vals + 4));
+    EXPECT_EQ(queue.getSize(), 5);
+
+    int val;
+    EXPECT_TRUE(queue.pop(val));
+    EXPECT_EQ(val, 1);
+
+    IntBlockingQueue::List out;
+    EXPECT_EQ(queue.popBatch(out, 2), 2);
+    EXPECT_EQ(queue.popBatch(out, 10), 2);
+    EXPECT_EQ(listValues(out), std::vector<int>({ 2, 3, 4, 5 }));
+    EXPECT_EQ(out.getSize(), 4);
+    EXPECT_EQ(queue.getSize(), 0);
+
+    // a list is pushed whole and left empty
+    EXPECT_TRUE(queue.pushBatch(out));
+    EXPECT_EQ(out.getHeadNode(), nullptr);
+    EXPECT_EQ(queue.popBatch(out, 10), 4);
+}
+
+
+TEST(BlockingQueue, timeoutAndClose)
+{
+    IntBlockingQueue queue(4);
+    IntBlockingQueue::List out;
+    EXPECT_EQ(queue.popBatch(out, 4, std::chrono::milliseconds(5)), 0);
+
+    queue.push(7);
+    std::thread consumer([&queue]()
+    {
+        int val;
+        EXPECT_TRUE(queue.pop(val));
+        EXPECT_EQ(val, 7);
+        EXPECT_FALSE(queue.pop(val));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    queue.close();
+    consumer.join();
+
+    // a failed push leaves the list to its owner
+    out.appendEl(8);
+    EXPECT_TRUE(queue.isClosed());
+    EXPECT_FALSE(queue.push(8));
+    EXPECT_FALSE(queue.pushBatch(out));
+    EXPECT_EQ(listValues(out), std::vector<int>({ 8 }));
+}
+
+
+TEST(BlockingQueue, backpressure)
+{
+    IntBlockingQueue queue(4);
+    int vals[] = { 1, 2, 3 };
+    queue.pushBatch(vals, vals + 3);
+
+    std::atomic<bool> pushed(false);
+    std::thread producer([&queue, &vals, &pushed]()
+    {
+        queue.pushBatch(vals, vals + 3);
+        pushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_FALSE(pushed.load());
+
+    IntBlockingQueue::List out;
+    EXPECT_EQ(queue.popBatch(out, 2), 2);
+    producer.join();
+    EXPECT_EQ(queue.getSize(), 4);
+
+    // a batch bigger than the capacity goes into an empty queue
+    EXPECT_EQ(queue.popBatch(out, 10), 4);
+    int many[] = { 1, 2, 3, 4, 5, 6 };
+    EXPECT_TRUE(queue.pushBatch(many, many + 6));
+    EXPECT_EQ(queue.getSize(), 6);
+}
+
+
+TEST(BlockingQueue, smallerBatchFits)
+{
+    IntBlockingQueue queue(4);
+    int vals[] = { 1, 2, 3, 4 };
+    queue.pushBatch(vals, vals + 4);
+
+    // a batch of three waits first, then a batch of one
+    std::atomic<bool> bigPushed(false), smallPushed(false);
+    std::thread big([&queue, &vals, &bigPushed]()
+    {
+        queue.pushBatch(vals, vals + 3);
+        bigPushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread small([&queue, &vals, &smallPushed]()
+    {
+        queue.push(vals[0]);
+        smallPushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // room for one lets the small batch in, even if the big one is woken
+    int val;
+    EXPECT_TRUE(queue.pop(val));
+    for (int i = 0; i < 500 && !smallPushed; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_TRUE(smallPushed.load());
+    EXPECT_FALSE(bigPushed.load());
+    EXPECT_EQ(queue.getSize(), 4);
+
+    IntBlockingQueue::List out;
+    EXPECT_EQ(queue.popBatch(out, 4), 4);
+    big.join();
+    small.join();
+    EXPECT_EQ(queue.getSize(), 3);
+}
+
+
+TEST(BlockingQueue, producersAndConsumers)
+{
+    const int PRODUCERS = 4;
+    const int CONSUMERS = 3;
+    const int PER_PRODUCER = 20000;
+    const int BATCH = 16;
+
+    IntBlockingQueue queue(64);
+    std::vector<std::thread> producers;
+    for (int t = 0; t < PRODUCERS; ++t)
+        producers.push_back(std::thread([&queue, t]()
+        {
+            std::vector<int> batch;
+            for (int i = 0; i < PER_PRODUCER; ++i)
+            {
+                batch.push_back(t * PER_PRODUCER + i);
+                if (batch.size() == BATCH || i == PER_PRODUCER - 1)
+                {
+                    queue.pushBatch(batch.begin(), batch.end());
+                    batch.clear();
+                }
+            }
+        }));
+
+    // every consumer sees values of a producer in order
+    std::atomic<int> total(0);
+    std::atomic<int> errors(0);
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < CONSUMERS; ++c)
+        consumers.push_back(std::thread([&queue, &total, &errors, c]()
+        {
+            std::vector<int> last(PRODUCERS, -1);
+            IntBlockingQueue::List out;
+            while (queue.popBatch(out, c + 7) != 0)
+            {
+                for (int val : out)
+                {
+                    if (val <= last[val / PER_PRODUCER])
+                        ++errors;
+                    last[val / PER_PRODUCER] = val;
+                    ++total;
+                }
+                out.clear();
+            }
+        }));
+
+    for (std::size_t t = 0; t < producers.size(); ++t)
+        producers[t].join();
+    queue.close();
+    for (std::size_t c = 0; c < consumers.size(); ++c)
+        consumers[c].join();
+
+    EXPECT_EQ(total.load(), PRODUCERS * PER_PRODUCER);
+    EXPECT_EQ(errors.load(), 0);
+}
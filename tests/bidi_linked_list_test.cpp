@@ -16,6 +16,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include "bidi_linked_list.h"
 
 /** \brief Type alias for a list of integers */
@@ -552,6 +557,846 @@ TEST(TenPoints, cutAll1)
 #endif // IWANNAGET10POINTS
 
 
+///////////////////////////// TRAVERSAL TESTS /////////////////////////////
+
+TEST(Traversal, prefetchDistances)
+{
+    // results must not depend on how far ahead nodes are prefetched
+    for (std::size_t dist = 0; dist <= 16; dist += 3)
+    {
+        IntBidiList lst;
+        lst.setPrefetchDistance(dist);
+        EXPECT_EQ(dist, lst.getPrefetchDistance());
+
+        for (int i = 0; i < 10; ++i)
+            lst.appendEl(i % 3);
+
+        EXPECT_EQ(10, lst.getSize());
+        EXPECT_EQ(lst.getHeadNode()->getNext()->getNext(), lst.findFirst(2));
+        EXPECT_EQ(nullptr, lst.findFirst(7));
+
+        int fndSize = 0;
+        IntBidiListNode** fnd = lst.findAll(1, fndSize);
+        EXPECT_EQ(3, fndSize);
+        delete[] fnd;
+    }
+}
+
+TEST(Traversal, countContains)
+{
+    IntBidiList lst;
+    EXPECT_EQ(0, lst.count(1));
+    EXPECT_FALSE(lst.contains(1));
+
+    lst.appendEl(1);
+    lst.appendEl(2);
+    lst.appendEl(1);
+    EXPECT_EQ(2, lst.count(1));
+    EXPECT_EQ(1, lst.count(2));
+    EXPECT_TRUE(lst.contains(2));
+    EXPECT_FALSE(lst.contains(3));
+}
+
+TEST(Traversal, forEach)
+{
+    IntBidiList lst;
+    lst.appendEl(1);
+    lst.appendEl(2);
+    IntBidiListNode* nd3 = lst.appendEl(3);
+
+    int sum = 0;
+    lst.forEach([&sum](int& v) { sum += v; v *= 10; });
+    EXPECT_EQ(6, sum);
+    EXPECT_EQ(30, nd3->getValue());
+
+    sum = 0;
+    lst.forEach(nd3, [&sum](int& v) { sum += v; });
+    EXPECT_EQ(30, sum);
+}
+
+TEST(Traversal, clear)
+{
+    IntBidiList lst;
+    lst.appendEl(1);
+    lst.appendEl(2);
+
+    lst.clear();
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+    EXPECT_EQ(nullptr, lst.getLastNode());
+    EXPECT_EQ(0, lst.getSize());
+
+    // the list stays usable after clearing
+    lst.appendEl(3);
+    EXPECT_EQ(1, lst.getSize());
+}
+
+
+TEST(Traversal, relinearize)
+{
+    IntBidiList lst;
+
+    // link nodes in the reverse order of their allocation
+    IntBidiListNode* nodes[100];
+    for (int i = 0; i < 100; ++i)
+        nodes[i] = new IntBidiListNode(i);
+    for (int i = 99; i >= 0; --i)
+        lst.insertNodeAfter(nullptr, nodes[i]);
+
+    double before = lst.averageLinkDistance();
+    lst.relinearize();
+    EXPECT_LE(lst.averageLinkDistance(), before);
+    EXPECT_EQ(100, lst.getSize());
+
+    int expected = 99;
+    for (IntBidiListNode* nd = lst.getHeadNode(); nd; nd = nd->getNext())
+    {
+        EXPECT_EQ(expected--, nd->getValue());
+        if (nd->getNext())
+        {
+            EXPECT_LT(nd, nd->getNext());
+        }
+    }
+    EXPECT_EQ(0, lst.getLastNode()->getValue());
+    EXPECT_EQ(nullptr, lst.getLastNode()->getNext());
+    EXPECT_EQ(nullptr, lst.getHeadNode()->getPrev());
+}
+
+TEST(Traversal, relinearizeStep)
+{
+    IntBidiList lst;
+    for (int i = 0; i < 10; ++i)
+        lst.appendEl(i);
+
+    EXPECT_FALSE(lst.relinearizeStep(4));
+    EXPECT_FALSE(lst.relinearizeStep(4));
+
+    // a cut restarts the pass
+    delete lst.cutNode(lst.findFirst(9));
+    EXPECT_FALSE(lst.relinearizeStep(4));
+    EXPECT_FALSE(lst.relinearizeStep(4));
+    EXPECT_TRUE(lst.relinearizeStep(4));
+
+    std::stringstream ss;
+    for (IntBidiListNode* nd = lst.getHeadNode(); nd; nd = nd->getNext())
+    {
+        if (nd->getNext())
+        {
+            EXPECT_EQ(nd, nd->getNext()->getPrev());
+        }
+        ss << nd->getValue();
+    }
+    EXPECT_EQ("012345678", ss.str());
+    EXPECT_EQ(8, lst.getLastNode()->getValue());
+}
+
+TEST(Traversal, relinearizeStepHugeBudget)
+{
+    IntBidiList lst;
+    for (int i = 0; i < 5; ++i)
+        lst.appendEl(i);
+
+    // a budget is not an allocation size
+    EXPECT_TRUE(lst.relinearizeStep(SIZE_MAX));
+    EXPECT_EQ(5, lst.getSize());
+    int expected = 0;
+    for (int v : lst)
+        EXPECT_EQ(expected++, v);
+}
+
+
+///////////////////////////// RANGE TESTS /////////////////////////////
+
+TEST(Range, insertNodesAfterSize)
+{
+    IntBidiList lst;
+    lst.appendEl(1);
+    EXPECT_EQ(1, lst.getSize());
+
+    IntBidiListNode* nd1 = new IntBidiListNode(2);
+    lst.insertNodesAfter(nullptr, nd1, nd1);
+    EXPECT_EQ(2, lst.getSize());
+
+    // a known length keeps the size valid
+    IntBidiListNode* nd2 = new IntBidiListNode(3);
+    IntBidiListNode* nd3 = new IntBidiListNode(4);
+    lst.insertNodesAfter(nullptr, nd2, nd2, 1);
+    lst.insertNodesAfter(lst.getHeadNode(), nd3, nd3, 1);
+    EXPECT_EQ(4, lst.getSize());
+    EXPECT_EQ(nd3, lst.getHeadNode()->getNext());
+    EXPECT_EQ(nd2, lst.getLastNode());
+}
+
+
+TEST(Range, appendRange)
+{
+    IntBidiList lst;
+    const int vals[] = { 1, 2, 3, 4, 5 };
+
+    EXPECT_EQ(nullptr, lst.appendRange(vals, vals));
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+    EXPECT_EQ(0, lst.getSize());
+
+    IntBidiListNode* first = lst.appendRange(vals, vals + 5);
+    EXPECT_EQ(lst.getHeadNode(), first);
+    EXPECT_EQ(5, lst.getSize());
+    EXPECT_EQ(5, lst.getLastNode()->getValue());
+
+    // the second range goes after the first one
+    std::vector<int> more(3, 7);
+    first = lst.appendRange(more.begin(), more.end());
+    EXPECT_EQ(5, first->getPrev()->getValue());
+    EXPECT_EQ(8, lst.getSize());
+
+    int expected[] = { 1, 2, 3, 4, 5, 7, 7, 7 };
+    int i = 0;
+    for (IntBidiListNode* nd = lst.getHeadNode(); nd; nd = nd->getNext())
+        EXPECT_EQ(expected[i++], nd->getValue());
+    for (IntBidiListNode* nd = lst.getLastNode(); nd; nd = nd->getPrev())
+        EXPECT_EQ(expected[--i], nd->getValue());
+}
+
+
+TEST(Range, insertRangeAfter)
+{
+    IntBidiList lst;
+    IntBidiListNode* nd1 = lst.appendEl(1);
+    lst.appendEl(5);
+
+    const int vals[] = { 2, 3, 4 };
+    IntBidiListNode* first = lst.insertRangeAfter(nd1, vals, vals + 3);
+    EXPECT_EQ(nd1->getNext(), first);
+    EXPECT_EQ(5, lst.getSize());
+    EXPECT_EQ(5, lst.getLastNode()->getValue());
+
+    int i = 1;
+    for (IntBidiList::iterator it = lst.begin(); it != lst.end(); ++it)
+        EXPECT_EQ(i++, *it);
+}
+
+
+TEST(Range, assign)
+{
+    IntBidiList lst;
+    const int vals[] = { 1, 2, 3, 4, 5 };
+
+    // to an empty list
+    lst.assign(vals, vals + 3);
+    EXPECT_EQ(3, lst.getSize());
+    IntBidiListNode* head = lst.getHeadNode();
+
+    // a longer range reuses nodes and appends the rest
+    lst.assign(vals + 1, vals + 5);
+    EXPECT_EQ(head, lst.getHeadNode());
+    EXPECT_EQ(2, head->getValue());
+    EXPECT_EQ(4, lst.getSize());
+    EXPECT_EQ(5, lst.getLastNode()->getValue());
+
+    // a shorter one drops nodes left over
+    lst.assign(vals, vals + 2);
+    EXPECT_EQ(head, lst.getHeadNode());
+    EXPECT_EQ(2, lst.getSize());
+    EXPECT_EQ(2, lst.getLastNode()->getValue());
+    EXPECT_EQ(nullptr, lst.getLastNode()->getNext());
+
+    lst.assign(vals, vals);
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+    EXPECT_EQ(nullptr, lst.getLastNode());
+    EXPECT_EQ(0, lst.getSize());
+}
+
+
+/** \brief Throws on copying a marked value */
+struct ThrowingCopy
+{
+    ThrowingCopy(int v = 0) : val(v) {}
+    ThrowingCopy(const ThrowingCopy &other) : val(other.val)
+    {
+        if (val < 0)
+            throw std::runtime_error("copy");
+    }
+    ThrowingCopy &operator=(const ThrowingCopy &other) = default;
+    bool operator==(const ThrowingCopy &other) const { return val == other.val; }
+
+    int val;
+};
+
+
+TEST(Range, exceptionSafety)
+{
+    BidiLinkedList<ThrowingCopy> lst;
+    lst.appendEl(ThrowingCopy(1));
+
+    const ThrowingCopy vals[] = { ThrowingCopy(2), ThrowingCopy(3), ThrowingCopy(-1) };
+    EXPECT_THROW(lst.appendRange(vals, vals + 3), std::runtime_error);
+    EXPECT_EQ(1, lst.getSize());
+    EXPECT_EQ(lst.getHeadNode(), lst.getLastNode());
+}
+
+
+///////////////////////////// DEQUE TESTS /////////////////////////////
+
+TEST(Deque, pushPop)
+{
+    IntBidiList lst;
+    lst.pushBack(2);
+    lst.pushBack(3);
+    lst.pushFront(1);
+    EXPECT_EQ(3, lst.getSize());
+    EXPECT_EQ(1, lst.getHeadNode()->getValue());
+    EXPECT_EQ(3, lst.getLastNode()->getValue());
+
+    EXPECT_EQ(3, lst.popBack());
+    EXPECT_EQ(1, lst.popFront());
+    EXPECT_EQ(1, lst.getSize());
+    EXPECT_EQ(lst.getHeadNode(), lst.getLastNode());
+    EXPECT_EQ(nullptr, lst.getHeadNode()->getPrev());
+    EXPECT_EQ(nullptr, lst.getHeadNode()->getNext());
+
+    EXPECT_EQ(2, lst.popBack());
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+    EXPECT_EQ(nullptr, lst.getLastNode());
+    EXPECT_EQ(0, lst.getSize());
+
+    EXPECT_THROW(lst.popFront(), std::invalid_argument);
+    EXPECT_THROW(lst.popBack(), std::invalid_argument);
+}
+
+
+TEST(Deque, popFrontN)
+{
+    IntBidiList lst;
+    for (int i = 0; i < 5; ++i)
+        lst.pushBack(i);
+
+    int out[8];
+    EXPECT_EQ(3, lst.popFrontN(out, 3));
+    EXPECT_EQ(0, out[0]);
+    EXPECT_EQ(2, out[2]);
+    EXPECT_EQ(3, lst.getHeadNode()->getValue());
+    EXPECT_EQ(nullptr, lst.getHeadNode()->getPrev());
+    EXPECT_EQ(2, lst.getSize());
+
+    EXPECT_EQ(2, lst.popFrontN(out, 8));
+    EXPECT_EQ(4, out[1]);
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+    EXPECT_EQ(nullptr, lst.getLastNode());
+    EXPECT_EQ(0, lst.popFrontN(out, 8));
+}
+
+
+TEST(Deque, nodeCache)
+{
+    IntBidiList lst;
+    lst.pushBack(1);
+    IntBidiListNode* nd = lst.getHeadNode();
+    lst.popFront();
+    EXPECT_EQ(1, lst.getCachedNodeCount());
+
+    // a popped node is reused
+    lst.pushBack(2);
+    EXPECT_EQ(nd, lst.getHeadNode());
+    EXPECT_EQ(0, lst.getCachedNodeCount());
+
+    // the cache is bounded
+    for (int i = 0; i < 100; ++i)
+        lst.pushBack(i);
+    int out[101];
+    lst.popFrontN(out, 101);
+    std::size_t cacheSize = DefaultBidiListPolicy::NODE_CACHE_SIZE;
+    EXPECT_EQ(cacheSize, lst.getCachedNodeCount());
+
+    lst.clear();
+    EXPECT_EQ(0, lst.getCachedNodeCount());
+}
+
+
+/** \brief Policy of a list without a node cache */
+struct NoCachePolicy : DefaultBidiListPolicy
+{
+    static const std::size_t NODE_CACHE_SIZE = 0;
+};
+
+
+TEST(Deque, noCache)
+{
+    BidiLinkedList<std::string, NoCachePolicy> lst;
+    lst.pushBack("b");
+    lst.pushFront("a");
+    EXPECT_EQ("b", lst.popBack());
+    EXPECT_EQ("a", lst.popFront());
+    EXPECT_EQ(0, lst.getCachedNodeCount());
+}
+
+
+///////////////////////////// REVERSAL TESTS /////////////////////////////
+
+/** \brief Policy of a list supporting O(1) reversal */
+struct ReversiblePolicy : DefaultBidiListPolicy
+{
+    static const bool REVERSIBLE = true;
+};
+
+typedef BidiLinkedList<int, ReversiblePolicy> RevList;
+
+
+/** \brief Returns values of a list in its order, checking backward links agree */
+template<typename List>
+std::vector<int> listValues(List &lst)
+{
+    std::vector<int> res;
+    for (typename List::Node* nd = lst.getHeadNode(); nd; nd = lst.getNextNode(nd))
+        res.push_back(nd->getValue());
+
+    std::vector<int> back;
+    for (typename List::Node* nd = lst.getLastNode(); nd; nd = lst.getPrevNode(nd))
+        back.insert(back.begin(), nd->getValue());
+    EXPECT_EQ(res, back);
+
+    return res;
+}
+
+
+TEST(Reversal, reverseFlag)
+{
+    RevList lst;
+    const int vals[] = { 1, 2, 3, 4 };
+    lst.appendRange(vals, vals + 4);
+    EXPECT_FALSE(lst.isReversed());
+
+    lst.reverse();
+    EXPECT_TRUE(lst.isReversed());
+    EXPECT_EQ(std::vector<int>({ 4, 3, 2, 1 }), listValues(lst));
+    EXPECT_EQ(4, lst.getSize());
+
+    // iterators follow the flag
+    std::vector<int> fwd;
+    for (RevList::iterator it = lst.begin(); it != lst.end(); ++it)
+        fwd.push_back(*it);
+    EXPECT_EQ(std::vector<int>({ 4, 3, 2, 1 }), fwd);
+    std::vector<int> bwd;
+    for (RevList::reverse_iterator it = lst.rbegin(); it != lst.rend(); ++it)
+        bwd.push_back(*it);
+    EXPECT_EQ(std::vector<int>({ 1, 2, 3, 4 }), bwd);
+
+    // so do structural methods
+    lst.appendEl(0);
+    lst.pushFront(5);
+    EXPECT_EQ(std::vector<int>({ 5, 4, 3, 2, 1, 0 }), listValues(lst));
+
+    RevList::Node* nd3 = lst.findFirst(3);
+    lst.insertNodeAfter(nd3, new RevList::Node(10));
+    lst.insertNodeBefore(nd3, new RevList::Node(11));
+    EXPECT_EQ(std::vector<int>({ 5, 4, 11, 3, 10, 2, 1, 0 }), listValues(lst));
+
+    EXPECT_EQ(0, lst.popBack());
+    EXPECT_EQ(5, lst.popFront());
+
+    // a cut chain is passed in the list order
+    RevList::Node* nd11 = lst.findFirst(11);
+    RevList::Node* nd10 = lst.findFirst(10);
+    lst.cutNodes(nd11, nd10);
+    EXPECT_EQ(std::vector<int>({ 4, 2, 1 }), listValues(lst));
+    lst.insertNodesAfter(nullptr, nd11, nd10);
+    EXPECT_EQ(std::vector<int>({ 4, 2, 1, 11, 3, 10 }), listValues(lst));
+
+    // flipping back restores the raw order
+    lst.reverse();
+    EXPECT_EQ(std::vector<int>({ 10, 3, 11, 1, 2, 4 }), listValues(lst));
+    EXPECT_EQ(lst.getHeadNode()->getNext(), lst.getNextNode(lst.getHeadNode()));
+}
+
+
+TEST(Reversal, reverseEmpty)
+{
+    RevList lst;
+    lst.reverse();
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+    EXPECT_EQ(nullptr, lst.getLastNode());
+
+    lst.pushBack(1);
+    lst.pushBack(2);
+    EXPECT_EQ(std::vector<int>({ 1, 2 }), listValues(lst));
+    lst.reverse();
+    EXPECT_EQ(std::vector<int>({ 2, 1 }), listValues(lst));
+}
+
+
+TEST(Reversal, reverseInPlace)
+{
+    IntBidiList lst;
+    lst.reverseInPlace();
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+
+    const int vals[] = { 1, 2, 3, 4 };
+    lst.appendRange(vals, vals + 4);
+    lst.reverseInPlace();
+    EXPECT_EQ(std::vector<int>({ 4, 3, 2, 1 }), listValues(lst));
+    EXPECT_EQ(3, lst.getHeadNode()->getNext()->getValue());
+    EXPECT_EQ(nullptr, lst.getHeadNode()->getPrev());
+
+    lst.appendEl(0);
+    EXPECT_EQ(std::vector<int>({ 4, 3, 2, 1, 0 }), listValues(lst));
+
+    // both reversals together
+    RevList rlst;
+    rlst.appendRange(vals, vals + 4);
+    rlst.reverse();
+    rlst.reverseInPlace();
+    EXPECT_EQ(std::vector<int>({ 1, 2, 3, 4 }), listValues(rlst));
+    // raw links are against the order of a flipped list
+    EXPECT_EQ(nullptr, rlst.getHeadNode()->getNext());
+    EXPECT_EQ(2, rlst.getHeadNode()->getPrev()->getValue());
+}
+
+
+///////////////////////////// SELF-ORGANIZATION TESTS /////////////////////////////
+
+/** \brief Policy of a list with a given self-organization */
+template<BidiSelfOrganization Org>
+struct SelfOrgPolicy : DefaultBidiListPolicy
+{
+    static const BidiSelfOrganization SELF_ORGANIZATION = Org;
+};
+
+
+TEST(SelfOrganization, moveToFront)
+{
+    BidiLinkedList<int, SelfOrgPolicy<BIDI_MOVE_TO_FRONT> > lst;
+    const int vals[] = { 1, 2, 3, 4 };
+    lst.appendRange(vals, vals + 4);
+
+    EXPECT_EQ(3, lst.findFirst(3)->getValue());
+    EXPECT_EQ(std::vector<int>({ 3, 1, 2, 4 }), listValues(lst));
+    lst.findFirst(4);
+    EXPECT_EQ(std::vector<int>({ 4, 3, 1, 2 }), listValues(lst));
+    lst.findFirst(4);
+    EXPECT_EQ(std::vector<int>({ 4, 3, 1, 2 }), listValues(lst));
+    EXPECT_EQ(nullptr, lst.findFirst(5));
+    EXPECT_EQ(4, lst.getSize());
+    EXPECT_EQ(2, lst.getLastNode()->getValue());
+
+    // cutting does not reorder
+    delete lst.cutFirst(1);
+    EXPECT_EQ(std::vector<int>({ 4, 3, 2 }), listValues(lst));
+    delete lst.cutFirst(2);
+}
+
+
+TEST(SelfOrganization, transpose)
+{
+    BidiLinkedList<int, SelfOrgPolicy<BIDI_TRANSPOSE> > lst;
+    const int vals[] = { 1, 2, 3, 4 };
+    lst.appendRange(vals, vals + 4);
+
+    lst.findFirst(4);
+    EXPECT_EQ(std::vector<int>({ 1, 2, 4, 3 }), listValues(lst));
+    EXPECT_EQ(3, lst.getLastNode()->getValue());
+    lst.findFirst(4);
+    lst.findFirst(4);
+    lst.findFirst(4);
+    EXPECT_EQ(std::vector<int>({ 4, 1, 2, 3 }), listValues(lst));
+}
+
+
+TEST(SelfOrganization, frequencyCount)
+{
+    typedef BidiLinkedList<int, SelfOrgPolicy<BIDI_FREQUENCY_COUNT> > CountList;
+    CountList lst;
+    const int vals[] = { 1, 2, 3, 4 };
+    lst.appendRange(vals, vals + 4);
+
+    lst.findFirst(3);
+    EXPECT_EQ(std::vector<int>({ 3, 1, 2, 4 }), listValues(lst));
+    lst.findFirst(4);
+    EXPECT_EQ(std::vector<int>({ 3, 4, 1, 2 }), listValues(lst));
+    lst.findFirst(4);
+    EXPECT_EQ(std::vector<int>({ 4, 3, 1, 2 }), listValues(lst));
+    EXPECT_EQ(2, lst.getHeadNode()->getHits());
+    EXPECT_EQ(0, lst.getLastNode()->getHits());
+
+    // equal counts keep their order
+    lst.findFirst(3);
+    EXPECT_EQ(std::vector<int>({ 4, 3, 1, 2 }), listValues(lst));
+
+    // no room taken by counters of other lists
+    EXPECT_EQ(sizeof(IntBidiListNode) + sizeof(std::size_t), sizeof(CountList::Node));
+}
+
+
+TEST(SelfOrganization, frequencyCountSurvivesRelinearize)
+{
+    typedef BidiLinkedList<int, SelfOrgPolicy<BIDI_FREQUENCY_COUNT> > CountList;
+    CountList lst;
+    const int vals[] = { 1, 2, 3, 4 };
+    lst.appendRange(vals, vals + 4);
+    lst.findFirst(3);
+    lst.findFirst(3);
+    lst.findFirst(2);
+
+    lst.relinearize();
+    EXPECT_EQ(std::vector<int>({ 3, 2, 1, 4 }), listValues(lst));
+    EXPECT_EQ(2, lst.getHeadNode()->getHits());
+    EXPECT_EQ(1, lst.getHeadNode()->getNext()->getHits());
+
+    // the order is still kept by the counts
+    lst.findFirst(2);
+    lst.findFirst(2);
+    EXPECT_EQ(std::vector<int>({ 2, 3, 1, 4 }), listValues(lst));
+
+    // reused nodes start counting anew
+    lst.assign(vals, vals + 4);
+    for (CountList::Node* nd = lst.getHeadNode(); nd; nd = nd->getNext())
+        EXPECT_EQ(0, nd->getHits());
+}
+
+
+///////////////////////////// FINGER TESTS /////////////////////////////
+
+TEST(Finger, findNear)
+{
+    IntBidiList lst;
+    const int vals[] = { 1, 2, 3, 2, 5, 6, 7 };
+    lst.appendRange(vals, vals + 7);
+    EXPECT_EQ(nullptr, lst.getFinger());
+
+    // without a finger, from the head
+    IntBidiListNode* nd = lst.findNear(2);
+    EXPECT_EQ(lst.getHeadNode()->getNext(), nd);
+    EXPECT_EQ(nd, lst.getFinger());
+
+    // the closest one in either direction
+    IntBidiListNode* nd6 = lst.findFirst(6);
+    EXPECT_EQ(nd6, lst.getFinger());
+    EXPECT_EQ(nd6->getPrev()->getPrev(), lst.findNear(2));
+    EXPECT_EQ(lst.getHeadNode(), lst.findNear(1));
+    EXPECT_EQ(lst.getLastNode(), lst.findNear(7));
+    EXPECT_EQ(nullptr, lst.findNear(8));
+    EXPECT_EQ(lst.getLastNode(), lst.getFinger());
+}
+
+
+TEST(Finger, invalidation)
+{
+    IntBidiList lst;
+    const int vals[] = { 1, 2, 3, 4, 5 };
+    lst.appendRange(vals, vals + 5);
+
+    // cutting another single node keeps the finger
+    IntBidiListNode* nd3 = lst.findFirst(3);
+    IntBidiListNode* nd1 = lst.cutNode(lst.getHeadNode());
+    EXPECT_EQ(nd3, lst.getFinger());
+    delete nd1;
+
+    delete lst.cutNode(nd3);
+    EXPECT_EQ(nullptr, lst.getFinger());
+
+    // any chain drops it
+    lst.findFirst(2);
+    IntBidiListNode* nd4 = lst.findFirst(4);
+    lst.cutNodes(nd4, lst.getLastNode());
+    EXPECT_EQ(nullptr, lst.getFinger());
+    lst.insertNodesAfter(nullptr, nd4, nd4->getNext());
+
+    lst.findFirst(5);
+    EXPECT_EQ(5, lst.popBack());
+    EXPECT_EQ(nullptr, lst.getFinger());
+
+    lst.findFirst(2);
+    lst.clear();
+    EXPECT_EQ(nullptr, lst.getFinger());
+}
+
+
+///////////////////////////// HASH TAG TESTS /////////////////////////////
+
+/** \brief Policy of a list whose nodes cache hashes of values */
+struct TaggedPolicy : DefaultBidiListPolicy
+{
+    static const bool HASH_TAGS = true;
+};
+
+/** \brief Key whose hashes collide a lot, so that tags match for unequal values */
+struct CollidingKey
+{
+    int val;
+
+    CollidingKey(int v = 0) : val(v) {}
+    bool operator==(const CollidingKey &other) const { return val == other.val; }
+};
+
+namespace std {
+template<>
+struct hash<CollidingKey>
+{
+    std::size_t operator()(const CollidingKey &key) const { return (std::size_t) key.val % 2; }
+};
+}
+
+
+TEST(HashTags, searches)
+{
+    typedef BidiLinkedList<std::string, TaggedPolicy> StrList;
+    StrList lst;
+    const std::string vals[] = { "alpha", "beta", "gamma", "beta", "delta" };
+    lst.appendRange(vals, vals + 5);
+
+    EXPECT_EQ(std::hash<std::string>()("beta"), lst.getHeadNode()->getNext()->getHashTag());
+    EXPECT_EQ(lst.getHeadNode()->getNext(), lst.findFirst("beta"));
+    EXPECT_EQ(nullptr, lst.findFirst("epsilon"));
+    EXPECT_EQ(2, lst.count("beta"));
+
+    int size;
+    StrList::Node **found = lst.findAll(lst.getHeadNode(), "beta", size);
+    ASSERT_EQ(2, size);
+    EXPECT_EQ("gamma", found[0]->getNext()->getValue());
+    delete[] found;
+
+    delete lst.cutFirst("gamma");
+    EXPECT_EQ(nullptr, lst.findFirst("gamma"));
+    EXPECT_EQ(lst.getLastNode(), lst.findNear("delta"));
+
+    // no room taken by tags of other lists
+    EXPECT_EQ(sizeof(BidiLinkedList<std::string>::Node) + sizeof(std::size_t), sizeof(StrList::Node));
+}
+
+
+TEST(HashTags, collisions)
+{
+    typedef BidiLinkedList<CollidingKey, TaggedPolicy> KeyList;
+    KeyList lst;
+    for (int i = 0; i < 10; ++i)
+        lst.appendEl(CollidingKey(i));
+
+    // equal tags do not make values equal
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(i, lst.findFirst(CollidingKey(i))->getValue().val);
+    EXPECT_EQ(nullptr, lst.findFirst(CollidingKey(12)));
+    EXPECT_EQ(1, lst.count(CollidingKey(4)));
+}
+
+
+TEST(HashTags, keptInSync)
+{
+    typedef BidiLinkedList<std::string, TaggedPolicy> StrList;
+    StrList lst;
+    StrList::Node *nd = lst.appendEl("one");
+
+    nd->setValue("two");
+    EXPECT_EQ(nd, lst.findFirst("two"));
+    EXPECT_EQ(nullptr, lst.findFirst("one"));
+
+    // values changed by forEach() are retagged
+    lst.forEach([](std::string &v) { v += "!"; });
+    EXPECT_EQ(nd, lst.findFirst("two!"));
+
+    // nodes reused by assign() and by pushes from the node cache
+    const std::string vals[] = { "x", "y" };
+    lst.assign(vals, vals + 2);
+    EXPECT_EQ(lst.getLastNode(), lst.findFirst("y"));
+    EXPECT_EQ("y", lst.popBack());
+    lst.pushBack("z");
+    EXPECT_EQ(lst.getLastNode(), lst.findFirst("z"));
+    EXPECT_EQ(nullptr, lst.findFirst("y"));
+
+    // nodes moved by relinearization keep their tags
+    lst.relinearize();
+    EXPECT_EQ(lst.getHeadNode(), lst.findFirst("x"));
+    EXPECT_EQ(lst.getLastNode(), lst.findFirst("z"));
+}
+
+
+///////////////////////////// POLICY TESTS /////////////////////////////
+
+/** \brief Policy of a list with no checks and no size and tail tracking */
+struct BarePolicy : DefaultBidiListPolicy
+{
+    static const bool CHECKED = false;
+    static const bool TRACK_SIZE = false;
+    static const bool TRACK_TAIL = false;
+};
+
+/** \brief Policy of a list reporting errors by codes */
+struct NoExceptPolicy : DefaultBidiListPolicy
+{
+    static const bool USE_EXCEPTIONS = false;
+};
+
+
+TEST(Policy, bareList)
+{
+    typedef BidiLinkedList<int, BarePolicy> BareList;
+    BareList lst;
+    EXPECT_EQ(nullptr, lst.getLastNode());
+
+    BareList::Node* nodes[5];
+    for (int i = 0; i < 5; ++i)
+        nodes[i] = lst.appendEl(i);
+
+    // a tail is found by walking
+    EXPECT_EQ(nodes[4], lst.getLastNode());
+    EXPECT_EQ(5, lst.getSize());
+
+    lst.cutNodes(nodes[3], nodes[4]);
+    EXPECT_EQ(nodes[2], lst.getLastNode());
+    EXPECT_EQ(3, lst.getSize());
+
+    lst.insertNodesBefore(nodes[0], nodes[3], nodes[4]);
+    EXPECT_EQ(nodes[3], lst.getHeadNode());
+    EXPECT_EQ(nodes[2], lst.getLastNode());
+    EXPECT_EQ(5, lst.getSize());
+
+    const int expected[] = { 3, 4, 0, 1, 2 };
+    int i = 0;
+    for (BareList::iterator it = lst.begin(); it != lst.end(); ++it)
+        EXPECT_EQ(expected[i++], *it);
+    EXPECT_EQ(5, i);
+
+    // the size is counted again without any cache invalidation
+    lst.cutNode(nodes[0]);
+    delete nodes[0];
+    EXPECT_EQ(4, lst.getSize());
+}
+
+
+TEST(Policy, errorCodes)
+{
+    typedef BidiLinkedList<int, NoExceptPolicy> CodeList;
+    CodeList lst;
+    CodeList::Node* nd1 = lst.appendEl(1);
+    CodeList::Node* nd2 = lst.appendEl(2);
+    EXPECT_EQ(BIDI_LIST_OK, lst.getLastError());
+
+    EXPECT_EQ(nullptr, lst.insertNodeAfter(nullptr, nullptr));
+    EXPECT_EQ(BIDI_LIST_NULL_NODE, lst.getLastError());
+
+    lst.resetError();
+    EXPECT_EQ(nullptr, lst.insertNodeAfter(nd1, nd2));
+    EXPECT_EQ(BIDI_LIST_NODE_NOT_FREE, lst.getLastError());
+
+    lst.resetError();
+    EXPECT_EQ(nullptr, lst.insertNodeBefore(nd2, nd1));
+    EXPECT_EQ(BIDI_LIST_NODE_NOT_FREE, lst.getLastError());
+
+    lst.resetError();
+    lst.insertNodesAfter(nullptr, nd1, nullptr);
+    EXPECT_EQ(BIDI_LIST_NULL_NODE, lst.getLastError());
+
+    lst.resetError();
+    lst.cutNodes(nullptr, nd2);
+    EXPECT_EQ(BIDI_LIST_NULL_NODE, lst.getLastError());
+
+    // failed calls leave the list unchanged
+    EXPECT_EQ(nd1, lst.getHeadNode());
+    EXPECT_EQ(nd2, lst.getLastNode());
+    EXPECT_EQ(2, lst.getSize());
+
+    // a successful call does not reset an error
+    lst.cutNode(nd1);
+    EXPECT_EQ(BIDI_LIST_NULL_NODE, lst.getLastError());
+    delete nd1;
+}
+
+
 ///////////////////////////// ITERATOR TESTS /////////////////////////////
 
 #ifdef TEST_ITERATOR
@@ -677,6 +1522,23 @@ TEST(Iterators, postfixEncDec)
 }
 
 
+TEST(Iterators, emptyAndGrownList)
+{
+    IntBidiList lst;
+    EXPECT_TRUE(lst.begin() == lst.end());
+    EXPECT_TRUE(lst.rbegin() == lst.rend());
+
+    // an end iterator taken before appending still ends the iteration
+    lst.appendEl(1);
+    IntBidiList::iterator end = lst.end();
+    lst.appendEl(2);
+
+    int count = 0;
+    for (IntBidiList::iterator it = lst.begin(); it != end; ++it)
+        ++count;
+    EXPECT_EQ(count, 2);
+}
+
 #else // TEST_ITERATOR
 TEST(Iterators, notImplemented)
 {
@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for BidiMpscQueue class.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "bidi_mpsc_queue.h"
+
+/** \brief Type alias for a queue of integers */
+typedef BidiMpscQueue<int> IntMpscQueue;
+typedef BidiLinkedList<int> IntBidiList;
+
+
+/** \brief Returns values of \a lst forwards, and checks backward order agrees */
+static std::vector<int> listValues(IntBidiList &lst)
+{
+    std::vector<int> res;
+    for (IntBidiList::Node *nd = lst.getHeadNode(); nd; nd = nd->getNext())
+        res.push_back(nd->getValue());
+
+    std::vector<int> back;
+    for (IntBidiList::Node *nd = lst.getLastNode(); nd; nd = nd->getPrev())
+        back.insert(back.begin(), nd->getValue());
+    EXPECT_EQ(res, back);
+
+    return res;
+}
+
+
+TEST(MpscQueue, pushPop)
+{
+    IntMpscQueue queue;
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.pop(), nullptr);
+
+    queue.push(1);
+    queue.push(2);
+    EXPECT_FALSE(queue.isEmpty());
+
+    IntMpscQueue::Node *node = queue.pop();
+    EXPECT_EQ(node->getValue(), 1);
+    EXPECT_EQ(node->getNext(), nullptr);
+
+    // a popped node is pushed again with no allocation
+    queue.push(node);
+    IntMpscQueue::Node *second = queue.pop();
+    EXPECT_EQ(second->getValue(), 2);
+    delete second;
+    EXPECT_EQ(queue.pop(), node);
+    EXPECT_EQ(queue.pop(), nullptr);
+    EXPECT_TRUE(queue.isEmpty());
+    delete node;
+
+    EXPECT_THROW(queue.push((IntMpscQueue::Node *) nullptr), std::invalid_argument);
+
+    // nodes left are deleted by the queue
+    queue.push(3);
+}
+
+
+TEST(MpscQueue, chainsAndSplicing)
+{
+    IntBidiList src;
+    for (int i = 1; i <= 6; ++i)
+        src.appendEl(i);
+
+    // nodes go from a list through the queue to another list
+    IntMpscQueue queue;
+    IntBidiList::Node *beg = src.getHeadNode();
+    IntBidiList::Node *end = beg->getNext()->getNext();
+    src.cutNodes(beg, end);
+    queue.pushChain(beg, end);
+    queue.push(src.cutNode(src.getHeadNode()));
+    // a node still linked to a list is not free
+    EXPECT_THROW(queue.pushChain(src.getHeadNode(), nullptr), std::invalid_argument);
+
+    IntBidiList dst;
+    dst.appendEl(0);
+    EXPECT_EQ(queue.popBatch(beg, end, 3), 3);
+    dst.insertNodesAfter(nullptr, beg, end, 3);
+    EXPECT_EQ(queue.popBatch(beg, end), 1);
+    dst.insertNodesAfter(nullptr, beg, end, 1);
+    EXPECT_EQ(queue.popBatch(beg, end), 0);
+    EXPECT_EQ(beg, nullptr);
+
+    EXPECT_EQ(listValues(dst), std::vector<int>({ 0, 1, 2, 3, 4 }));
+    EXPECT_EQ(dst.getSize(), 5);
+}
+
+
+TEST(MpscQueue, parallelProducers)
+{
+    const int PRODUCERS = 4;
+    const int PER_PRODUCER = 20000;
+
+    IntMpscQueue queue;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < PRODUCERS; ++t)
+        producers.push_back(std::thread([&queue, t]()
+        {
+            for (int i = 0; i < PER_PRODUCER; ++i)
+                queue.push(t * PER_PRODUCER + i);
+        }));
+
+    // the consumer splices batches into a list while producers go on
+    IntBidiList lst;
+    std::size_t total = 0;
+    while (total < (std::size_t) PRODUCERS * PER_PRODUCER)
+    {
+        IntBidiList::Node *beg;
+        IntBidiList::Node *end;
+        std::size_t count = queue.popBatch(beg, end, 256);
+        if (count == 0)
+            std::this_thread::yield();
+        else
+            lst.insertNodesAfter(nullptr, beg, end, count);
+        total += count;
+    }
+    for (std::size_t t = 0; t < producers.size(); ++t)
+        producers[t].join();
+    EXPECT_TRUE(queue.isEmpty());
+
+    // values of each producer come in order
+    std::vector<int> last(PRODUCERS, -1);
+    int errors = 0;
+    for (int val : lst)
+    {
+        int &prev = last[val / PER_PRODUCER];
+        if (val <= prev)
+            ++errors;
+        prev = val;
+    }
+    EXPECT_EQ(errors, 0);
+    EXPECT_EQ(lst.getSize(), total);
+}
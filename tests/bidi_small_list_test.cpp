@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for BidiSmallList class.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "bidi_small_list.h"
+
+/** \brief Type alias for a list of integers with 4 inline nodes */
+typedef BidiSmallList<int, 4> IntSmallList;
+typedef IntSmallList::Node IntSmallListNode;
+
+/** \brief Policy of lists ordered by hit counters */
+struct CountPolicy : DefaultBidiListPolicy
+{
+    static const BidiSelfOrganization SELF_ORGANIZATION = BIDI_FREQUENCY_COUNT;
+};
+
+
+TEST(SmallList, simpleCreate)
+{
+    IntSmallList lst;
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+    EXPECT_EQ(0, lst.getSize());
+    EXPECT_EQ(0, lst.getInlineCount());
+    EXPECT_GE(sizeof(IntSmallList), 4 * sizeof(IntSmallListNode));
+}
+
+
+TEST(SmallList, spillToHeap)
+{
+    IntSmallList lst;
+    IntSmallListNode* nodes[6];
+    for (int i = 0; i < 6; ++i)
+        nodes[i] = lst.appendEl(i);
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(lst.isInline(nodes[i]));
+    EXPECT_FALSE(lst.isInline(nodes[4]));
+    EXPECT_FALSE(lst.isInline(nodes[5]));
+    EXPECT_EQ(4, lst.getInlineCount());
+    EXPECT_EQ(6, lst.getSize());
+
+    int expected = 0;
+    for (int v : lst)
+        EXPECT_EQ(expected++, v);
+}
+
+
+TEST(SmallList, reuseFreedSlot)
+{
+    IntSmallList lst;
+    for (int i = 0; i < 5; ++i)
+        lst.appendEl(i);
+
+    IntSmallListNode* nd = lst.cutNode(lst.findFirst(2));
+    ASSERT_TRUE(lst.isInline(nd));
+    lst.destroyNode(nd);
+    EXPECT_EQ(3, lst.getInlineCount());
+
+    // the freed slot is taken before the heap
+    IntSmallListNode* nd2 = lst.appendEl(10);
+    EXPECT_EQ(nd, nd2);
+    EXPECT_EQ(4, lst.getInlineCount());
+
+    // a heap node is freed as well
+    IntSmallListNode* heapNd = lst.cutNode(lst.findFirst(4));
+    ASSERT_FALSE(lst.isInline(heapNd));
+    lst.destroyNode(heapNd);
+    EXPECT_EQ(4, lst.getSize());
+}
+
+
+TEST(SmallList, destroyLinkedNode)
+{
+    IntSmallList lst;
+    IntSmallListNode* nd = lst.appendEl(1);
+    lst.appendEl(2);
+    EXPECT_THROW(lst.destroyNode(nd), std::invalid_argument);
+    EXPECT_THROW(lst.destroyNode(nullptr), std::invalid_argument);
+}
+
+
+TEST(SmallList, spliceKeepsNodes)
+{
+    IntSmallList lst;
+    IntSmallListNode* nodes[6];
+    for (int i = 0; i < 6; ++i)
+        nodes[i] = lst.appendEl(i);
+
+    // move an inline/heap mixed chain to the front
+    lst.cutNodes(nodes[3], nodes[4]);
+    lst.insertNodesBefore(nodes[0], nodes[3], nodes[4]);
+
+    const int expected[] = { 3, 4, 0, 1, 2, 5 };
+    int i = 0;
+    for (IntSmallListNode* nd = lst.getHeadNode(); nd; nd = nd->getNext())
+    {
+        EXPECT_EQ(nodes[expected[i]], nd);
+        EXPECT_EQ(expected[i], nd->getValue());
+        ++i;
+    }
+    EXPECT_EQ(6, i);
+}
+
+
+TEST(SmallList, clear)
+{
+    BidiSmallList<std::string, 2> lst;
+    for (int i = 0; i < 5; ++i)
+        lst.appendEl(std::string(100, (char) ('a' + i)));
+
+    lst.clear();
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+    EXPECT_EQ(nullptr, lst.getLastNode());
+    EXPECT_EQ(0, lst.getSize());
+    EXPECT_EQ(0, lst.getInlineCount());
+
+    // the list is usable after clearing
+    lst.appendEl("x");
+    EXPECT_EQ(1, lst.getInlineCount());
+    EXPECT_EQ("x", lst.getHeadNode()->getValue());
+}
+
+
+TEST(SmallList, fullMask)
+{
+    BidiSmallList<int, 64> lst;
+    for (int i = 0; i < 65; ++i)
+        lst.appendEl(i);
+
+    EXPECT_EQ(64, lst.getInlineCount());
+    EXPECT_FALSE(lst.isInline(lst.getLastNode()));
+    EXPECT_EQ(65, lst.getSize());
+}
+
+
+TEST(SmallList, assign)
+{
+    IntSmallList lst;
+    for (int i = 0; i < 3; ++i)
+        lst.appendEl(i);
+
+    // the nodes left over go back to the buffer
+    std::vector<int> one(1, 7);
+    lst.assign(one.begin(), one.end());
+    EXPECT_EQ(1, lst.getSize());
+    EXPECT_EQ(1, lst.getInlineCount());
+    EXPECT_EQ(7, lst.getHeadNode()->getValue());
+
+    // missing ones come from the buffer first
+    std::vector<int> six;
+    for (int i = 0; i < 6; ++i)
+        six.push_back(i * 10);
+    lst.assign(six.begin(), six.end());
+    EXPECT_EQ(6, lst.getSize());
+    EXPECT_EQ(4, lst.getInlineCount());
+    int expected = 0;
+    for (int v : lst)
+    {
+        EXPECT_EQ(expected, v);
+        expected += 10;
+    }
+
+    lst.assign(six.begin(), six.begin());
+    EXPECT_EQ(0, lst.getSize());
+    EXPECT_EQ(0, lst.getInlineCount());
+}
+
+
+TEST(SmallList, reusedSlotsCountAnew)
+{
+    typedef BidiSmallList<int, 4, CountPolicy> CountSmallList;
+
+    CountSmallList lst;
+    lst.appendEl(1);
+    lst.appendEl(2);
+    lst.findFirst(2);
+    lst.findFirst(2);
+    EXPECT_EQ(2, lst.getHeadNode()->getHits());
+
+    // a freed slot gives a new value no hits
+    lst.destroyNode(lst.cutNode(lst.getHeadNode()));
+    CountSmallList::Node* nd = lst.appendEl(3);
+    EXPECT_EQ(0, nd->getHits());
+
+    // nor do nodes reused by assign()
+    lst.findFirst(3);
+    const int vals[] = { 5, 6 };
+    lst.assign(vals, vals + 2);
+    for (CountSmallList::Node* it = lst.getHeadNode(); it; it = it->getNext())
+        EXPECT_EQ(0, it->getHits());
+
+    // so new values are not reordered by old counts
+    lst.findFirst(6);
+    EXPECT_EQ(6, lst.getHeadNode()->getValue());
+}
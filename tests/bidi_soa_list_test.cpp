@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for BidiSoaList class.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bidi_soa_list.h"
+
+/** \brief Type alias for a list of integers */
+typedef BidiSoaList<int> IntSoaList;
+typedef IntSoaList::Handle IntSoaHandle;
+
+
+/** \brief Returns list values in list order as a string */
+template<typename T>
+std::string dump(const BidiSoaList<T> &lst)
+{
+    std::stringstream ss;
+    for (typename BidiSoaList<T>::Handle h = lst.getHeadNode(); h != lst.NO_NODE; h = lst.getNext(h))
+        ss << lst.getValue(h) << ' ';
+    return ss.str();
+}
+
+
+TEST(SoaList, simpleCreate)
+{
+    IntSoaList lst;
+    EXPECT_EQ(IntSoaList::NO_NODE, lst.getHeadNode());
+    EXPECT_EQ(IntSoaList::NO_NODE, lst.getLastNode());
+    EXPECT_EQ(0, lst.getSize());
+    EXPECT_EQ(0, lst.sum());
+    EXPECT_TRUE(lst.isOrdered());
+}
+
+
+TEST(SoaList, appendKeepsOrder)
+{
+    IntSoaList lst;
+    for (int i = 0; i < 100; ++i)
+        lst.appendEl(i % 10);
+
+    EXPECT_TRUE(lst.isOrdered());
+    EXPECT_EQ(100, lst.getSize());
+    EXPECT_EQ(450, lst.sum());
+    EXPECT_EQ(10, lst.count(3));
+    EXPECT_EQ(3, lst.findFirst(3));
+    EXPECT_FALSE(lst.contains(11));
+
+    int size = 0;
+    IntSoaHandle *fnd = lst.findAll(7, size);
+    ASSERT_EQ(10, size);
+    for (int i = 0; i < size; ++i)
+        EXPECT_EQ(7 + 10 * i, fnd[i]);
+    delete[] fnd;
+}
+
+
+TEST(SoaList, insertAndCut)
+{
+    IntSoaList lst;
+    IntSoaHandle nd1 = lst.appendEl(1);
+    IntSoaHandle nd3 = lst.appendEl(3);
+    lst.insertNodeAfter(nd1, lst.createNode(2));
+    lst.insertNodeBefore(IntSoaList::NO_NODE, lst.createNode(0));
+
+    EXPECT_FALSE(lst.isOrdered());
+    EXPECT_EQ("0 1 2 3 ", dump(lst));
+    EXPECT_EQ(nd1, lst.findFirst(1));
+    EXPECT_EQ(lst.getNext(nd1), lst.findFirst(2));
+
+    // cut nodes are excluded from value passes until they are inserted back
+    lst.cutNodes(nd1, lst.getNext(nd1));
+    EXPECT_EQ("0 3 ", dump(lst));
+    EXPECT_EQ(2, lst.getSize());
+    EXPECT_EQ(3, lst.sum());
+    EXPECT_EQ(0, lst.count(1));
+
+    lst.insertNodesAfter(nd3, nd1, lst.getNext(nd1));
+    EXPECT_EQ("0 3 1 2 ", dump(lst));
+    EXPECT_EQ(6, lst.sum());
+
+    EXPECT_THROW(lst.insertNodeAfter(nd3, nd1), std::invalid_argument);
+    EXPECT_THROW(lst.destroyNode(nd1), std::invalid_argument);
+
+    lst.destroyNode(lst.cutNode(nd1));
+    EXPECT_EQ("0 3 2 ", dump(lst));
+
+    // a released slot is reused
+    EXPECT_EQ(nd1, lst.createNode(5));
+}
+
+
+TEST(SoaList, iteratorsAndCutChecks)
+{
+    IntSoaList lst;
+    for (int i = 0; i < 5; ++i)
+        lst.appendEl(i);
+    lst.insertNodeAfter(lst.getHeadNode(), lst.createNode(9));
+
+    // iterators follow list order, not slot order
+    std::vector<int> vals(lst.begin(), lst.end());
+    EXPECT_EQ(std::vector<int>({ 0, 9, 1, 2, 3, 4 }), vals);
+    std::vector<int> back(lst.crbegin(), lst.crend());
+    EXPECT_EQ(std::vector<int>({ 4, 3, 2, 1, 9, 0 }), back);
+    for (int &v : lst)
+        v *= 2;
+    EXPECT_EQ(18, *++lst.cbegin());
+    EXPECT_EQ(lst.getLastNode(), (--lst.end()).getHandle());
+
+    IntSoaHandle cut = lst.cutFirst(18);
+    EXPECT_EQ(18, lst.getValue(cut));
+    EXPECT_EQ(IntSoaList::NO_NODE, lst.cutFirst(18));
+    EXPECT_EQ(5, lst.getSize());
+
+    // detached, released and unknown handles are not cut
+    EXPECT_THROW(lst.cutNode(cut), std::invalid_argument);
+    lst.destroyNode(cut);
+    EXPECT_THROW(lst.cutNode(cut), std::invalid_argument);
+    EXPECT_THROW(lst.cutNode(100), std::invalid_argument);
+    EXPECT_THROW(lst.cutNodes(lst.getLastNode(), lst.getHeadNode()), std::invalid_argument);
+    EXPECT_EQ(5, lst.getSize());
+    EXPECT_EQ("0 2 4 6 8 ", dump(lst));
+}
+
+
+TEST(SoaList, transformAndCompact)
+{
+    IntSoaList lst;
+    for (int i = 0; i < 10; ++i)
+        lst.insertNodeBefore(IntSoaList::NO_NODE, lst.createNode(i));
+    EXPECT_EQ("9 8 7 6 5 4 3 2 1 0 ", dump(lst));
+
+    int size = 0;
+    delete[] lst.cutAll(4, size);
+    EXPECT_EQ(1, size);
+
+    // a detached node prevents compacting
+    EXPECT_THROW(lst.compact(), std::logic_error);
+    lst.destroyNode(4);
+
+    lst.transform([](int v) { return v * 2; });
+    EXPECT_EQ(82, lst.sum());
+
+    lst.compact();
+    EXPECT_TRUE(lst.isOrdered());
+    EXPECT_EQ("18 16 14 12 10 6 4 2 0 ", dump(lst));
+    EXPECT_EQ(0, lst.getHeadNode());
+    EXPECT_EQ(5, lst.findFirst(6));
+    EXPECT_EQ(82, lst.sum());
+}
+
+
+TEST(SoaList, strings)
+{
+    BidiSoaList<std::string> lst;
+    lst.appendEl("a");
+    lst.appendEl("b");
+    lst.appendEl("a");
+
+    EXPECT_EQ(2, lst.count("a"));
+    EXPECT_EQ("aba", lst.sum());
+    EXPECT_EQ(1, lst.findFirst("b"));
+}
@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for BidiStaticList class.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "bidi_static_list.h"
+
+/** \brief Type alias for a list of at most 4 integers */
+typedef BidiStaticList<int, 4> IntStaticList;
+typedef IntStaticList::Node IntStaticListNode;
+
+
+// constant initialization is possible for literal types
+static IntStaticList globalList;
+constexpr IntStaticList constList;
+static_assert(IntStaticList::capacity() == 4, "capacity is a constant expression");
+static_assert(constList.isEmpty() && constList.getUsedCount() == 0, "observers are constant expressions");
+
+
+TEST(StaticList, simpleCreate)
+{
+    IntStaticList lst;
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+    EXPECT_EQ(nullptr, lst.getLastNode());
+    EXPECT_EQ(0, lst.getSize());
+    EXPECT_TRUE(lst.isEmpty());
+    EXPECT_TRUE(globalList.isEmpty());
+
+    // storage is a part of the list object
+    EXPECT_GE(sizeof(IntStaticList), 4 * sizeof(IntStaticListNode));
+}
+
+
+TEST(StaticList, capacityExhaustion)
+{
+    IntStaticList lst;
+    for (int i = 0; i < 4; ++i)
+        EXPECT_NE(nullptr, lst.appendEl(i));
+
+    EXPECT_EQ(nullptr, lst.appendEl(4));
+    EXPECT_EQ(nullptr, lst.acquireNode(4));
+    EXPECT_EQ(4, lst.getSize());
+    EXPECT_EQ(4, lst.getUsedCount());
+
+    // a released node can be acquired again
+    IntStaticListNode* nd = lst.cutFirst(2);
+    ASSERT_NE(nullptr, nd);
+    EXPECT_TRUE(lst.releaseNode(nd));
+    EXPECT_EQ(nd, lst.appendEl(5));
+    EXPECT_EQ(lst.getLastNode(), lst.findFirst(5));
+
+    IntStaticListNode foreign;
+    EXPECT_FALSE(lst.releaseNode(&foreign));
+}
+
+
+TEST(StaticList, releaseChecks)
+{
+    IntStaticList lst;
+    IntStaticListNode* nd1 = lst.appendEl(1);
+
+    // the only node of a list has no neighbours, but is still linked
+    EXPECT_FALSE(lst.releaseNode(nd1));
+    IntStaticListNode* nd2 = lst.appendEl(2);
+    EXPECT_FALSE(lst.releaseNode(nd1));
+    EXPECT_FALSE(lst.releaseNode(nd2));
+    EXPECT_EQ(2, lst.getUsedCount());
+
+    // a second release would loop the free list
+    lst.cutNode(nd2);
+    EXPECT_TRUE(lst.releaseNode(nd2));
+    EXPECT_FALSE(lst.releaseNode(nd2));
+    EXPECT_EQ(1, lst.getUsedCount());
+
+    // released and foreign nodes are not inserted
+    IntStaticListNode foreign;
+    EXPECT_EQ(nullptr, lst.insertNodeAfter(nd1, nd2));
+    EXPECT_EQ(nullptr, lst.insertNodeBefore(nd1, &foreign));
+    EXPECT_FALSE(lst.insertNodesAfter(nullptr, nd1, nd1));
+    EXPECT_EQ(1, lst.getSize());
+
+    IntStaticListNode* nd3 = lst.acquireNode(3);
+    EXPECT_EQ(nd2, nd3);
+    EXPECT_EQ(nd3, lst.insertNodeBefore(nd1, nd3));
+    EXPECT_EQ(2, lst.getSize());
+    EXPECT_EQ(2, lst.getUsedCount());
+}
+
+
+TEST(StaticList, cutChecks)
+{
+    IntStaticList lst;
+    IntStaticListNode* nd1 = lst.appendEl(1);
+    IntStaticListNode* nd2 = lst.appendEl(2);
+    IntStaticListNode* nd3 = lst.appendEl(3);
+
+    // a second cut would unhook the rest of the list
+    EXPECT_EQ(nd2, lst.cutNode(nd2));
+    EXPECT_EQ(nullptr, lst.cutNode(nd2));
+    EXPECT_EQ(nd1, lst.getHeadNode());
+    EXPECT_EQ(nd3, lst.getLastNode());
+    EXPECT_EQ(2, lst.getSize());
+
+    // released and foreign nodes are not cut either
+    EXPECT_TRUE(lst.releaseNode(nd2));
+    EXPECT_EQ(nullptr, lst.cutNode(nd2));
+    IntStaticListNode foreign;
+    EXPECT_EQ(nullptr, lst.cutNode(&foreign));
+    EXPECT_FALSE(lst.cutNodes(nd1, &foreign));
+    EXPECT_EQ(2, lst.getSize());
+
+    // the only node of a list is linked, though it has no neighbours
+    EXPECT_TRUE(lst.cutNodes(nd1, nd3));
+    IntStaticListNode* nd4 = lst.appendEl(4);
+    EXPECT_EQ(nd4, lst.cutNode(nd4));
+    EXPECT_TRUE(lst.isEmpty());
+}
+
+
+TEST(StaticList, insertAndCut)
+{
+    IntStaticList lst;
+    IntStaticListNode* nd1 = lst.appendEl(1);
+    IntStaticListNode* nd3 = lst.appendEl(3);
+    IntStaticListNode* nd2 = lst.insertNodeAfter(nd1, lst.acquireNode(2));
+    IntStaticListNode* nd0 = lst.insertNodeBefore(nullptr, lst.acquireNode(0));
+
+    EXPECT_EQ(nd0, lst.getHeadNode());
+    EXPECT_EQ(nd3, lst.getLastNode());
+    EXPECT_EQ(nd2, nd1->getNext());
+    EXPECT_EQ(4, lst.getSize());
+
+    // invalid arguments are reported, not thrown
+    EXPECT_EQ(nullptr, lst.insertNodeAfter(nd0, nd1));
+    EXPECT_EQ(nullptr, lst.insertNodeAfter(nd0, nullptr));
+    EXPECT_FALSE(lst.cutNodes(nullptr, nd1));
+
+    // splice [1, 2] to the end
+    EXPECT_TRUE(lst.cutNodes(nd1, nd2));
+    EXPECT_EQ(2, lst.getSize());
+    EXPECT_TRUE(lst.insertNodesAfter(nullptr, nd1, nd2));
+    EXPECT_EQ(nd2, lst.getLastNode());
+
+    std::stringstream ss;
+    for (int v : lst)
+        ss << v;
+    EXPECT_EQ("0312", ss.str());
+}
+
+
+TEST(StaticList, findAllAndIterators)
+{
+    BidiStaticList<int, 16> lst;
+    for (int i = 0; i < 10; ++i)
+        lst.appendEl(i % 3);
+
+    BidiStaticList<int, 16>::Node* out[8];
+    EXPECT_EQ(3, lst.findAll(lst.getHeadNode(), 2, out, 8));
+    EXPECT_EQ(2, lst.findAll(lst.getHeadNode(), 0, out, 2));
+    EXPECT_EQ(4, lst.cutAll(lst.getHeadNode(), 0, out, 8));
+    EXPECT_EQ(6, lst.getSize());
+
+    std::stringstream ss;
+    for (BidiStaticList<int, 16>::reverse_iterator it = lst.rbegin(); it != lst.rend(); ++it)
+        ss << *it;
+    EXPECT_EQ("212121", ss.str());
+
+    EXPECT_EQ(1, *lst.begin());
+    EXPECT_EQ(2, *(--lst.end()));
+    EXPECT_EQ(1, *lst.cbegin());
+
+    lst.clear();
+    EXPECT_EQ(0, lst.getUsedCount());
+    EXPECT_TRUE(lst.begin() == lst.end());
+}
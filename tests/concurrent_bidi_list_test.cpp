@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for ConcurrentBidiList class.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "concurrent_bidi_list.h"
+
+/** \brief Type alias for a list of integers */
+typedef ConcurrentBidiList<int> IntConcList;
+
+
+/** \brief Returns values of \a lst walking forwards, and checks backward links agree */
+static std::vector<int> listValues(IntConcList &lst)
+{
+    std::vector<int> res;
+    lst.forEach([&res](int &v) { res.push_back(v); });
+
+    std::vector<int> back;
+    for (IntConcList::Node *nd = lst.getLastNode(); nd != nullptr; nd = lst.getPrevNode(nd))
+        back.insert(back.begin(), nd->getValue());
+    EXPECT_EQ(res, back);
+
+    return res;
+}
+
+
+TEST(ConcurrentList, simpleCreate)
+{
+    IntConcList lst;
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+    EXPECT_EQ(nullptr, lst.getLastNode());
+    EXPECT_TRUE(lst.isEmpty());
+    EXPECT_EQ(nullptr, lst.findFirst(1));
+}
+
+
+TEST(ConcurrentList, insertAndCut)
+{
+    IntConcList lst;
+    IntConcList::Node *nd2 = lst.appendEl(2);
+    IntConcList::Node *nd4 = lst.appendEl(4);
+    IntConcList::Node *nd1 = lst.insertNodeBefore(nullptr, new IntConcList::Node(1));
+    IntConcList::Node *nd3 = lst.insertNodeAfter(nd2, new IntConcList::Node(3));
+    EXPECT_EQ(std::vector<int>({ 1, 2, 3, 4 }), listValues(lst));
+    EXPECT_EQ(4, lst.getSize());
+    EXPECT_EQ(nd1, lst.getHeadNode());
+    EXPECT_EQ(nd4, lst.getLastNode());
+
+    EXPECT_EQ(nd3, lst.cutNode(nd3));
+    EXPECT_EQ(std::vector<int>({ 1, 2, 4 }), listValues(lst));
+
+    // a cut node is reported, not an error
+    EXPECT_EQ(nullptr, lst.cutNode(nd3));
+    IntConcList::Node *nd5 = new IntConcList::Node(5);
+    EXPECT_EQ(nullptr, lst.insertNodeAfter(nd3, nd5));
+    EXPECT_EQ(nullptr, lst.insertNodeBefore(nd3, nd5));
+    EXPECT_EQ(nullptr, lst.findFirst(nd3, 4));
+
+    // while its arguments are checked
+    EXPECT_THROW(lst.insertNodeAfter(nd1, nullptr), std::invalid_argument);
+    EXPECT_THROW(lst.insertNodeAfter(nd1, nd2), std::invalid_argument);
+    EXPECT_THROW(lst.cutNode(nullptr), std::invalid_argument);
+
+    lst.insertNodeBefore(nd4, nd3);
+    EXPECT_EQ(std::vector<int>({ 1, 2, 3, 4 }), listValues(lst));
+    delete nd5;
+}
+
+
+TEST(ConcurrentList, search)
+{
+    IntConcList lst;
+    const int vals[] = { 1, 2, 3, 2, 5, 2 };
+    for (int v : vals)
+        lst.appendEl(v);
+
+    IntConcList::Node *nd = lst.findFirst(2);
+    ASSERT_NE(nullptr, nd);
+    EXPECT_EQ(3, lst.findFirst(nd, 3)->getValue());
+    EXPECT_TRUE(lst.contains(5));
+    EXPECT_FALSE(lst.contains(7));
+
+    int size;
+    IntConcList::Node **found = lst.findAll(2, size);
+    ASSERT_EQ(3, size);
+    EXPECT_EQ(nd, found[0]);
+    delete[] found;
+
+    IntConcList::Node *cut = lst.cutFirst(2);
+    EXPECT_EQ(nd, cut);
+    delete cut;
+
+    IntConcList::Node **cutNodes = lst.cutAll(2, size);
+    ASSERT_EQ(2, size);
+    for (int i = 0; i < size; ++i)
+        delete cutNodes[i];
+    delete[] cutNodes;
+    EXPECT_EQ(std::vector<int>({ 1, 3, 5 }), listValues(lst));
+
+    lst.clear();
+    EXPECT_TRUE(lst.isEmpty());
+    EXPECT_EQ(nullptr, lst.getHeadNode());
+}
+
+
+TEST(ConcurrentList, parallelInsertsAndCuts)
+{
+    IntConcList lst;
+    const int THREADS = 8;
+    const int OPS = 2000;
+
+    // every thread works around its own anchor, while also scanning the whole list
+    std::vector<IntConcList::Node *> anchors;
+    for (int t = 0; t < THREADS; ++t)
+        anchors.push_back(lst.appendEl(-1 - t));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.push_back(std::thread([&lst, &anchors, t]()
+        {
+            std::vector<IntConcList::Node *> own;
+            for (int i = 0; i < OPS; ++i)
+            {
+                int val = t * OPS + i;
+                if (i % 3 == 2)
+                {
+                    delete lst.cutNode(own.back());
+                    own.pop_back();
+                } else if (i % 3 == 1)
+                    own.push_back(lst.insertNodeBefore(anchors[t], new IntConcList::Node(val)));
+                else
+                    own.push_back(lst.insertNodeAfter(anchors[t], new IntConcList::Node(val)));
+
+                lst.findFirst(-1 - (t + 1) % THREADS);
+            }
+            // values of a thread are all in the list
+            for (std::size_t i = 0; i < own.size(); ++i)
+                EXPECT_EQ(own[i], lst.findFirst(own[i]->getValue()));
+        }));
+    }
+    for (std::size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    // every third operation cuts a node inserted by one of the other two
+    std::size_t expected = THREADS + THREADS * (OPS - 2 * (OPS / 3));
+    EXPECT_EQ(expected, lst.getSize());
+    EXPECT_EQ(expected, listValues(lst).size());
+}
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for FlatCombiningBidiList class.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "flat_combining_bidi_list.h"
+
+/** \brief Type alias for a flat-combining list of integers */
+typedef FlatCombiningBidiList<int> IntFcList;
+
+
+/** \brief Collects values of a list in order */
+static std::vector<int> listValues(IntFcList &lst)
+{
+    std::vector<int> vals;
+    lst.apply([&vals](IntFcList::List &l)
+    {
+        for (int val : l)
+            vals.push_back(val);
+    });
+    return vals;
+}
+
+
+TEST(FlatCombiningList, singleThread)
+{
+    IntFcList lst;
+    IntFcList::Node *one = lst.appendEl(1);
+    IntFcList::Node *three = lst.appendEl(3);
+    EXPECT_EQ(one->getValue(), 1);
+    EXPECT_EQ(one->getNext(), three);
+
+    lst.insertNodeBefore(three, new IntFcList::Node(2));
+    lst.insertNodeAfter(three, new IntFcList::Node(4));
+    EXPECT_EQ(listValues(lst), std::vector<int>({ 1, 2, 3, 4 }));
+    EXPECT_EQ(lst.getSize(), 4);
+    EXPECT_EQ(lst.findFirst(3), three);
+    EXPECT_EQ(lst.count(2), 1);
+
+    delete lst.cutNode(one);
+    IntFcList::Node *cut = lst.cutFirst(4);
+    ASSERT_NE(cut, nullptr);
+    EXPECT_EQ(cut->getValue(), 4);
+    delete cut;
+    EXPECT_EQ(lst.cutFirst(42), nullptr);
+    EXPECT_EQ(listValues(lst), std::vector<int>({ 2, 3 }));
+
+    // an error of the list reaches the caller
+    EXPECT_THROW(lst.insertNodeAfter(three, nullptr), std::invalid_argument);
+    EXPECT_EQ(lst.getSize(), 2);
+}
+
+
+TEST(FlatCombiningList, parallelAppendsAndCuts)
+{
+    IntFcList lst;
+    const int THREADS = 8;
+    const int OPS = 3000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.push_back(std::thread([&lst, t]()
+        {
+            // appends of a thread may be merged with others', but keep their order
+            IntFcList::Node *kept = nullptr;
+            for (int i = 0; i < OPS; ++i)
+            {
+                int val = t * OPS + i;
+                if (i % 3 == 2)
+                    delete lst.cutFirst(val - 1);
+                else
+                {
+                    IntFcList::Node *node = lst.appendEl(val);
+                    EXPECT_EQ(node->getValue(), val);
+                    if (i % 3 == 0)
+                        kept = node;
+                }
+            }
+            EXPECT_EQ(lst.findFirst(kept->getValue()), kept);
+        }));
+    }
+    for (std::size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    // every third operation cuts the value appended just before it
+    std::vector<int> vals = listValues(lst);
+    ASSERT_EQ(vals.size(), THREADS * (OPS / 3));
+    EXPECT_EQ(lst.getSize(), vals.size());
+
+    std::vector<int> last(THREADS, -1);
+    for (std::size_t i = 0; i < vals.size(); ++i)
+    {
+        int t = vals[i] / OPS;
+        EXPECT_EQ(vals[i] % 3, 0);
+        EXPECT_LT(last[t], vals[i]);
+        last[t] = vals[i];
+    }
+}
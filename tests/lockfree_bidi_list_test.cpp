@@ -0,0 +1,328 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for LockFreeBidiList and EpochReclaimer classes.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "lockfree_bidi_list.h"
+
+/** \brief Type alias for a list of integers */
+typedef LockFreeBidiList<int> IntLfList;
+
+
+/** \brief Object that counts its destructions */
+struct Tracked
+{
+    static std::atomic<int> destroyed;
+    ~Tracked() { ++destroyed; }
+};
+
+std::atomic<int> Tracked::destroyed(0);
+
+
+/** \brief Returns values of \a lst forwards, and checks backward order agrees */
+static std::vector<int> listValues(IntLfList &lst)
+{
+    IntLfList::ReadGuard guard(lst);
+    std::vector<int> res;
+    for (IntLfList::Node *nd = lst.getHeadNode(); nd; nd = lst.getNextNode(nd))
+        res.push_back(nd->getValue());
+
+    std::vector<int> back;
+    for (IntLfList::Node *nd = lst.getLastNode(); nd; nd = lst.getPrevNode(nd))
+        back.insert(back.begin(), nd->getValue());
+    EXPECT_EQ(res, back);
+
+    return res;
+}
+
+
+///////////////////////////// RECLAIMER TESTS /////////////////////////////
+
+TEST(EpochReclaimer, gracePeriods)
+{
+    Tracked::destroyed = 0;
+    EpochReclaimer rec;
+
+    rec.retire(new Tracked());
+    rec.reclaim();
+    EXPECT_EQ(1, Tracked::destroyed);
+
+    // a guard keeps objects retired while it is active
+    {
+        EpochReclaimer::Guard guard(rec);
+        rec.retire(new Tracked());
+        rec.reclaim();
+        EXPECT_EQ(1, Tracked::destroyed);
+        EXPECT_EQ(1, rec.getPendingCount());
+    }
+    rec.reclaim();
+    EXPECT_EQ(2, Tracked::destroyed);
+
+    // an object of two grace periods needs two reclaims
+    rec.retire(new Tracked(), 2);
+    rec.reclaim();
+    EXPECT_EQ(2, Tracked::destroyed);
+    rec.reclaim();
+    EXPECT_EQ(3, Tracked::destroyed);
+
+    // the rest is freed with the reclaimer
+    {
+        EpochReclaimer rec2;
+        rec2.retire(new Tracked(), 5);
+    }
+    EXPECT_EQ(4, Tracked::destroyed);
+}
+
+
+TEST(EpochReclaimer, synchronize)
+{
+    Tracked::destroyed = 0;
+    EpochReclaimer rec;
+    std::atomic<bool> entered(false);
+    std::atomic<bool> release(false);
+
+    std::thread reader([&]()
+    {
+        EpochReclaimer::Guard guard(rec);
+        entered = true;
+        while (!release)
+            std::this_thread::yield();
+    });
+    while (!entered)
+        std::this_thread::yield();
+
+    rec.retire(new Tracked());
+    rec.reclaim();
+    EXPECT_EQ(0, Tracked::destroyed);
+
+    // synchronize() waits for the reader
+    release = true;
+    rec.synchronize();
+    EXPECT_EQ(1, Tracked::destroyed);
+    reader.join();
+}
+
+
+TEST(EpochReclaimer, concurrentRetire)
+{
+    Tracked::destroyed = 0;
+    EpochReclaimer rec;
+
+    // retirements and the reclaims they trigger race on no lock
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.push_back(std::thread([&rec]()
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                EpochReclaimer::Guard guard(rec);
+                rec.retire(new Tracked(), 1 + i % 2);
+            }
+        }));
+    for (std::size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    rec.synchronize();
+    rec.synchronize();
+    EXPECT_EQ(4000, Tracked::destroyed);
+    EXPECT_EQ(0, rec.getPendingCount());
+}
+
+
+///////////////////////////// LIST TESTS /////////////////////////////
+
+TEST(LockFreeList, insertAndCut)
+{
+    IntLfList lst;
+    EXPECT_TRUE(lst.isEmpty());
+    EXPECT_EQ(nullptr, lst.getLastNode());
+
+    IntLfList::ReadGuard guard(lst);
+    IntLfList::Node *nd2 = lst.pushBack(2);
+    IntLfList::Node *nd4 = lst.pushBack(4);
+    lst.pushFront(1);
+    IntLfList::Node *nd3 = lst.insertNodeAfter(nd2, new IntLfList::Node(3));
+    lst.insertNodeBefore(nd4, new IntLfList::Node(35));
+    lst.insertNodeAfter(nullptr, new IntLfList::Node(5));
+    lst.insertNodeBefore(nullptr, new IntLfList::Node(0));
+    EXPECT_EQ(std::vector<int>({ 0, 1, 2, 3, 35, 4, 5 }), listValues(lst));
+    EXPECT_EQ(7, lst.getSize());
+
+    EXPECT_TRUE(lst.cutNode(nd3));
+    EXPECT_TRUE(nd3->isDeleted());
+    EXPECT_FALSE(lst.cutNode(nd3));
+    EXPECT_EQ(std::vector<int>({ 0, 1, 2, 35, 4, 5 }), listValues(lst));
+
+    // a deleted node is still valid under the guard and leads on to the list
+    EXPECT_EQ(3, nd3->getValue());
+    EXPECT_EQ(35, lst.getNextNode(nd3)->getValue());
+    EXPECT_EQ(nullptr, lst.getPrevNode(nd3));
+    IntLfList::Node *nd6 = new IntLfList::Node(6);
+    EXPECT_EQ(nullptr, lst.insertNodeAfter(nd3, nd6));
+    EXPECT_EQ(nullptr, lst.insertNodeBefore(nd3, nd6));
+    delete nd6;
+
+    EXPECT_THROW(lst.insertNodeAfter(nd2, nullptr), std::invalid_argument);
+    EXPECT_THROW(lst.cutNode(nullptr), std::invalid_argument);
+
+    int val;
+    EXPECT_TRUE(lst.popFront(val));
+    EXPECT_EQ(0, val);
+    EXPECT_TRUE(lst.popBack(val));
+    EXPECT_EQ(5, val);
+    EXPECT_EQ(std::vector<int>({ 1, 2, 35, 4 }), listValues(lst));
+}
+
+
+TEST(LockFreeList, search)
+{
+    IntLfList lst;
+    const int vals[] = { 1, 2, 3, 2, 5, 2 };
+    for (int v : vals)
+        lst.pushBack(v);
+
+    EXPECT_TRUE(lst.contains(5));
+    EXPECT_FALSE(lst.contains(7));
+    EXPECT_EQ(3, lst.count(2));
+    {
+        IntLfList::ReadGuard guard(lst);
+        EXPECT_EQ(lst.getHeadNode()->getValue(), 1);
+        EXPECT_EQ(lst.getHeadNode()->getValue() + 1, lst.findFirst(2)->getValue());
+    }
+
+    EXPECT_TRUE(lst.cutFirst(2));
+    EXPECT_EQ(std::vector<int>({ 1, 3, 2, 5, 2 }), listValues(lst));
+    EXPECT_EQ(2, lst.cutAll(2));
+    EXPECT_FALSE(lst.cutFirst(2));
+    EXPECT_EQ(std::vector<int>({ 1, 3, 5 }), listValues(lst));
+
+    lst.clear();
+    EXPECT_TRUE(lst.isEmpty());
+    EXPECT_EQ(0, lst.getSize());
+    int val;
+    EXPECT_FALSE(lst.popBack(val));
+}
+
+
+TEST(LockFreeList, parallelQueue)
+{
+    IntLfList lst;
+    const int PRODUCERS = 4;
+    const int CONSUMERS = 4;
+    const int ITEMS = 5000;
+    std::atomic<long long> consumedSum(0);
+    std::atomic<int> consumed(0);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < PRODUCERS; ++p)
+        threads.push_back(std::thread([&lst, p]()
+        {
+            for (int i = 1; i <= ITEMS; ++i)
+                if (i % 2)
+                    lst.pushBack(i);
+                else
+                    lst.pushFront(i);
+        }));
+
+    for (int c = 0; c < CONSUMERS; ++c)
+        threads.push_back(std::thread([&lst, &consumedSum, &consumed, c]()
+        {
+            int val;
+            while (consumed.load() < PRODUCERS * ITEMS)
+            {
+                if (c % 2 ? lst.popBack(val) : lst.popFront(val))
+                {
+                    consumedSum += val;
+                    ++consumed;
+                } else
+                    std::this_thread::yield();
+            }
+        }));
+
+    for (std::size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+
+    EXPECT_EQ(PRODUCERS * ITEMS, consumed.load());
+    EXPECT_EQ((long long) PRODUCERS * ITEMS * (ITEMS + 1) / 2, consumedSum.load());
+    EXPECT_TRUE(lst.isEmpty());
+}
+
+
+TEST(LockFreeList, parallelUpdatesAndReaders)
+{
+    IntLfList lst;
+    const int WRITERS = 4;
+    const int OPS = 3000;
+    std::atomic<bool> done(false);
+
+    std::vector<IntLfList::Node *> anchors;
+    for (int t = 0; t < WRITERS; ++t)
+        anchors.push_back(lst.pushBack(-1 - t));
+
+    // readers walk both ways while writers insert and delete around their anchors
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r)
+        readers.push_back(std::thread([&lst, &done, r]()
+        {
+            while (!done)
+            {
+                IntLfList::ReadGuard guard(lst);
+                std::size_t anchorsSeen = 0;
+                if (r == 0)
+                {
+                    for (IntLfList::Node *nd = lst.getHeadNode(); nd; nd = lst.getNextNode(nd))
+                        anchorsSeen += nd->getValue() < 0;
+                } else
+                {
+                    for (IntLfList::Node *nd = lst.getLastNode(); nd; nd = lst.getPrevNode(nd))
+                        anchorsSeen += nd->getValue() < 0;
+                }
+                EXPECT_EQ((std::size_t) WRITERS, anchorsSeen);
+            }
+        }));
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < WRITERS; ++t)
+        writers.push_back(std::thread([&lst, &anchors, t]()
+        {
+            std::vector<IntLfList::Node *> own;
+            for (int i = 0; i < OPS; ++i)
+            {
+                IntLfList::ReadGuard guard(lst);
+                if (i % 3 == 2)
+                {
+                    EXPECT_TRUE(lst.cutNode(own.back()));
+                    own.pop_back();
+                } else if (i % 3 == 1)
+                    own.push_back(lst.insertNodeBefore(anchors[t], new IntLfList::Node(i)));
+                else
+                    own.push_back(lst.insertNodeAfter(anchors[t], new IntLfList::Node(i)));
+            }
+        }));
+
+    for (std::size_t t = 0; t < writers.size(); ++t)
+        writers[t].join();
+    done = true;
+    for (std::size_t r = 0; r < readers.size(); ++r)
+        readers[r].join();
+
+    std::size_t expected = WRITERS + WRITERS * (OPS - 2 * (OPS / 3));
+    EXPECT_EQ(expected, lst.getSize());
+    EXPECT_EQ(expected, listValues(lst).size());
+}
@@ -0,0 +1,271 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for ParallelBidiList and BidiThreadPool classes.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel_bidi_list.h"
+
+/** \brief Type alias for a parallel list of integers */
+typedef ParallelBidiList<int> IntParList;
+
+
+/** \brief Checks parallel operations agree with sequential ones for \a val */
+static void expectSameAsSequential(IntParList &lst, int val)
+{
+    EXPECT_EQ(lst.parallelCount(val), lst.count(val));
+
+    int seqSize, parSize;
+    IntParList::Node **seq = lst.findAll(val, seqSize);
+    IntParList::Node **par = lst.parallelFindAll(val, parSize);
+    ASSERT_EQ(parSize, seqSize);
+    for (int i = 0; i < seqSize; ++i)
+        EXPECT_EQ(par[i], seq[i]);
+
+    delete[] seq;
+    delete[] par;
+}
+
+
+TEST(ThreadPool, runAndErrors)
+{
+    BidiThreadPool pool(4);
+    EXPECT_EQ(pool.getThreadCount(), 4);
+
+    std::vector<std::atomic<int> > hits(1000);
+    for (int round = 0; round < 3; ++round)
+        pool.run(hits.size(), [&hits](std::size_t task) { ++hits[task]; });
+    for (std::size_t i = 0; i < hits.size(); ++i)
+        EXPECT_EQ(hits[i].load(), 3);
+
+    pool.run(0, [](std::size_t) { FAIL(); });
+
+    // every task runs even if some throw
+    std::atomic<int> ran(0);
+    EXPECT_THROW(pool.run(100, [&ran](std::size_t task)
+    {
+        ++ran;
+        if (task % 10 == 0)
+            throw std::runtime_error("task");
+    }), std::runtime_error);
+    EXPECT_EQ(ran.load(), 100);
+}
+
+
+TEST(ThreadPool, unevenTasks)
+{
+    // tasks at the front are much longer, so threads owning the back ranges steal
+    BidiThreadPool pool(4);
+    std::vector<std::atomic<int> > hits(5000);
+    std::atomic<long> sink(0);
+    pool.run(hits.size(), [&hits, &sink](std::size_t task)
+    {
+        long acc = 0;
+        for (std::size_t i = 0; i < (task < 100 ? 20000u : 10u); ++i)
+            acc += (long) (i ^ task);
+        sink += acc;
+        ++hits[task];
+    });
+    for (std::size_t i = 0; i < hits.size(); ++i)
+        EXPECT_EQ(hits[i].load(), 1);
+
+    BidiThreadPool single(1);
+    EXPECT_EQ(single.getThreadCount(), 1);
+    std::vector<int> order;
+    single.run(10, [&order](std::size_t task) { order.push_back((int) task); });
+    ASSERT_EQ(order.size(), 10);
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(order[i], i);
+}
+
+
+TEST(ParallelList, checkpointsFollowChanges)
+{
+    BidiThreadPool pool(3);
+    EXPECT_THROW(IntParList(0, pool), std::invalid_argument);
+
+    IntParList lst(4, pool);
+    EXPECT_EQ(lst.getSegmentCount(), 0);
+    EXPECT_EQ(lst.parallelCount(1), 0);
+
+    for (int i = 0; i < 10; ++i)
+        lst.appendEl(i % 3);
+    EXPECT_EQ(lst.getSegmentCount(), 3);
+    expectSameAsSequential(lst, 1);
+
+    // changes at the ends keep the segments
+    lst.pushFront(1);
+    lst.popBack();
+    lst.popFront();
+    lst.popFront();
+    EXPECT_EQ(lst.getSegmentCount(), 3);
+    expectSameAsSequential(lst, 1);
+    expectSameAsSequential(lst, 2);
+
+    // a cut in the middle makes them rebuilt
+    delete lst.cutNode(lst.getNextNode(lst.getNextNode(lst.getHeadNode())));
+    lst.insertNodeAfter(lst.getHeadNode(), new IntParList::Node(2));
+    expectSameAsSequential(lst, 2);
+    EXPECT_EQ(lst.getSegmentCount(), 2);
+
+    lst.clear();
+    EXPECT_EQ(lst.getSegmentCount(), 0);
+    lst.appendEl(5);
+    expectSameAsSequential(lst, 5);
+}
+
+
+TEST(ParallelList, cutAll)
+{
+    BidiThreadPool pool(4);
+    IntParList lst(16, pool);
+    int vals[1000];
+    for (int i = 0; i < 1000; ++i)
+        vals[i] = i % 16 == 0 ? 100 : i % 7;
+    lst.appendRange(vals, vals + 1000);
+    EXPECT_EQ(lst.getSegmentCount(), 63);
+
+    // values off checkpoints leave them as they are
+    std::size_t fives = lst.count(5);
+    int size;
+    IntParList::Node **cut = lst.parallelCutAll(5, size);
+    ASSERT_EQ(size, (int) fives);
+    for (int i = 0; i < size; ++i)
+    {
+        EXPECT_EQ(cut[i]->getValue(), 5);
+        delete cut[i];
+    }
+    delete[] cut;
+    EXPECT_EQ(lst.getSize(), 1000 - fives);
+    EXPECT_EQ(lst.getSegmentCount(), 63);
+    expectSameAsSequential(lst, 3);
+
+    // the head is a checkpoint
+    cut = lst.parallelCutAll(100, size);
+    ASSERT_EQ(size, 63);
+    for (int i = 0; i < size; ++i)
+        delete cut[i];
+    delete[] cut;
+    EXPECT_EQ(lst.getSize(), 1000 - fives - 63);
+    EXPECT_EQ(lst.parallelCount(100), 0);
+    expectSameAsSequential(lst, 6);
+
+    EXPECT_EQ(lst.parallelCutAll(42, size), nullptr);
+    EXPECT_EQ(size, 0);
+}
+
+
+TEST(ParallelList, randomChanges)
+{
+    BidiThreadPool pool(4);
+    IntParList lst(8, pool);
+    std::mt19937 rnd(42);
+    for (int i = 0; i < 200; ++i)
+        lst.appendEl(rnd() % 5);
+
+    for (int step = 0; step < 2000; ++step)
+    {
+        switch (rnd() % 6)
+        {
+        case 0:
+            lst.appendEl(rnd() % 5);
+            break;
+        case 1:
+            lst.pushFront(rnd() % 5);
+            break;
+        case 2:
+            lst.insertNodeBefore(lst.getLastNode(), new IntParList::Node(rnd() % 5));
+            break;
+        case 3:
+            lst.popFront();
+            break;
+        case 4:
+            lst.popBack();
+            break;
+        case 5:
+            delete lst.cutFirst(rnd() % 5);
+            break;
+        }
+        if (step % 50 == 0)
+            expectSameAsSequential(lst, step % 5);
+    }
+}
+
+
+TEST(ParallelList, forEachTransformReduce)
+{
+    BidiThreadPool pool(4);
+    IntParList lst(16, pool);
+    int empty = lst.parallelReduce(7, [](int acc, int v) { return acc + v; },
+                                   [](int a, int b) { return a + b; });
+    EXPECT_EQ(empty, 7);
+
+    long expected = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        lst.appendEl(i);
+        expected += i;
+    }
+
+    std::atomic<long> sum(0);
+    lst.parallelForEach([&sum](const int &v) { sum += v; });
+    EXPECT_EQ(sum.load(), expected);
+
+    lst.parallelTransform([](const int &v) { return v * 2 + 1; });
+    int i = 0;
+    for (IntParList::iterator it = lst.begin(); it != lst.end(); ++it, ++i)
+        EXPECT_EQ(*it, i * 2 + 1);
+    EXPECT_EQ(lst.count(1), 1);             // tags follow new values
+    EXPECT_EQ(lst.parallelCount(0), 0);
+
+    long total = lst.parallelReduce(0L, [](long acc, int v) { return acc + v; },
+                                    [](long a, long b) { return a + b; });
+    EXPECT_EQ(total, expected * 2 + 1000);
+
+    // folding in list order keeps the first value first
+    int first = lst.parallelReduce(-1, [](int acc, int v) { return acc < 0 ? v : acc; },
+                                   [](int a, int b) { return a < 0 ? b : a; });
+    EXPECT_EQ(first, 1);
+}
+
+
+TEST(ParallelList, reduceIsDeterministic)
+{
+    typedef ParallelBidiList<double> DblParList;
+    BidiThreadPool one(1), two(2), four(4), eight(8);
+    DblParList lst(100, one);
+    std::mt19937 rnd(7);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    for (int i = 0; i < 5000; ++i)
+        lst.appendEl(dist(rnd) * (i % 3 == 0 ? 1e-9 : 1.0));
+
+    std::vector<double> sums;
+    BidiThreadPool *pools[] = { &one, &two, &four, &eight };
+    for (int round = 0; round < 3; ++round)
+        for (std::size_t p = 0; p < 4; ++p)
+        {
+            lst.setPool(*pools[p]);
+            sums.push_back(lst.parallelReduce(0.0, [](double acc, double v) { return acc + v; },
+                                              [](double a, double b) { return a + b; }));
+        }
+
+    // the very same bits, not just close values
+    for (std::size_t i = 1; i < sums.size(); ++i)
+        EXPECT_EQ(std::memcmp(&sums[i], &sums[0], sizeof(double)), 0);
+}
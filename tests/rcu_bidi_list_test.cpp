@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for RcuBidiList class.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "rcu_bidi_list.h"
+
+/** \brief Type alias for a list of integers */
+typedef RcuBidiList<int> IntRcuList;
+
+
+/** \brief Returns values of \a lst forwards, and checks backward order agrees */
+static std::vector<int> listValues(IntRcuList &lst)
+{
+    IntRcuList::ReadGuard guard(lst);
+    std::vector<int> res;
+    for (IntRcuList::iterator it = lst.begin(); it != lst.end(); ++it)
+        res.push_back(*it);
+
+    std::vector<int> back;
+    for (IntRcuList::reverse_iterator it = lst.rbegin(); it != lst.rend(); ++it)
+        back.insert(back.begin(), *it);
+    EXPECT_EQ(res, back);
+
+    return res;
+}
+
+
+TEST(RcuList, writerMethods)
+{
+    IntRcuList lst;
+    lst.pushBack(2);
+    lst.pushBack(4);
+    lst.pushFront(1);
+    lst.insertNodeAfter(lst.findFirst(2), new IntRcuList::Node(3));
+    lst.appendEl(5);
+    lst.pushBack(2);
+    EXPECT_EQ(listValues(lst), std::vector<int>({ 1, 2, 3, 4, 5, 2 }));
+    EXPECT_EQ(lst.getSize(), 6);
+
+    EXPECT_EQ(lst.count(2), 2);
+    EXPECT_TRUE(lst.contains(5));
+    EXPECT_EQ(lst.cutAll(2), 2);
+    EXPECT_FALSE(lst.contains(2));
+    EXPECT_TRUE(lst.cutFirst(4));
+    EXPECT_FALSE(lst.cutFirst(4));
+
+    int val = 0;
+    EXPECT_TRUE(lst.popFront(val));
+    EXPECT_EQ(val, 1);
+    EXPECT_TRUE(lst.popBack(val));
+    EXPECT_EQ(val, 5);
+    EXPECT_EQ(listValues(lst), std::vector<int>({ 3 }));
+
+    lst.clear();
+    EXPECT_FALSE(lst.popBack(val));
+    EXPECT_TRUE(listValues(lst).empty());
+
+    // retired nodes wait for a batch, but no reader holds them
+    EXPECT_GT(lst.getReclaimer().getPendingCount(), 0);
+    lst.getReclaimer().reclaim();
+    EXPECT_EQ(lst.getReclaimer().getPendingCount(), 0);
+    EXPECT_THROW(lst.cutNode(nullptr), std::invalid_argument);
+}
+
+
+TEST(RcuList, readerKeepsCutNodes)
+{
+    IntRcuList lst;
+    int vals[] = { 1, 2, 3, 4, 5 };
+    lst.appendRange(vals, vals + 5);
+
+    {
+        IntRcuList::ReadGuard guard(lst);
+        IntRcuList::Node *two = lst.findFirst(2);
+        IntRcuList::Node *three = lst.getNextNode(two);
+
+        lst.cutNodes(two, three);
+        EXPECT_EQ(lst.getReclaimer().getPendingCount(), 2);
+        lst.getReclaimer().reclaim();
+        EXPECT_EQ(lst.getReclaimer().getPendingCount(), 2);
+
+        // a reader standing on a cut node goes on to the rest of the list
+        EXPECT_EQ(two->getValue(), 2);
+        EXPECT_EQ(lst.getNextNode(three)->getValue(), 4);
+        EXPECT_EQ(lst.getPrevNode(two)->getValue(), 1);
+    }
+
+    lst.synchronize();
+    EXPECT_EQ(lst.getReclaimer().getPendingCount(), 0);
+    EXPECT_EQ(listValues(lst), std::vector<int>({ 1, 4, 5 }));
+}
+
+
+TEST(RcuList, readersWithWriter)
+{
+    const int READERS = 4;
+    const int WINDOW = 64;
+    const int OPS = 20000;
+
+    IntRcuList lst;
+    for (int i = 0; i < WINDOW; ++i)
+        lst.pushBack(2 * i);
+
+    std::atomic<bool> done(false);
+    std::atomic<int> errors(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < READERS; ++t)
+        readers.push_back(std::thread([&lst, &done, &errors]()
+        {
+            while (!done.load())
+            {
+                // the writer appends growing values and pops the front, so a reader
+                // must see them growing
+                IntRcuList::ReadGuard guard(lst);
+                int prev = -1;
+                for (IntRcuList::iterator it = lst.begin(); it != lst.end(); ++it)
+                {
+                    if (*it <= prev)
+                        ++errors;
+                    prev = *it;
+                }
+
+                prev = -1;
+                for (IntRcuList::reverse_iterator it = lst.rbegin(); it != lst.rend(); ++it)
+                {
+                    if (prev != -1 && *it >= prev)
+                        ++errors;
+                    prev = *it;
+                }
+            }
+        }));
+
+    // a node in the middle is replaced by a greater odd value now and then, too,
+    // so a reader may see both of them but still in order
+    for (int i = WINDOW; i < WINDOW + OPS; ++i)
+    {
+        int val;
+        lst.popFront(val);
+        lst.pushBack(2 * i);
+        if (i % 16 == 0)
+        {
+            IntRcuList::Node *mid = lst.findFirst(2 * (i - WINDOW / 2));
+            lst.insertNodeAfter(mid, new IntRcuList::Node(mid->getValue() + 1));
+            lst.cutNode(mid);
+        }
+    }
+    done = true;
+    for (std::size_t t = 0; t < readers.size(); ++t)
+        readers[t].join();
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(lst.getSize(), WINDOW);
+
+    lst.synchronize();
+    EXPECT_EQ(lst.getReclaimer().getPendingCount(), 0);
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for SimdSearch kernels.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "simd_search.h"
+
+
+/** \brief Checks all the kernels of SimdSearch<T> against scalar loops on every
+ *  level the processor supports
+ */
+template<typename T>
+void checkAllLevels()
+{
+    // odd size leaves a scalar tail for every vector width
+    std::vector<T> data;
+    for (int i = 0; i < 1003; ++i)
+        data.push_back((T) (i % 17));
+
+    std::vector<std::size_t> out(data.size());
+    SimdLevel best = simdDetectLevel();
+    for (int lvl = SIMD_SCALAR; lvl <= best; ++lvl)
+    {
+        simdSetLevel((SimdLevel) lvl);
+        for (int v = 0; v < 19; ++v)
+        {
+            T val = (T) v;
+            std::size_t first = SimdSearch<T>::findFirst(data.data(), data.size(), val);
+            std::size_t cnt = SimdSearch<T>::count(data.data(), data.size(), val);
+            std::size_t all = SimdSearch<T>::findAll(data.data(), data.size(), val, out.data());
+
+            EXPECT_EQ(v < 17 ? (std::size_t) v : data.size(), first);
+            EXPECT_EQ(v < 17 ? 1003 / 17 + (v < 1003 % 17) : 0, cnt);
+            EXPECT_EQ(cnt, all);
+            EXPECT_EQ(v < 17, SimdSearch<T>::contains(data.data(), data.size(), val));
+            for (std::size_t i = 0; i < all; ++i)
+                EXPECT_EQ((std::size_t) v + 17 * i, out[i]);
+        }
+
+        // a match only in the scalar tail
+        std::vector<T> tail(data.size(), (T) 99);
+        tail.back() = (T) 5;
+        EXPECT_EQ(tail.size() - 1, SimdSearch<T>::findFirst(tail.data(), tail.size(), (T) 5));
+        EXPECT_EQ(1, SimdSearch<T>::count(tail.data(), tail.size(), (T) 5));
+    }
+    simdSetLevel(best);
+}
+
+
+TEST(SimdSearch, int32) { checkAllLevels<int32_t>(); }
+TEST(SimdSearch, uint32) { checkAllLevels<uint32_t>(); }
+TEST(SimdSearch, int64) { checkAllLevels<int64_t>(); }
+TEST(SimdSearch, uint64) { checkAllLevels<uint64_t>(); }
+TEST(SimdSearch, float32) { checkAllLevels<float>(); }
+TEST(SimdSearch, float64) { checkAllLevels<double>(); }
+TEST(SimdSearch, scalarFallback) { checkAllLevels<int16_t>(); }
+
+
+TEST(SimdSearch, floatSemantics)
+{
+    std::vector<double> data(37, 1.0);
+    data[20] = -0.0;
+    data[30] = std::nan("");
+
+    EXPECT_EQ(20, SimdSearch<double>::findFirst(data.data(), data.size(), 0.0));
+    EXPECT_EQ(data.size(), SimdSearch<double>::findFirst(data.data(), data.size(), std::nan("")));
+    EXPECT_TRUE(SimdSearch<double>::VECTORIZED);
+    EXPECT_FALSE(SimdSearch<int16_t>::VECTORIZED);
+}
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for StagedBidiList class.
+///
+/// © Sergey Shershakov 2015–2017.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "staged_bidi_list.h"
+
+/** \brief Type alias for a staged list of integers */
+typedef StagedBidiList<int> IntStagedList;
+
+
+/** \brief Collects values of a list in order */
+static std::vector<int> listValues(IntStagedList &lst)
+{
+    std::vector<int> vals;
+    lst.apply([&vals](IntStagedList::List &l)
+    {
+        for (int val : l)
+            vals.push_back(val);
+    });
+    return vals;
+}
+
+
+TEST(StagedList, stageAndFlush)
+{
+    IntStagedList lst;
+    lst.appendEl(0);
+    {
+        IntStagedList::Stage stage(lst);
+        stage.appendEl(1);
+        int vals[] = { 2, 3 };
+        stage.appendRange(vals, vals + 2);
+        EXPECT_EQ(stage.getStagedCount(), 3);
+        EXPECT_EQ(lst.getSize(), 1);
+
+        EXPECT_EQ(stage.flush(), 3);
+        EXPECT_EQ(stage.flush(), 0);
+        EXPECT_EQ(stage.getStagedCount(), 0);
+
+        // the stage is reused after a flush; the destructor flushes the rest
+        stage.appendEl(4);
+        lst.appendEl(5);
+    }
+    EXPECT_EQ(listValues(lst), std::vector<int>({ 0, 1, 2, 3, 5, 4 }));
+    EXPECT_EQ(lst.getSize(), 6);
+    EXPECT_EQ(lst.count(4), 1);
+
+    delete lst.cutFirst(3);
+    EXPECT_EQ(lst.getSize(), 5);
+}
+
+
+TEST(StagedList, flushSize)
+{
+    IntStagedList lst;
+    IntStagedList::Stage stage(lst, 4);
+    for (int i = 0; i < 10; ++i)
+        stage.appendEl(i);
+
+    EXPECT_EQ(lst.getSize(), 8);
+    EXPECT_EQ(stage.getStagedCount(), 2);
+}
+
+
+TEST(StagedList, parallelProducers)
+{
+    IntStagedList lst;
+    const int THREADS = 8;
+    const int PER_THREAD = 10000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+        threads.push_back(std::thread([&lst, t]()
+        {
+            IntStagedList::Stage stage(lst, 1 + t * 37);
+            for (int i = 0; i < PER_THREAD; ++i)
+                stage.appendEl(t * PER_THREAD + i);
+        }));
+    for (std::size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    // values of every producer come in the order they have been staged
+    std::vector<int> vals = listValues(lst);
+    ASSERT_EQ(vals.size(), THREADS * PER_THREAD);
+    EXPECT_EQ(lst.getSize(), vals.size());
+
+    std::vector<int> next(THREADS, 0);
+    for (std::size_t i = 0; i < vals.size(); ++i)
+    {
+        int t = vals[i] / PER_THREAD;
+        EXPECT_EQ(vals[i] % PER_THREAD, next[t]++);
+    }
+}